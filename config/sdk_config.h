@@ -66,6 +66,45 @@
 
 // </e>
 
+//==========================================================
+// <e> NRFX_TWIM_ENABLED - nrfx_twim - TWIM peripheral driver (EasyDMA)
+//==========================================================
+// Used when DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM. TWIMn and TWIn
+// share the same peripheral, so disable NRFX_TWIn_ENABLED when enabling
+// NRFX_TWIMn_ENABLED.
+#ifndef NRFX_TWIM_ENABLED
+#define NRFX_TWIM_ENABLED 0
+#endif
+
+// <e> NRFX_TWIM0_ENABLED - Enable TWIM0 instance
+#ifndef NRFX_TWIM0_ENABLED
+#define NRFX_TWIM0_ENABLED 0
+#endif
+
+// <e> NRFX_TWIM1_ENABLED - Enable TWIM1 instance
+#ifndef NRFX_TWIM1_ENABLED
+#define NRFX_TWIM1_ENABLED 0
+#endif
+
+// </e>
+
+// <e> GPIOTE_ENABLED - nrf_drv_gpiote - GPIOTE peripheral driver (DA7281 nIRQ)
+#ifndef GPIOTE_ENABLED
+#define GPIOTE_ENABLED 1
+#endif
+
+// <o> GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS - Number of lower power input pins
+#ifndef GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS
+#define GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS 4
+#endif
+
+// <o> GPIOTE_CONFIG_IRQ_PRIORITY - Interrupt priority
+#ifndef GPIOTE_CONFIG_IRQ_PRIORITY
+#define GPIOTE_CONFIG_IRQ_PRIORITY 6
+#endif
+
+// </e>
+
 // </h>
 
 //==========================================================
@@ -0,0 +1,156 @@
+/**
+ * @file i2c_backend_benchmark.c
+ * @brief CPU cycles per transferred byte for the selected I2C backend
+ *
+ * Build once with DA7281_I2C_BACKEND = DA7281_I2C_BACKEND_TWI and once with
+ * DA7281_I2C_BACKEND_TWIM, run on the target and compare the two tables.
+ *
+ * Method (idle-loop stealing): the benchmark task spins on a counter while
+ * an asynchronous transfer runs. Cycles not accounted for by loop
+ * iterations were spent by the CPU in the driver: submission, the TWI
+ * interrupt(s) and the completion callback. Bus time itself is excluded.
+ *
+ * Run the task at the highest application priority so only the TWI
+ * interrupt can preempt it.
+ */
+
+#include "da7281.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "nrf.h"
+#include "nrf_log.h"
+
+/* ========================================================================
+ * Configuration
+ * ======================================================================== */
+
+/** Repetitions averaged per burst length */
+#define BENCH_RUNS              (32U)
+
+/** Iterations used to calibrate the idle loop */
+#define BENCH_CALIBRATION_LOOPS (100000U)
+
+static da7281_device_t s_bench_device = {
+    .twi_instance = 0,
+    .i2c_address = DA7281_I2C_ADDR_0x4A
+};
+
+/** Burst lengths to measure (1 register up to a full SNP block) */
+static const uint8_t s_bench_lengths[] = {1U, 4U, 7U, 32U, DA7281_I2C_MAX_BURST_LEN};
+
+/** Payload in RAM (EasyDMA cannot read flash) */
+static uint8_t s_bench_buf[DA7281_I2C_MAX_BURST_LEN];
+
+static volatile bool s_bench_done;
+
+/* ========================================================================
+ * Private Functions
+ * ======================================================================== */
+
+static void bench_cycle_counter_enable(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static void bench_done_cb(da7281_device_t *device, da7281_error_t result, void *context)
+{
+    (void)device;
+    (void)result;
+    (void)context;
+    s_bench_done = true;
+}
+
+/**
+ * @brief Cycles per idle-loop iteration, in 1/256 cycle units
+ */
+static uint32_t bench_calibrate(void)
+{
+    volatile uint32_t iterations = 0;
+
+    s_bench_done = false;
+    uint32_t start = DWT->CYCCNT;
+    while (!s_bench_done && (iterations < BENCH_CALIBRATION_LOOPS)) {
+        iterations++;
+    }
+    uint32_t elapsed = DWT->CYCCNT - start;
+
+    return (uint32_t)(((uint64_t)elapsed << 8) / iterations);
+}
+
+/**
+ * @brief CPU cycles spent by the driver for one burst, averaged over BENCH_RUNS
+ */
+static uint32_t bench_burst(uint8_t len, bool read, uint32_t loop_cost_q8)
+{
+    uint64_t stolen = 0;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+        volatile uint32_t iterations = 0;
+        da7281_error_t err;
+
+        s_bench_done = false;
+        uint32_t start = DWT->CYCCNT;
+        if (read) {
+            err = da7281_read_burst_async(&s_bench_device, DA7281_REG_SNP_MEM_BASE,
+                                          s_bench_buf, len, bench_done_cb, NULL);
+        } else {
+            err = da7281_write_burst_async(&s_bench_device, DA7281_REG_SNP_MEM_BASE,
+                                           s_bench_buf, len, bench_done_cb, NULL);
+        }
+        if (err != DA7281_OK) {
+            NRF_LOG_ERROR("Burst submit failed: %d", err);
+            return 0;
+        }
+        while (!s_bench_done) {
+            iterations++;
+        }
+        uint32_t elapsed = DWT->CYCCNT - start;
+        uint32_t idle = (uint32_t)(((uint64_t)iterations * loop_cost_q8) >> 8);
+
+        stolen += (elapsed > idle) ? (elapsed - idle) : 0U;
+    }
+
+    return (uint32_t)(stolen / BENCH_RUNS);
+}
+
+/* ========================================================================
+ * Benchmark Task
+ * ======================================================================== */
+
+/**
+ * @brief Print CPU cycles per job and per byte for each burst length
+ */
+void i2c_backend_benchmark_task(void *pvParameters)
+{
+    (void)pvParameters;
+
+    if (da7281_init(&s_bench_device) != DA7281_OK) {
+        NRF_LOG_ERROR("DA7281 init failed");
+        vTaskDelete(NULL);
+    }
+
+    bench_cycle_counter_enable();
+    uint32_t loop_cost_q8 = bench_calibrate();
+
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+    NRF_LOG_INFO("Backend: TWIM (EasyDMA)");
+#else
+    NRF_LOG_INFO("Backend: TWI (legacy)");
+#endif
+    NRF_LOG_INFO("dir  len  bytes  cycles  cycles/byte");
+
+    for (uint32_t i = 0; i < (sizeof(s_bench_lengths) / sizeof(s_bench_lengths[0])); i++) {
+        uint8_t len = s_bench_lengths[i];
+        uint32_t frame_bytes = (uint32_t)len + 1U;  /* Register address + data */
+
+        uint32_t wr = bench_burst(len, false, loop_cost_q8);
+        NRF_LOG_INFO("wr   %3u  %5u  %6u  %4u", len, frame_bytes, wr, wr / frame_bytes);
+
+        uint32_t rd = bench_burst(len, true, loop_cost_q8);
+        NRF_LOG_INFO("rd   %3u  %5u  %6u  %4u", len, frame_bytes, rd, rd / frame_bytes);
+    }
+
+    vTaskDelete(NULL);
+}
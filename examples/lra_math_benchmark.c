@@ -0,0 +1,122 @@
+/**
+ * @file lra_math_benchmark.c
+ * @brief CPU cycles of the LRA register math, fixed point vs float
+ *
+ * Times da7281_lra_compute() and each integer conversion with the DWT
+ * cycle counter, next to the single-precision code da7281_configure_lra()
+ * used before (kept here as the reference). No bus traffic.
+ *
+ * Run with interrupts quiet (highest application priority); each figure is
+ * the minimum over BENCH_RUNS so preemption does not inflate it.
+ */
+
+#include "da7281.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "nrf.h"
+#include "nrf_log.h"
+#include <math.h>
+
+/* ========================================================================
+ * Configuration
+ * ======================================================================== */
+
+/** Repetitions per measurement (minimum is reported) */
+#define BENCH_RUNS              (64U)
+
+static const da7281_lra_config_t s_bench_config = {
+    .resonant_freq_hz = 170,
+    .impedance_ohm = 6.75F,
+    .nom_max_v_rms = 2.5F,
+    .abs_max_v_peak = 3.5F,
+    .max_current_ma = 350
+};
+
+static volatile uint32_t s_bench_sink;
+
+/* ========================================================================
+ * Private Functions
+ * ======================================================================== */
+
+static void bench_cycle_counter_enable(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Former float implementation of the five conversions
+ */
+static void bench_float_reference(const da7281_lra_config_t *config, da7281_lra_regs_t *regs)
+{
+    float period_seconds = 1.0F / (float)config->resonant_freq_hz;
+    regs->lra_per = (uint16_t)roundf(period_seconds / DA7281_LRA_PER_TIME_SCALE);
+
+    float imax_float = ((float)config->max_current_ma - DA7281_ACTUATOR_IMAX_OFFSET) /
+                       DA7281_ACTUATOR_IMAX_SCALE;
+    regs->imax = (imax_float < 0) ? 0U : (uint8_t)roundf(imax_float);
+
+    float v2i_float = (config->impedance_ohm * (imax_float + DA7281_V2I_FACTOR_IMAX_OFFSET)) /
+                      DA7281_V2I_FACTOR_DIVISOR;
+    regs->v2i_factor = (uint16_t)roundf(v2i_float);
+
+    regs->nommax = (uint8_t)((config->nom_max_v_rms * 1000.0F) / DA7281_ACTUATOR_NOMMAX_SCALE);
+    regs->absmax = (uint8_t)((config->abs_max_v_peak * 1000.0F) / DA7281_ACTUATOR_ABSMAX_SCALE);
+}
+
+/** Cycles of the empty measurement, subtracted from every figure */
+static uint32_t s_bench_overhead;
+
+#define BENCH_MEASURE(result, expr) do {                \
+    uint32_t best_ = UINT32_MAX;                        \
+    for (uint32_t run_ = 0; run_ < BENCH_RUNS; run_++) {  \
+        uint32_t start_ = DWT->CYCCNT;                  \
+        expr;                                           \
+        uint32_t cycles_ = DWT->CYCCNT - start_;        \
+        if (cycles_ < best_) {                          \
+            best_ = cycles_;                            \
+        }                                               \
+    }                                                   \
+    (result) = (best_ > s_bench_overhead) ? (best_ - s_bench_overhead) : 0U; \
+} while (0)
+
+/* ========================================================================
+ * Benchmark Task
+ * ======================================================================== */
+
+/**
+ * @brief Print cycles per conversion and per full register set
+ */
+void lra_math_benchmark_task(void *pvParameters)
+{
+    (void)pvParameters;
+    da7281_lra_regs_t regs;
+    uint32_t cycles;
+
+    bench_cycle_counter_enable();
+    s_bench_overhead = 0U;
+    BENCH_MEASURE(s_bench_overhead, s_bench_sink = 0U);
+
+    NRF_LOG_INFO("conversion              cycles");
+
+    BENCH_MEASURE(cycles, s_bench_sink = da7281_lra_per_from_hz(s_bench_config.resonant_freq_hz));
+    NRF_LOG_INFO("da7281_lra_per_from_hz  %6u", cycles);
+
+    BENCH_MEASURE(cycles, s_bench_sink = da7281_imax_from_ma(s_bench_config.max_current_ma));
+    NRF_LOG_INFO("da7281_imax_from_ma     %6u", cycles);
+
+    BENCH_MEASURE(cycles, s_bench_sink = da7281_v2i_from_mohm(6750U, s_bench_config.max_current_ma));
+    NRF_LOG_INFO("da7281_v2i_from_mohm    %6u", cycles);
+
+    BENCH_MEASURE(cycles, s_bench_sink = da7281_vmax_from_mv(2500U));
+    NRF_LOG_INFO("da7281_vmax_from_mv     %6u", cycles);
+
+    BENCH_MEASURE(cycles, s_bench_sink = (uint32_t)da7281_lra_compute(&s_bench_config, &regs));
+    NRF_LOG_INFO("da7281_lra_compute      %6u  (fixed point)", cycles);
+
+    BENCH_MEASURE(cycles, bench_float_reference(&s_bench_config, &regs); s_bench_sink = regs.v2i_factor);
+    NRF_LOG_INFO("float reference         %6u", cycles);
+
+    vTaskDelete(NULL);
+}
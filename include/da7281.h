@@ -30,6 +30,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "da7281_registers.h"
 #include "da7281_config.h"
 
@@ -51,6 +52,9 @@ typedef enum {
     DA7281_ERROR_ALREADY_INITIALIZED,   /**< Device already initialized */
     DA7281_ERROR_CHIP_REV_MISMATCH,     /**< Chip revision verification failed */
     DA7281_ERROR_MUTEX_FAILED,          /**< Mutex operation failed */
+    DA7281_ERROR_BUSY,                  /**< Transfer queue full */
+    DA7281_ERROR_VERIFY_FAILED,         /**< Register readback differs from what was written */
+    DA7281_ERROR_ABORTED,               /**< Sequence stopped before SEQ_DONE (fault or ETWM left) */
     DA7281_ERROR_UNKNOWN                /**< Unknown error */
 } da7281_error_t;
 
@@ -66,6 +70,17 @@ typedef enum {
     DA7281_MODE_STANDBY = DA7281_OP_MODE_STANDBY     /**< Standby Mode */
 } da7281_operation_mode_t;
 
+/**
+ * @brief Readback verification of mode and configuration writes
+ *
+ * ALWAYS is 0 so zero-initialized device handles keep the safe default.
+ */
+typedef enum {
+    DA7281_VERIFY_ALWAYS = 0,   /**< Read the register back after every write */
+    DA7281_VERIFY_DEFERRED,     /**< Queue the check for da7281_verify_flush() */
+    DA7281_VERIFY_NEVER         /**< No readback (streaming paths) */
+} da7281_verify_t;
+
 /**
  * @brief DA7281 motor types
  */
@@ -86,15 +101,187 @@ typedef struct {
 } da7281_lra_config_t;
 
 /**
- * @brief DA7281 device handle
+ * @brief LRA register values computed from a da7281_lra_config_t
+ */
+typedef struct {
+    uint16_t lra_per;               /**< LRA_PER_H/L (0x0A/0x0B) */
+    uint8_t nommax;                 /**< ACTUATOR_NOMMAX (0x0C) */
+    uint8_t absmax;                 /**< ACTUATOR_ABSMAX (0x0D) */
+    uint8_t imax;                   /**< ACTUATOR_IMAX (0x0E) */
+    uint16_t v2i_factor;            /**< V2I_FACTOR_H/L (0x0F/0x10) */
+} da7281_lra_regs_t;
+
+/**
+ * @brief One register value of a register image
+ */
+typedef struct {
+    uint8_t reg;                    /**< Register address */
+    uint8_t value;                  /**< Value to write */
+} da7281_reg_value_t;
+
+/**
+ * @brief Precomputed register values, usually const in flash
+ *
+ * Generated for actuator profiles by scripts/da7281_profiles.py. Entries
+ * are in ascending address order, each address at most once.
+ */
+typedef struct {
+    const char *name;               /**< Profile name (logging only, may be NULL) */
+    const da7281_reg_value_t *regs; /**< Entries */
+    uint8_t count;                  /**< Number of entries */
+} da7281_register_image_t;
+
+/**
+ * @brief One masked register write of a write set
+ */
+typedef struct {
+    uint8_t reg;                    /**< Register address */
+    uint8_t mask;                   /**< Bits to change (0xFF = whole register) */
+    uint8_t value;                  /**< New value of the masked bits */
+} da7281_write_entry_t;
+
+/**
+ * @brief Batch of register writes, committed as few bursts as possible
+ *
+ * Filled with da7281_write_set_add() in any order, written by
+ * da7281_write_set_commit(). Caller-owned; reusable after commit.
+ */
+typedef struct {
+    da7281_write_entry_t entries[DA7281_WRITE_SET_MAX]; /**< One entry per register */
+    uint8_t count;                                      /**< Entries in use */
+} da7281_write_set_t;
+
+/**
+ * @brief One stored sequence of a playlist
+ */
+typedef struct {
+    uint8_t seq_id;                 /**< Sequence ID (0-15) */
+    uint8_t loops;                  /**< Repeats after the first play (0-15) */
+} da7281_seq_entry_t;
+
+/**
+ * @brief IRQ/status register block (0x03-0x06), read in one transaction
+ */
+typedef struct {
+    uint8_t irq_event1;             /**< IRQ_EVENT1 (0x03), write 1 to clear */
+    uint8_t irq_event_warning_diag; /**< IRQ_EVENT_WARNING_DIAG (0x04) */
+    uint8_t irq_event_seq_diag;     /**< IRQ_EVENT_SEQ_DIAG (0x05) */
+    uint8_t irq_status1;            /**< IRQ_STATUS1 (0x06) */
+} da7281_status_block_t;
+
+/**
+ * @brief Events dispatched to a da7281_irq_configure() handler
+ *
+ * Values are the IRQ_EVENT1 bits. E_SEQ_CONTINUE is consumed by the
+ * playlist (da7281_queue_sequence()) and not dispatched.
+ */
+typedef enum {
+    DA7281_EVENT_OC_FAULT       = DA7281_IRQ_EVENT1_E_OC_FAULT,       /**< Over-current / short circuit */
+    DA7281_EVENT_ACTUATOR_FAULT = DA7281_IRQ_EVENT1_E_ACTUATOR_FAULT, /**< Actuator fault */
+    DA7281_EVENT_OVERTEMP       = DA7281_IRQ_EVENT1_E_OVERTEMP_CRIT,  /**< Critical over-temperature */
+    DA7281_EVENT_UVLO           = DA7281_IRQ_EVENT1_E_UVLO,           /**< Under-voltage lockout */
+    DA7281_EVENT_WARNING        = DA7281_IRQ_EVENT1_E_WARNING,        /**< System warning (see IRQ_EVENT_WARNING_DIAG) */
+    DA7281_EVENT_SEQ_FAULT      = DA7281_IRQ_EVENT1_E_SEQ_FAULT,      /**< Sequence fault (see IRQ_EVENT_SEQ_DIAG) */
+    DA7281_EVENT_SEQ_DONE       = DA7281_IRQ_EVENT1_E_SEQ_DONE        /**< Sequence playback complete */
+} da7281_event_t;
+
+/**
+ * @brief Shadow copy of the DA7281 register map
+ *
+ * Write-through cache for registers flagged DA7281_REG_ATTR_CACHEABLE.
+ * Storage is owned by the application and attached via the device handle.
  */
 typedef struct {
+    uint8_t value[DA7281_REG_CACHE_SIZE];                   /**< Last known register values */
+    uint8_t valid[(DA7281_REG_CACHE_SIZE + 7U) / 8U];       /**< One bit per register */
+    uint32_t hits;                                          /**< Cached reads served without bus access */
+    uint32_t misses;                                        /**< Cached reads that had to go to the bus */
+} da7281_reg_cache_t;
+
+/** DA7281 device handle (defined below) */
+typedef struct da7281_device da7281_device_t;
+
+/**
+ * @brief Completion callback for asynchronous transfers and sequences
+ *
+ * Called from the TWI interrupt handler once the transfer has finished.
+ * Keep it short and use only ISR-safe FreeRTOS calls. Sequence
+ * completions (da7281_play_sequence()) are called from the task that runs
+ * da7281_handle_events(), or the call that left ETWM, instead.
+ *
+ * @param device Device the transfer was issued for
+ * @param result DA7281_OK, DA7281_ERROR_I2C_WRITE or DA7281_ERROR_I2C_READ
+ *               (sequences: DA7281_OK or DA7281_ERROR_ABORTED)
+ * @param context User pointer passed at submission
+ */
+typedef void (*da7281_xfer_cb_t)(da7281_device_t *device, da7281_error_t result, void *context);
+
+/**
+ * @brief Event handler installed with da7281_irq_configure()
+ *
+ * Called from the driver's interrupt task, once per latched event, after
+ * the events have been read and cleared and the bus session has ended,
+ * so it may call any driver function.
+ *
+ * @param device Device that asserted nIRQ
+ * @param event One latched event
+ * @param status Event and status registers as read, before clearing
+ * @param context User pointer passed to da7281_irq_configure()
+ */
+typedef void (*da7281_event_cb_t)(da7281_device_t *device, da7281_event_t event,
+                                  const da7281_status_block_t *status, void *context);
+
+/**
+ * @brief DA7281 device handle
+ */
+struct da7281_device {
     uint8_t twi_instance;           /**< TWI/I2C instance (0 or 1) */
     uint8_t i2c_address;            /**< I2C address (0x48, 0x49, 0x4A, or 0x4B) */
     bool initialized;               /**< Initialization status */
     da7281_operation_mode_t mode;   /**< Current operation mode */
     void *twi_handle;               /**< Platform-specific TWI handle */
-} da7281_device_t;
+    da7281_reg_cache_t *cache;      /**< Optional shadow register cache (NULL = disabled) */
+    da7281_verify_t verify;         /**< Readback policy of mode/config writes (default ALWAYS) */
+    uint8_t verify_count;           /**< Deferred checks in verify_queue */
+    da7281_write_entry_t verify_queue[DA7281_VERIFY_QUEUE_DEPTH]; /**< Expected bits per register */
+    bool seq_pending;               /**< da7281_play_sequence() awaiting SEQ_DONE */
+    da7281_xfer_cb_t seq_callback;  /**< Called once the pending sequence ends (may be NULL) */
+    void *seq_context;              /**< User pointer for seq_callback */
+    bool seq_continue;              /**< SEQ_CTL1.SEQ_CONTINUE as last written */
+    uint8_t playlist_head;          /**< Index of the next queued sequence */
+    uint8_t playlist_count;         /**< Sequences queued */
+    da7281_seq_entry_t playlist[DA7281_PLAYLIST_DEPTH]; /**< Chained after the playing one */
+    uint8_t irq_pin;                /**< GPIO wired to nIRQ (valid while irq_handler is set) */
+    da7281_event_cb_t irq_handler;  /**< Typed event handler (NULL = no interrupt) */
+    void *irq_context;              /**< User pointer for irq_handler */
+};
+
+#if DA7281_ENABLE_STATS
+/**
+ * @brief Transfer counters of one bus or one device
+ *
+ * Histogram bins saturate at 0xFFFF; sums wrap.
+ */
+typedef struct {
+    uint32_t transactions;          /**< Frames completed (each device of a chained write counts) */
+    uint32_t bytes;                 /**< Bytes after the address byte (register address included) */
+    uint32_t errors;                /**< Frames NACKed or refused by the backend */
+    uint32_t timeouts;              /**< Blocking calls whose completion never arrived */
+    uint32_t lock_timeouts;         /**< Bus lock not obtained in time */
+    uint32_t lock_wait_us;          /**< Total time spent waiting for the bus lock */
+    uint32_t xfer_us;               /**< Total time from frame start to completion */
+    uint16_t lock_wait_hist[DA7281_STATS_HIST_BUCKETS];   /**< Lock waits, log2 us buckets */
+    uint16_t xfer_hist[DA7281_STATS_HIST_BUCKETS];        /**< Frame times, log2 us buckets */
+} da7281_stats_counters_t;
+
+/**
+ * @brief Statistics snapshot of both buses and all eight device addresses
+ */
+typedef struct {
+    da7281_stats_counters_t bus[2];         /**< Per TWI instance */
+    da7281_stats_counters_t device[2][4];   /**< [TWI instance][I2C address - 0x48] */
+} da7281_stats_t;
+#endif /* DA7281_ENABLE_STATS */
 
 /* ========================================================================
  * Function Prototypes - Initialization & Control
@@ -139,9 +326,100 @@ da7281_error_t da7281_deinit(da7281_device_t *device);
 da7281_error_t da7281_configure_lra(da7281_device_t *device,
                                      const da7281_lra_config_t *config);
 
+/**
+ * @brief Configure LRA parameters, writing only registers that change
+ *
+ * Same as da7281_configure_lra(), but registers whose shadow copy already
+ * holds the new value are not written (see da7281_write_burst_diff()).
+ * Needs device->cache; without one every register is written.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] config Pointer to LRA configuration
+ * @param[out] skipped Register bytes left unwritten (may be NULL)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_configure_lra_diff(da7281_device_t *device,
+                                          const da7281_lra_config_t *config,
+                                          uint8_t *skipped);
+
+/**
+ * @brief Write a precomputed register image
+ *
+ * One burst per run of consecutive addresses; several runs share one bus
+ * lock. The image is validated before anything is written.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] image Register image
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_apply_register_image(da7281_device_t *device,
+                                           const da7281_register_image_t *image);
+
+/**
+ * @brief Write the entries of a register image that differ from the shadow cache
+ *
+ * Switching between images then costs only the changed bytes. Needs
+ * device->cache; without one every entry is written.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] image Register image
+ * @param[out] skipped Entries left unwritten (may be NULL)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_apply_register_image_diff(da7281_device_t *device,
+                                                const da7281_register_image_t *image,
+                                                uint8_t *skipped);
+
+/**
+ * @brief Compute the LRA register values without touching the device
+ *
+ * Same validation and values as da7281_configure_lra(); integer math after
+ * one rounding of each float field to mohm or mV.
+ *
+ * @param[in] config Pointer to LRA configuration
+ * @param[out] regs Register values
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_lra_compute(const da7281_lra_config_t *config, da7281_lra_regs_t *regs);
+
+/**
+ * @brief LRA_PER for a resonant frequency (integer math)
+ *
+ * @param[in] freq_hz Resonant frequency in Hz
+ * @return LRA_PER rounded to nearest, saturated to 1..65535
+ */
+uint16_t da7281_lra_per_from_hz(uint16_t freq_hz);
+
+/**
+ * @brief ACTUATOR_IMAX for a current limit (integer math)
+ *
+ * @param[in] current_ma Maximum current in mA
+ * @return IMAX rounded to nearest, saturated to 0..255
+ */
+uint8_t da7281_imax_from_ma(uint16_t current_ma);
+
+/**
+ * @brief V2I_FACTOR for an impedance and current limit (integer math)
+ *
+ * @param[in] impedance_mohm Actuator impedance in milliohm (1000..50000)
+ * @param[in] current_ma Maximum current in mA (50..500)
+ * @return V2I_FACTOR rounded to nearest, saturated to 1..65535
+ */
+uint16_t da7281_v2i_from_mohm(uint32_t impedance_mohm, uint16_t current_ma);
+
+/**
+ * @brief ACTUATOR_NOMMAX or ACTUATOR_ABSMAX for a voltage (integer math)
+ *
+ * @param[in] voltage_mv Voltage in mV
+ * @return Code rounded down (23.4 mV per LSB), saturated to 255
+ */
+uint8_t da7281_vmax_from_mv(uint16_t voltage_mv);
+
 /**
  * @brief Set operation mode
  *
+ * TOP_CTL1 is read back according to device->verify.
+ *
  * @param[in] device Pointer to device handle
  * @param[in] mode Operation mode to set
  * @return DA7281_OK on success, error code otherwise
@@ -149,6 +427,27 @@ da7281_error_t da7281_configure_lra(da7281_device_t *device,
 da7281_error_t da7281_set_operation_mode(da7281_device_t *device,
                                           da7281_operation_mode_t mode);
 
+/**
+ * @brief Set operation mode with an explicit verify policy
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] mode Operation mode to set
+ * @param[in] verify Readback policy for this call only
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_set_operation_mode_policy(da7281_device_t *device,
+                                                 da7281_operation_mode_t mode,
+                                                 da7281_verify_t verify);
+
+/**
+ * @brief Read back every deferred check in one burst
+ *
+ * @param[in] device Pointer to device handle
+ * @return DA7281_OK if all registers hold the expected bits (or nothing
+ *         was pending), DA7281_ERROR_VERIFY_FAILED otherwise
+ */
+da7281_error_t da7281_verify_flush(da7281_device_t *device);
+
 /**
  * @brief Get current operation mode
  *
@@ -173,6 +472,24 @@ da7281_error_t da7281_get_operation_mode(da7281_device_t *device,
 da7281_error_t da7281_set_override_amplitude(da7281_device_t *device,
                                                uint8_t amplitude);
 
+/**
+ * @brief Set override amplitudes on several devices together
+ *
+ * Writes TOP_CTL2 on all devices with one lock per bus, chaining the
+ * writes on each bus with repeated STARTs and driving both buses in
+ * parallel, so the devices change amplitude with minimal skew.
+ *
+ * @param[in] devices Device handles (any mix of TWI0 and TWI1)
+ * @param[in] amplitudes amplitudes[i] is applied to devices[i]
+ * @param[in] count Number of devices
+ * @return DA7281_OK on success, error code otherwise
+ *
+ * @note Devices must be in DRO mode for this to take effect
+ */
+da7281_error_t da7281_set_override_amplitude_multi(da7281_device_t *const devices[],
+                                                     const uint8_t amplitudes[],
+                                                     uint8_t count);
+
 /**
  * @brief Enable/disable amplifier
  *
@@ -183,6 +500,147 @@ da7281_error_t da7281_set_override_amplitude(da7281_device_t *device,
 da7281_error_t da7281_set_amplifier_enable(da7281_device_t *device,
                                              bool enable);
 
+/**
+ * @brief Start or retune a DRO vibration with the fewest writes
+ *
+ * Enables the amplifier if needed and enters DRO at the given amplitude
+ * from any mode. With a shadow cache, from stopped, this is one I2C frame.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] amplitude Override amplitude (TOP_CTL2)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_play_dro(da7281_device_t *device, uint8_t amplitude);
+
+/**
+ * @brief Stop playback (INACTIVE, amplitude 0) in one frame
+ *
+ * @param[in] device Pointer to device handle
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_stop(da7281_device_t *device);
+
+/**
+ * @brief Play a stored sequence in ETWM, completing on SEQ_DONE
+ *
+ * Writes SEQ_CTL2 (skipped if the cache shows it unchanged) and
+ * TOP_CTL1 = ETWM | SEQ_START, then returns. The callback runs from
+ * da7281_handle_events() once the chip reports SEQ_DONE (DA7281_OK) or
+ * a sequence or device fault (DA7281_ERROR_ABORTED), or from any call
+ * that leaves ETWM: da7281_stop(), da7281_play_dro(),
+ * da7281_set_operation_mode() or da7281_snp_upload()
+ * (DA7281_ERROR_ABORTED, SEQ_CONTINUE cleared, playlist dropped).
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] seq_id Sequence ID in the waveform memory (0-15)
+ * @param[in] loops Repeats after the first play (0-15)
+ * @param[in] callback Completion callback (may be NULL)
+ * @param[in] context User pointer passed to the callback
+ * @return DA7281_OK once playback has started, DA7281_ERROR_BUSY if a
+ *         sequence is still pending, error code otherwise
+ */
+da7281_error_t da7281_play_sequence(da7281_device_t *device,
+                                      uint8_t seq_id,
+                                      uint8_t loops,
+                                      da7281_xfer_cb_t callback,
+                                      void *context);
+
+/**
+ * @brief Queue a sequence to follow the current one without a gap
+ *
+ * Before da7281_play_sequence() the entry waits for it; while a sequence
+ * is pending it is chained through SEQ_CTL1.SEQ_CONTINUE and the
+ * E_SEQ_CONTINUE event. The pending callback runs once, after the last
+ * queued sequence.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] seq_id Sequence ID in the waveform memory (0-15)
+ * @param[in] loops Repeats after the first play (0-15)
+ * @return DA7281_OK on success, DA7281_ERROR_BUSY if the queue is full,
+ *         error code otherwise
+ */
+da7281_error_t da7281_queue_sequence(da7281_device_t *device, uint8_t seq_id, uint8_t loops);
+
+/**
+ * @brief Read, clear and act on latched events
+ *
+ * One burst read of IRQ_EVENT1..IRQ_STATUS1 and, if any event is latched,
+ * one write-1-to-clear of IRQ_EVENT1 (releasing nIRQ). Completes a
+ * pending da7281_play_sequence(). Call when nIRQ asserts.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[out] status Register block as read, before clearing (may be NULL)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_handle_events(da7281_device_t *device, da7281_status_block_t *status);
+
+/**
+ * @brief Serve the device from its nIRQ line instead of polling
+ *
+ * Arms a falling-edge interrupt on pin. On each edge the driver's
+ * interrupt task runs da7281_handle_events() (one burst read, one clear)
+ * and calls handler once per latched da7281_event_t. Events masked in
+ * IRQ_MASK1 never assert nIRQ. A NULL handler detaches the device.
+ * Devices wired-OR onto one GPIO share the pin; an edge there is served
+ * by scanning them, both buses in parallel, most recently active first.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] pin GPIO number of the nIRQ input
+ * @param[in] handler Typed event handler (NULL to detach)
+ * @param[in] context User pointer passed to the handler
+ * @return DA7281_OK on success, DA7281_ERROR_BUSY if
+ *         DA7281_IRQ_MAX_DEVICES are attached, error code otherwise
+ */
+da7281_error_t da7281_irq_configure(da7281_device_t *device, uint8_t pin,
+                                      da7281_event_cb_t handler, void *context);
+
+/**
+ * @brief Load a waveform image into the SNP memory and verify it
+ *
+ * Unlocks MEM_CTL2, writes the image from SNP_MEM_0 in auto-increment
+ * bursts (one frame for the whole 100-byte window), restores the lock and
+ * checks a one-burst readback by CRC. An active mode is left first.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] image Image bytes (SNP_MEM_0 first)
+ * @param[in] len Number of bytes (1 to DA7281_SNP_MEM_SIZE)
+ * @return DA7281_OK on success, DA7281_ERROR_VERIFY_FAILED if the readback differs
+ */
+da7281_error_t da7281_snp_upload(da7281_device_t *device, const uint8_t *image, uint8_t len);
+
+/**
+ * @brief Check the start of the SNP memory against a CRC (one burst read)
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] len Number of bytes from SNP_MEM_0 (1 to DA7281_SNP_MEM_SIZE)
+ * @param[in] crc Expected da7281_snp_crc() of those bytes
+ * @return DA7281_OK if they match, DA7281_ERROR_VERIFY_FAILED otherwise
+ */
+da7281_error_t da7281_snp_verify(da7281_device_t *device, uint8_t len, uint16_t crc);
+
+/**
+ * @brief CRC-16/CCITT-FALSE of a waveform image
+ *
+ * @param[in] image Image bytes
+ * @param[in] len Number of bytes
+ * @return CRC (0xFFFF for an empty image)
+ */
+uint16_t da7281_snp_crc(const uint8_t *image, uint8_t len);
+
+/**
+ * @brief Read all IRQ event and status registers
+ *
+ * Reads IRQ_EVENT1, IRQ_EVENT_WARNING_DIAG, IRQ_EVENT_SEQ_DIAG and
+ * IRQ_STATUS1 (0x03-0x06) with a single burst read. Event bits are not
+ * cleared.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[out] status Pointer to store the register block
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_read_status_block(da7281_device_t *device,
+                                         da7281_status_block_t *status);
+
 /**
  * @brief Read chip ID
  *
@@ -230,6 +688,58 @@ da7281_error_t da7281_i2c_configure_pins(uint8_t instance,
                                           uint8_t scl_pin,
                                           uint8_t sda_pin);
 
+/**
+ * @brief Initialize a TWI bus (mutex, completion semaphore, peripheral)
+ *
+ * Call once per bus after da7281_i2c_configure_pins() and before any
+ * register access. da7281_init() calls it for the device's bus, so
+ * existing code does not need to change. Repeated calls are no-ops.
+ *
+ * @param[in] instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success, error code otherwise
+ *
+ * @note Heap-free when DA7281_STATIC_ALLOCATION is enabled
+ */
+da7281_error_t da7281_bus_init(uint8_t instance);
+
+/**
+ * @brief Begin a bus session (one lock acquisition for many operations)
+ *
+ * Blocking register calls made by the same task on this bus, for any
+ * device, run under a single lock until da7281_bus_end(). Sessions nest.
+ * Other tasks' asynchronous calls on the bus, and those made from
+ * completion callbacks, return DA7281_ERROR_BUSY meanwhile.
+ *
+ * @param[in] instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_bus_begin(uint8_t instance);
+
+/**
+ * @brief End a bus session started with da7281_bus_begin()
+ *
+ * @param[in] instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_bus_end(uint8_t instance);
+
+#if DA7281_ENABLE_STATS
+/**
+ * @brief Copy the transfer statistics
+ *
+ * Taken with the bus interrupts masked, so the snapshot is consistent.
+ *
+ * @param[out] stats Snapshot of all counters
+ * @return DA7281_OK on success, DA7281_ERROR_NULL_POINTER if stats is NULL
+ */
+da7281_error_t da7281_stats_get(da7281_stats_t *stats);
+
+/**
+ * @brief Zero all transfer statistics
+ */
+void da7281_stats_reset(void);
+#endif /* DA7281_ENABLE_STATS */
+
 /* ========================================================================
  * Function Prototypes - Low-Level I2C (Internal Use)
  * ======================================================================== */
@@ -248,6 +758,41 @@ da7281_error_t da7281_write_register(da7281_device_t *device,
                                        uint8_t reg_addr,
                                        uint8_t value);
 
+/**
+ * @brief Write consecutive registers in one auto-increment transaction
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] start_reg First register address
+ * @param[in] buf Values for start_reg, start_reg + 1, ...
+ * @param[in] len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @return DA7281_OK on success, error code otherwise
+ *
+ * @note This function is thread-safe (uses FreeRTOS mutex)
+ */
+da7281_error_t da7281_write_burst(da7281_device_t *device,
+                                    uint8_t start_reg,
+                                    const uint8_t *buf,
+                                    uint8_t len);
+
+/**
+ * @brief Write one register on several devices, chained per bus
+ *
+ * Devices are grouped by TWI bus; each bus is locked once and its writes
+ * go out back to back with repeated STARTs. Both buses run in parallel.
+ *
+ * @param[in] devices Device handles
+ * @param[in] reg_addr Register address written on every device
+ * @param[in] values values[i] is written to devices[i]
+ * @param[in] count Number of devices (up to DA7281_I2C_QUEUE_DEPTH per bus)
+ * @return DA7281_OK on success, error code otherwise
+ *
+ * @note This function is thread-safe (uses FreeRTOS mutex)
+ */
+da7281_error_t da7281_write_register_multi(da7281_device_t *const devices[],
+                                             uint8_t reg_addr,
+                                             const uint8_t values[],
+                                             uint8_t count);
+
 /**
  * @brief Read single byte from register
  *
@@ -262,10 +807,103 @@ da7281_error_t da7281_read_register(da7281_device_t *device,
                                       uint8_t reg_addr,
                                       uint8_t *value);
 
+/**
+ * @brief Write only the bytes of a burst that differ from the shadow cache
+ *
+ * Bytes whose shadow copy is valid and equal are skipped; the remaining
+ * changes are written as bursts, joining runs separated by at most
+ * DA7281_DIFF_MERGE_GAP unchanged bytes, under one bus lock. Without a
+ * cache this is da7281_write_burst().
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] start_reg First register address
+ * @param[in] buf Values for start_reg, start_reg + 1, ...
+ * @param[in] len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @param[out] skipped Bytes not sent because they were unchanged (may be NULL)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_write_burst_diff(da7281_device_t *device,
+                                        uint8_t start_reg,
+                                        const uint8_t *buf,
+                                        uint8_t len,
+                                        uint8_t *skipped);
+
+/**
+ * @brief Read consecutive registers in one auto-increment transaction
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] start_reg First register address
+ * @param[out] buf Buffer for start_reg, start_reg + 1, ...
+ * @param[in] len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @return DA7281_OK on success, error code otherwise
+ *
+ * @note This function is thread-safe (uses FreeRTOS mutex)
+ */
+da7281_error_t da7281_read_burst(da7281_device_t *device,
+                                   uint8_t start_reg,
+                                   uint8_t *buf,
+                                   uint8_t len);
+
+/**
+ * @brief Read the same registers from several devices, chained per bus
+ *
+ * Devices are grouped by TWI bus; each bus is locked once and its reads
+ * go out back to back. Both buses run in parallel.
+ *
+ * @param[in] devices Device handles
+ * @param[in] start_reg First register address
+ * @param[out] bufs bufs[i] receives len bytes from devices[i]
+ * @param[in] len Bytes per device (devices on one bus * len <= DA7281_I2C_MAX_BURST_LEN)
+ * @param[in] count Number of devices (up to DA7281_I2C_QUEUE_DEPTH per bus)
+ * @return DA7281_OK on success, error code otherwise
+ *
+ * @note This function is thread-safe (uses FreeRTOS mutex)
+ */
+da7281_error_t da7281_read_burst_multi(da7281_device_t *const devices[],
+                                         uint8_t start_reg,
+                                         uint8_t *const bufs[],
+                                         uint8_t len,
+                                         uint8_t count);
+
+/**
+ * @brief Read register through the shadow cache
+ *
+ * Served from device->cache when the register is cacheable and its shadow
+ * is valid; otherwise reads the bus and fills the shadow.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] reg_addr Register address
+ * @param[out] value Pointer to store value
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_read_register_cached(da7281_device_t *device,
+                                             uint8_t reg_addr,
+                                             uint8_t *value);
+
+/**
+ * @brief Invalidate the shadow register cache
+ *
+ * Forces the next cached access to every register back to the bus.
+ * Called automatically on init and when a fault is reported.
+ *
+ * @param[in] device Pointer to device handle
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_cache_invalidate(da7281_device_t *device);
+
+/**
+ * @brief Get register attributes
+ *
+ * @param[in] reg_addr Register address
+ * @return Bitwise OR of DA7281_REG_ATTR_* flags (0 for undefined addresses)
+ */
+uint8_t da7281_reg_attr(uint8_t reg_addr);
+
 /**
  * @brief Modify register bits
  *
- * Read-modify-write operation on a register.
+ * Read-modify-write operation on a register. With a shadow cache attached,
+ * cacheable registers are read from the cache and only the write hits the bus.
  *
  * @param[in] device Pointer to device handle
  * @param[in] reg_addr Register address
@@ -278,6 +916,143 @@ da7281_error_t da7281_modify_register(da7281_device_t *device,
                                         uint8_t mask,
                                         uint8_t value);
 
+/**
+ * @brief Empty a write set
+ *
+ * @param[out] set Write set
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_write_set_init(da7281_write_set_t *set);
+
+/**
+ * @brief Add a masked register write to a write set
+ *
+ * A second write to the same register is fused into the first entry;
+ * where masks overlap, the later value wins. Volatile registers (e.g. the
+ * write-1-to-clear IRQ_EVENT1) only accept mask 0xFF.
+ *
+ * @param[in,out] set Write set
+ * @param[in] reg_addr Register address (writable, not reserved)
+ * @param[in] mask Bits to change (0xFF = whole register)
+ * @param[in] value New value of the masked bits
+ * @return DA7281_OK on success, DA7281_ERROR_INVALID_PARAM for a read-only
+ *         or reserved register, a partial mask on a volatile register or a
+ *         full set
+ */
+da7281_error_t da7281_write_set_add(da7281_write_set_t *set,
+                                     uint8_t reg_addr,
+                                     uint8_t mask,
+                                     uint8_t value);
+
+/**
+ * @brief Write a write set with the fewest I2C frames
+ *
+ * Sorts the entries by address, resolves partial masks against the
+ * current values (shadow cache when attached), writes runs of consecutive
+ * registers as auto-increment bursts and volatile or command registers
+ * (DA7281_REG_ATTR_NO_BURST) on their own, last. One bus lock for all.
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in,out] set Write set (left sorted)
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_write_set_commit(da7281_device_t *device, da7281_write_set_t *set);
+
+/* ========================================================================
+ * Function Prototypes - Asynchronous I2C
+ * ======================================================================== */
+
+/**
+ * @brief Queue a single register write and return immediately
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] reg_addr Register address
+ * @param[in] value Value to write
+ * @param[in] callback Completion callback (may be NULL)
+ * @param[in] context User pointer passed to the callback
+ * @return DA7281_OK if queued, DA7281_ERROR_BUSY if the queue is full or
+ *         another task holds a session on the bus (da7281_bus_begin()),
+ *         error code otherwise
+ *
+ * @note Returns before the transfer starts; completion is reported from the TWI interrupt
+ */
+da7281_error_t da7281_write_register_async(da7281_device_t *device,
+                                             uint8_t reg_addr,
+                                             uint8_t value,
+                                             da7281_xfer_cb_t callback,
+                                             void *context);
+
+/**
+ * @brief Queue a single register read and return immediately
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] reg_addr Register address
+ * @param[out] value Destination, must stay valid until the callback
+ * @param[in] callback Completion callback (may be NULL)
+ * @param[in] context User pointer passed to the callback
+ * @return DA7281_OK if queued, DA7281_ERROR_BUSY if the queue is full or
+ *         another task holds a session on the bus (da7281_bus_begin()),
+ *         error code otherwise
+ */
+da7281_error_t da7281_read_register_async(da7281_device_t *device,
+                                            uint8_t reg_addr,
+                                            uint8_t *value,
+                                            da7281_xfer_cb_t callback,
+                                            void *context);
+
+/**
+ * @brief Queue a burst write and return immediately
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] start_reg First register address
+ * @param[in] buf Values to write, must stay valid until the callback
+ * @param[in] len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @param[in] callback Completion callback (may be NULL)
+ * @param[in] context User pointer passed to the callback
+ * @return DA7281_OK if queued, DA7281_ERROR_BUSY if the queue is full or
+ *         another task holds a session on the bus (da7281_bus_begin()),
+ *         error code otherwise
+ */
+da7281_error_t da7281_write_burst_async(da7281_device_t *device,
+                                          uint8_t start_reg,
+                                          const uint8_t *buf,
+                                          uint8_t len,
+                                          da7281_xfer_cb_t callback,
+                                          void *context);
+
+/**
+ * @brief Queue a burst read and return immediately
+ *
+ * @param[in] device Pointer to device handle
+ * @param[in] start_reg First register address
+ * @param[out] buf Destination, must stay valid until the callback
+ * @param[in] len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @param[in] callback Completion callback (may be NULL)
+ * @param[in] context User pointer passed to the callback
+ * @return DA7281_OK if queued, DA7281_ERROR_BUSY if the queue is full or
+ *         another task holds a session on the bus (da7281_bus_begin()),
+ *         error code otherwise
+ */
+da7281_error_t da7281_read_burst_async(da7281_device_t *device,
+                                         uint8_t start_reg,
+                                         uint8_t *buf,
+                                         uint8_t len,
+                                         da7281_xfer_cb_t callback,
+                                         void *context);
+
+/**
+ * @brief Ready-made completion callback that notifies a task
+ *
+ * Pass the TaskHandle_t to wake as context; the task waits with
+ * ulTaskNotifyTake(). The result is not forwarded. Provided by the nRF
+ * (FreeRTOS) bus backend only.
+ *
+ * @param[in] device Device the transfer was issued for (unused)
+ * @param[in] result Transfer result (unused)
+ * @param[in] context TaskHandle_t of the task to notify
+ */
+void da7281_xfer_notify_task(da7281_device_t *device, da7281_error_t result, void *context);
+
 #ifdef __cplusplus
 }
 #endif
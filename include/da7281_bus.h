@@ -0,0 +1,242 @@
+/**
+ * @file da7281_bus.h
+ * @brief DA7281 HAL Bus Backend Interface
+ * @author A. R. Ansari
+ * @date 2024-11-21
+ *
+ * The I2C layer (src/da7281_i2c.c) owns the transfer queues, the shadow
+ * cache and the public register API. Everything that touches hardware or
+ * the RTOS goes through a da7281_bus_ops_t table:
+ *
+ * - da7281_bus_ops_nrf:  nrf_drv_twi / nrfx_twim and FreeRTOS
+ *                        (src/da7281_bus_nrf.c)
+ * - da7281_bus_ops_host: DA7281 models (da7281_sim.h) on a 400 kHz
+ *                        virtual-time bus (src/da7281_bus_host.c)
+ *
+ * DA7281_PLATFORM selects the default; da7281_bus_set_ops() installs any
+ * other table before the first da7281_bus_init().
+ */
+
+#ifndef DA7281_BUS_H
+#define DA7281_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "da7281.h"
+
+/* ========================================================================
+ * Type Definitions
+ * ======================================================================== */
+
+/**
+ * @brief One I2C frame as started by the backend
+ *
+ * Write: START, address+W, tx[0..tx_len-1], STOP (or no STOP if no_stop).
+ * Read:  START, address+W, tx[0..tx_len-1], repeated START, address+R,
+ *        rx[0..rx_len-1], STOP.
+ */
+typedef struct {
+    uint8_t address;        /**< 7-bit I2C address */
+    const uint8_t *tx;      /**< Register address, followed by data for writes (RAM) */
+    uint16_t tx_len;        /**< Bytes in tx */
+    uint8_t *rx;            /**< Read destination (NULL = write frame) */
+    uint16_t rx_len;        /**< Bytes to read */
+    bool no_stop;           /**< Write only: end without STOP, next frame starts with repeated START */
+} da7281_bus_frame_t;
+
+/**
+ * @brief Bus backend operations
+ *
+ * All functions are mandatory. instance is the TWI bus number (0 or 1).
+ */
+typedef struct {
+    /** Bring up the bus and its lock/completion objects (called once per bus) */
+    da7281_error_t (*init)(uint8_t instance, uint8_t scl_pin, uint8_t sda_pin);
+
+    /**
+     * Start a frame. The backend reports the end of the frame by calling
+     * da7281_bus_event() exactly once, from its interrupt or from inside
+     * transfer(). Returns an error (and reports nothing) if the frame
+     * could not be started.
+     */
+    da7281_error_t (*transfer)(uint8_t instance, const da7281_bus_frame_t *frame);
+
+    /** Serialize tasks on a bus (may block up to the lock timeout) */
+    da7281_error_t (*lock)(uint8_t instance);
+
+    /** Release the lock taken by lock() */
+    void (*unlock)(uint8_t instance);
+
+    /**
+     * Block until signal() for this bus, up to timeout_ms. A timeout of 0
+     * only consumes a pending signal. Returns DA7281_ERROR_TIMEOUT if none.
+     */
+    da7281_error_t (*wait)(uint8_t instance, uint32_t timeout_ms);
+
+    /** Wake the task in wait() (called from completion context) */
+    void (*signal)(uint8_t instance);
+
+    /** Mask the bus interrupts; returns state for irq_unlock() (nestable) */
+    uint32_t (*irq_lock)(void);
+
+    /** Restore the state returned by irq_lock() */
+    void (*irq_unlock)(uint32_t state);
+
+    /** Sleep for ms milliseconds */
+    void (*delay)(uint32_t ms);
+
+    /** Monotonic time in microseconds (also called from completion context) */
+    uint32_t (*now)(void);
+
+    /** Identity of the calling task (bus session ownership); distinct in interrupt context */
+    void *(*self)(void);
+
+    /**
+     * Arm (enable) or disarm the falling-edge interrupt of an active-low
+     * GPIO input. Each edge is reported with da7281_bus_pin_event() from
+     * interrupt context.
+     */
+    da7281_error_t (*pin_irq)(uint8_t pin, bool enable);
+
+    /** true while an active-low input is asserted (low) */
+    bool (*pin_asserted)(uint8_t pin);
+
+    /**
+     * Wake the driver's interrupt task, which calls da7281_irq_service()
+     * (called from interrupt context)
+     */
+    void (*defer)(void);
+} da7281_bus_ops_t;
+
+/**
+ * @brief Traffic counters of the host backend
+ */
+typedef struct {
+    uint32_t transactions;      /**< STOP-terminated frames */
+    uint32_t address_phases;    /**< START and repeated START conditions */
+    uint32_t bytes;             /**< Bytes after the address byte */
+    uint32_t bits;              /**< SCL clocks incl. START/STOP and ACK bits */
+    uint32_t bus_bits[2];       /**< bits per TWI instance (the two buses overlap on hardware) */
+    uint32_t lock_takes;        /**< lock() calls */
+    uint32_t nacks;             /**< Frames not acknowledged */
+} da7281_bus_host_stats_t;
+
+/* ========================================================================
+ * Backends
+ * ======================================================================== */
+
+/** nRF52 backend (nrf_drv_twi or nrfx_twim per DA7281_I2C_BACKEND, FreeRTOS locks) */
+extern const da7281_bus_ops_t da7281_bus_ops_nrf;
+
+/** Host backend (four DA7281 models per bus at 0x48..0x4B, virtual 400 kHz time) */
+extern const da7281_bus_ops_t da7281_bus_ops_host;
+
+/** GPIOs of the host backend that nIRQ lines can be wired to */
+#define DA7281_BUS_HOST_PINS    (32U)
+
+/** Pin argument of da7281_bus_host_wire_irq() that disconnects nIRQ */
+#define DA7281_BUS_HOST_NO_PIN  (0xFFU)
+
+/** Frame kinds of da7281_bus_host_fail() */
+#define DA7281_BUS_HOST_FAIL_READS      (1U << 0)
+#define DA7281_BUS_HOST_FAIL_WRITES     (1U << 1)
+
+/* ========================================================================
+ * Function Prototypes
+ * ======================================================================== */
+
+/**
+ * @brief Install a bus backend
+ *
+ * @param[in] ops Backend operations (must stay valid)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if ops is NULL
+ * @return DA7281_ERROR_ALREADY_INITIALIZED if a bus is already up
+ */
+da7281_error_t da7281_bus_set_ops(const da7281_bus_ops_t *ops);
+
+/**
+ * @brief Backend currently in use
+ *
+ * @return Pointer to the active operations table
+ */
+const da7281_bus_ops_t *da7281_bus_get_ops(void);
+
+/**
+ * @brief Frame completion, called by the backend
+ *
+ * @param[in] instance TWI instance number (0 or 1)
+ * @param[in] success true if every byte was acknowledged
+ */
+void da7281_bus_event(uint8_t instance, bool success);
+
+/**
+ * @brief Falling edge on an armed nIRQ input, called by the backend
+ *
+ * Marks the devices on that line and wakes the interrupt task (defer()).
+ * Interrupt context.
+ *
+ * @param[in] pin GPIO number
+ */
+void da7281_bus_pin_event(uint8_t pin);
+
+/**
+ * @brief Serve every device whose nIRQ line fell, called by the backend
+ *
+ * Body of the driver's interrupt task: da7281_handle_events() and the
+ * typed handlers of each marked device. Task context.
+ */
+void da7281_irq_service(void);
+
+/**
+ * @brief Reset the host backend: device models, counters and virtual time
+ *
+ * Power-on resets every simulated device (da7281_sim_reset()).
+ */
+void da7281_bus_host_reset(void);
+
+/**
+ * @brief Host backend traffic counters since the last reset
+ *
+ * @param[out] stats Counter snapshot
+ */
+void da7281_bus_host_stats(da7281_bus_host_stats_t *stats);
+
+/**
+ * @brief Clear the host backend counters (devices and time are kept)
+ */
+void da7281_bus_host_clear_stats(void);
+
+/**
+ * @brief Wire a simulated device's nIRQ output to a host GPIO
+ *
+ * Devices wired to the same pin share it as an open-drain (wired-OR)
+ * line. The interrupt task runs inside the backend's delay(), at the
+ * virtual time of the edge, whenever no bus lock is held.
+ *
+ * @param[in] instance TWI instance number (0 or 1)
+ * @param[in] address 7-bit device address (0x48..0x4B)
+ * @param[in] pin GPIO below DA7281_BUS_HOST_PINS, or DA7281_BUS_HOST_NO_PIN
+ */
+void da7281_bus_host_wire_irq(uint8_t instance, uint8_t address, uint8_t pin);
+
+/**
+ * @brief NACK the next frames of some kinds sent to one device
+ *
+ * The device is not addressed by a failed frame (no register changes).
+ * Cleared by da7281_bus_host_reset() or a count of 0.
+ *
+ * @param[in] instance TWI instance number (0 or 1)
+ * @param[in] address 7-bit device address
+ * @param[in] kinds DA7281_BUS_HOST_FAIL_READS and/or DA7281_BUS_HOST_FAIL_WRITES
+ * @param[in] count Frames to fail (UINT32_MAX = until cleared)
+ */
+void da7281_bus_host_fail(uint8_t instance, uint8_t address, uint8_t kinds, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DA7281_BUS_H */
@@ -36,6 +36,79 @@ extern "C" {
 #define DA7281_I2C_TIMEOUT_MS           (100U)
 #endif
 
+/**
+ * I2C transport backend
+ *
+ * DA7281_I2C_BACKEND_TWI:  legacy nrf_drv_twi on the TWI peripheral. The
+ *                          CPU services one interrupt per byte.
+ * DA7281_I2C_BACKEND_TWIM: nrfx_twim with EasyDMA. A burst write or a
+ *                          write-then-read is one DMA job and one interrupt.
+ *                          Requires NRFX_TWIM_ENABLED (and NRFX_TWIMn_ENABLED
+ *                          in place of NRFX_TWIn_ENABLED) in sdk_config.h.
+ */
+#define DA7281_I2C_BACKEND_TWI          (0U)
+#define DA7281_I2C_BACKEND_TWIM         (1U)
+
+#ifndef DA7281_I2C_BACKEND
+#define DA7281_I2C_BACKEND              DA7281_I2C_BACKEND_TWI
+#endif
+
+/**
+ * Platform providing the default bus backend (da7281_bus_ops_t)
+ *
+ * DA7281_PLATFORM_NRF:  nrf_drv_twi / nrfx_twim with FreeRTOS locking
+ *                       (src/da7281_bus_nrf.c).
+ * DA7281_PLATFORM_HOST: in-memory register files on a virtual-time bus
+ *                       for native builds (src/da7281_bus_host.c).
+ *
+ * da7281_bus_set_ops() can install any other backend at run time.
+ */
+#define DA7281_PLATFORM_NRF             (0U)
+#define DA7281_PLATFORM_HOST            (1U)
+
+#ifndef DA7281_PLATFORM
+#define DA7281_PLATFORM                 DA7281_PLATFORM_NRF
+#endif
+
+/** Maximum data bytes in one auto-increment burst (covers the 100-byte SNP window) */
+#ifndef DA7281_I2C_MAX_BURST_LEN
+#define DA7281_I2C_MAX_BURST_LEN        (100U)
+#endif
+
+/**
+ * Unchanged bytes a diff write rewrites to join two changed runs into one
+ * burst; a new frame costs the address and register bytes (2) plus a
+ * START/STOP, so bridging up to 2 bytes is never slower
+ */
+#ifndef DA7281_DIFF_MERGE_GAP
+#define DA7281_DIFF_MERGE_GAP           (2U)
+#endif
+
+/** Entries in a da7281_write_set_t (distinct registers) */
+#ifndef DA7281_WRITE_SET_MAX
+#define DA7281_WRITE_SET_MAX            (16U)
+#endif
+
+/** Registers with a deferred readback check per device (DA7281_VERIFY_DEFERRED) */
+#ifndef DA7281_VERIFY_QUEUE_DEPTH
+#define DA7281_VERIFY_QUEUE_DEPTH       (4U)
+#endif
+
+/** Sequences queued behind the playing one per device (da7281_queue_sequence()) */
+#ifndef DA7281_PLAYLIST_DEPTH
+#define DA7281_PLAYLIST_DEPTH           (8U)
+#endif
+
+/** Devices served from nIRQ lines (da7281_irq_configure()), at most 8 */
+#ifndef DA7281_IRQ_MAX_DEVICES
+#define DA7281_IRQ_MAX_DEVICES          (4U)
+#endif
+
+/** Pending asynchronous transfers per TWI bus (including the one in flight) */
+#ifndef DA7281_I2C_QUEUE_DEPTH
+#define DA7281_I2C_QUEUE_DEPTH          (8U)
+#endif
+
 /** Power-on delay in milliseconds (datasheet minimum: 1.5ms) */
 #ifndef DA7281_POWER_ON_DELAY_MS
 #define DA7281_POWER_ON_DELAY_MS        (2U)
@@ -71,11 +144,88 @@ extern "C" {
 #define DA7281_ENABLE_FREERTOS_MUTEX    (1U)
 #endif
 
+/**
+ * Bus locking strategy (compile time, no runtime dispatch)
+ *
+ * DA7281_BUS_LOCK_MUTEX:    per-bus FreeRTOS mutex; waiting tasks sleep.
+ * DA7281_BUS_LOCK_CRITICAL: scheduler suspended for the transfer; the caller
+ *                           spins until the TWI interrupt completes it
+ *                           (interrupts stay enabled). For short transfers.
+ * DA7281_BUS_LOCK_NONE:     no lock; each bus is owned by a single task.
+ *
+ * Defaults to MUTEX, or NONE when DA7281_ENABLE_FREERTOS_MUTEX is 0.
+ */
+#define DA7281_BUS_LOCK_MUTEX           (0U)
+#define DA7281_BUS_LOCK_CRITICAL        (1U)
+#define DA7281_BUS_LOCK_NONE            (2U)
+
+#ifndef DA7281_BUS_LOCK
+#if DA7281_ENABLE_FREERTOS_MUTEX
+#define DA7281_BUS_LOCK                 DA7281_BUS_LOCK_MUTEX
+#else
+#define DA7281_BUS_LOCK                 DA7281_BUS_LOCK_NONE
+#endif
+#endif
+
+/** Busy-wait iterations before a transfer times out in DA7281_BUS_LOCK_CRITICAL mode */
+#ifndef DA7281_I2C_SPIN_LIMIT
+#define DA7281_I2C_SPIN_LIMIT           (1000000UL)
+#endif
+
+/**
+ * Allocate the per-bus mutex and completion semaphore statically
+ * (xSemaphoreCreate*Static) so the driver never touches the FreeRTOS heap.
+ * Requires configSUPPORT_STATIC_ALLOCATION = 1. Set to 0 to use the heap.
+ */
+#ifndef DA7281_STATIC_ALLOCATION
+#define DA7281_STATIC_ALLOCATION        (1U)
+#endif
+
+/**
+ * FreeRTOS priority of the nIRQ task (nRF backend), created by the first
+ * da7281_irq_configure(). Keep it above the tasks that play effects so
+ * event latency does not depend on their load.
+ */
+#ifndef DA7281_IRQ_TASK_PRIORITY
+#define DA7281_IRQ_TASK_PRIORITY        (configMAX_PRIORITIES - 1U)
+#endif
+
+/**
+ * Stack of the nIRQ task in words. Event handlers run on it, and a shared
+ * line is scanned with the multi-bus chains (~0.5 KB of chain buffers).
+ */
+#ifndef DA7281_IRQ_TASK_STACK_WORDS
+#define DA7281_IRQ_TASK_STACK_WORDS     (512U)
+#endif
+
 /** FreeRTOS mutex timeout in ticks */
 #ifndef DA7281_MUTEX_TIMEOUT_TICKS
 #define DA7281_MUTEX_TIMEOUT_TICKS      (pdMS_TO_TICKS(100))
 #endif
 
+/**
+ * TIMER the nRF backend runs free at 1 MHz for now() (statistics times,
+ * binary log timestamps). It needs no interrupt, is read from the TWI
+ * interrupt and keeps counting with the scheduler suspended; the 32-bit
+ * counter wraps with now()'s microseconds (~71.6 min). Reserve it for
+ * the driver (the SoftDevice owns TIMER0).
+ */
+#ifndef DA7281_NOW_TIMER
+#define DA7281_NOW_TIMER                NRF_TIMER4
+#endif
+
+/**
+ * Per-bus and per-device transfer statistics (da7281_stats_get()).
+ * Times come from the bus backend's now(), 1 us on both backends.
+ * With 0 the counters, their RAM and the API are compiled out.
+ */
+#ifndef DA7281_ENABLE_STATS
+#define DA7281_ENABLE_STATS             (0U)
+#endif
+
+/** Buckets per latency histogram: [0] under 1 us, [k] 2^(k-1) to 2^k - 1 us, last open-ended */
+#define DA7281_STATS_HIST_BUCKETS       (16U)
+
 /* ========================================================================
  * Default LRA Configuration
  * ======================================================================== */
@@ -154,12 +304,28 @@ extern "C" {
  *   0 = Disabled (no logging)
  *   1 = UART_PRINTF (Direct printf to UART)
  *   2 = SEGGER_RTT (Direct SEGGER RTT, blocking)
+ *   3 = APP_LOG (forward to the application logger)
+ *   4 = BINARY (deferred binary records, see da7281_log.h; decode with
+ *       scripts/da7281_log.py)
+ *
+ * DA7281_LOG_LEVEL removes every call above the given level at compile
+ * time, whatever the backend.
  * ======================================================================== */
 
 #ifndef DA7281_LOG_BACKEND
 #define DA7281_LOG_BACKEND              (2U)
 #endif
 
+#define DA7281_LOG_LEVEL_NONE           (0U)
+#define DA7281_LOG_LEVEL_ERROR          (1U)
+#define DA7281_LOG_LEVEL_WARNING        (2U)
+#define DA7281_LOG_LEVEL_INFO           (3U)
+#define DA7281_LOG_LEVEL_DEBUG          (4U)
+
+#ifndef DA7281_LOG_LEVEL
+#define DA7281_LOG_LEVEL                DA7281_LOG_LEVEL_DEBUG
+#endif
+
 /* ========================================================================
  * Logging Macros
  * ======================================================================== */
@@ -201,10 +367,37 @@ extern "C" {
 #define DA7281_LOG_INFO(...)    APP_LOG_INFO(__VA_ARGS__)
 #define DA7281_LOG_DEBUG(...)   APP_LOG_DEBUG(__VA_ARGS__)
 
+#elif (DA7281_LOG_BACKEND == 4)
+
+/* Deferred binary records (never blocks, safe from interrupts) */
+#include "da7281_log.h"
+#define DA7281_LOG_ERROR(...)   DA7281_LOG_BINARY(DA7281_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define DA7281_LOG_WARNING(...) DA7281_LOG_BINARY(DA7281_LOG_LEVEL_WARNING, __VA_ARGS__)
+#define DA7281_LOG_INFO(...)    DA7281_LOG_BINARY(DA7281_LOG_LEVEL_INFO, __VA_ARGS__)
+#define DA7281_LOG_DEBUG(...)   DA7281_LOG_BINARY(DA7281_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
 #else
-#error "Invalid DA7281_LOG_BACKEND value. Must be 0-3."
+#error "Invalid DA7281_LOG_BACKEND value. Must be 0-4."
 #endif /* DA7281_LOG_BACKEND */
 
+/* Compile-time level filter */
+#if (DA7281_LOG_LEVEL < DA7281_LOG_LEVEL_DEBUG)
+#undef DA7281_LOG_DEBUG
+#define DA7281_LOG_DEBUG(...)   ((void)0)
+#endif
+#if (DA7281_LOG_LEVEL < DA7281_LOG_LEVEL_INFO)
+#undef DA7281_LOG_INFO
+#define DA7281_LOG_INFO(...)    ((void)0)
+#endif
+#if (DA7281_LOG_LEVEL < DA7281_LOG_LEVEL_WARNING)
+#undef DA7281_LOG_WARNING
+#define DA7281_LOG_WARNING(...) ((void)0)
+#endif
+#if (DA7281_LOG_LEVEL < DA7281_LOG_LEVEL_ERROR)
+#undef DA7281_LOG_ERROR
+#define DA7281_LOG_ERROR(...)   ((void)0)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
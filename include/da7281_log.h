@@ -0,0 +1,206 @@
+/**
+ * @file da7281_log.h
+ * @brief DA7281 Binary Deferred Logging (DA7281_LOG_BACKEND = 4)
+ * @author A. R. Ansari
+ * @date 2024-11-21
+ *
+ * DA7281_LOG_* calls store a compact record in a RAM ring buffer instead
+ * of formatting text. Format strings are not compiled into the firmware;
+ * scripts/da7281_log.py builds a string table from the sources and turns
+ * the drained byte stream back into messages on the host.
+ *
+ * Record layout (little-endian):
+ *
+ *   [0]    total record length in bytes (written last, 0 = not committed)
+ *   [1..2] log site: DA7281_LOG_FILE_ID << 12 | source line
+ *   [3..6] timestamp in microseconds (bus backend now())
+ *   [7..]  arguments in call order: integers and enums as 4 bytes,
+ *          float/double as IEEE-754 single, strings as one length byte
+ *          plus up to DA7281_LOG_MAX_STR_LEN characters
+ *
+ * Site DA7281_LOG_SITE_DROPPED reports records lost to a full buffer or to
+ * the rate limit; its one argument is the number lost.
+ *
+ * Producers (tasks and interrupts) reserve space with a compare-and-swap
+ * and never block or wait; a record that does not fit is dropped. Exactly
+ * one task drains the buffer with da7281_log_read().
+ */
+
+#ifndef DA7281_LOG_H
+#define DA7281_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ========================================================================
+ * Configuration
+ * ======================================================================== */
+
+/** Ring buffer size in bytes (power of two) */
+#ifndef DA7281_LOG_BUFFER_SIZE
+#define DA7281_LOG_BUFFER_SIZE          (1024U)
+#endif
+
+/** Records per level and rate window before further ones are dropped (0 = no limit) */
+#ifndef DA7281_LOG_RATE_LIMIT
+#define DA7281_LOG_RATE_LIMIT           (32U)
+#endif
+
+/** Rate window in milliseconds */
+#ifndef DA7281_LOG_RATE_WINDOW_MS
+#define DA7281_LOG_RATE_WINDOW_MS       (100U)
+#endif
+
+/** Longest string argument kept; longer strings are truncated */
+#define DA7281_LOG_MAX_STR_LEN          (15U)
+
+/** Site ID of the records-dropped notice */
+#define DA7281_LOG_SITE_DROPPED         (0xFFFFU)
+
+/** Source file number of the log sites in this translation unit (0-14) */
+#ifndef DA7281_LOG_FILE_ID
+#define DA7281_LOG_FILE_ID              (0U)
+#endif
+
+/* ========================================================================
+ * Type Definitions
+ * ======================================================================== */
+
+/** Argument encodings */
+typedef enum {
+    DA7281_LOG_ARG_U32 = 0,             /**< Integer, 4 bytes */
+    DA7281_LOG_ARG_F32,                 /**< Float, 4 bytes */
+    DA7281_LOG_ARG_STR                  /**< Length byte + characters */
+} da7281_log_arg_type_t;
+
+/** One captured argument */
+typedef struct {
+    uint8_t type;                       /**< da7281_log_arg_type_t */
+    union {
+        uint32_t u;
+        float f;
+        const char *s;
+    } v;
+} da7281_log_arg_t;
+
+/** Logger counters */
+typedef struct {
+    uint32_t records;                   /**< Records committed */
+    uint32_t dropped_full;              /**< Records lost to a full buffer */
+    uint32_t dropped_rate;              /**< Records lost to the rate limit */
+} da7281_log_stats_t;
+
+/* ========================================================================
+ * Argument Capture
+ * ======================================================================== */
+
+static inline da7281_log_arg_t da7281_log_arg_u(uint32_t value)
+{
+    da7281_log_arg_t arg = {DA7281_LOG_ARG_U32, {0U}};
+    arg.v.u = value;
+    return arg;
+}
+
+static inline da7281_log_arg_t da7281_log_arg_f(double value)
+{
+    da7281_log_arg_t arg = {DA7281_LOG_ARG_F32, {0U}};
+    arg.v.f = (float)value;
+    return arg;
+}
+
+static inline da7281_log_arg_t da7281_log_arg_s(const char *value)
+{
+    da7281_log_arg_t arg = {DA7281_LOG_ARG_STR, {0U}};
+    arg.v.s = value;
+    return arg;
+}
+
+/** Capture one argument by its C type */
+#define DA7281_LOG_ARG(x) _Generic((x),                 \
+    float: da7281_log_arg_f,                            \
+    double: da7281_log_arg_f,                           \
+    char *: da7281_log_arg_s,                           \
+    const char *: da7281_log_arg_s,                     \
+    default: da7281_log_arg_u)(x)
+
+/* Format string followed by up to 8 arguments; the format itself is dropped */
+#define DA7281_LOG_NARG_(_1, _2, _3, _4, _5, _6, _7, _8, _9, N, ...) N
+#define DA7281_LOG_NARG(...) DA7281_LOG_NARG_(__VA_ARGS__, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DA7281_LOG_CAT_(a, b) a##b
+#define DA7281_LOG_CAT(a, b) DA7281_LOG_CAT_(a, b)
+
+#define DA7281_LOG_ARGS_1(f)
+#define DA7281_LOG_ARGS_2(f, a) DA7281_LOG_ARG(a)
+#define DA7281_LOG_ARGS_3(f, a, ...) DA7281_LOG_ARG(a), DA7281_LOG_ARGS_2(f, __VA_ARGS__)
+#define DA7281_LOG_ARGS_4(f, a, ...) DA7281_LOG_ARG(a), DA7281_LOG_ARGS_3(f, __VA_ARGS__)
+#define DA7281_LOG_ARGS_5(f, a, ...) DA7281_LOG_ARG(a), DA7281_LOG_ARGS_4(f, __VA_ARGS__)
+#define DA7281_LOG_ARGS_6(f, a, ...) DA7281_LOG_ARG(a), DA7281_LOG_ARGS_5(f, __VA_ARGS__)
+#define DA7281_LOG_ARGS_7(f, a, ...) DA7281_LOG_ARG(a), DA7281_LOG_ARGS_6(f, __VA_ARGS__)
+#define DA7281_LOG_ARGS_8(f, a, ...) DA7281_LOG_ARG(a), DA7281_LOG_ARGS_7(f, __VA_ARGS__)
+#define DA7281_LOG_ARGS_9(f, a, ...) DA7281_LOG_ARG(a), DA7281_LOG_ARGS_8(f, __VA_ARGS__)
+
+/** Site ID of the log call on this line */
+#define DA7281_LOG_SITE ((uint16_t)(((uint16_t)(DA7281_LOG_FILE_ID) << 12) | ((uint16_t)__LINE__ & 0x0FFFU)))
+
+/**
+ * @brief Record one log call (level 1 = error ... 4 = debug)
+ *
+ * Element 0 of the argument array is a placeholder so calls without
+ * arguments still have a valid initializer.
+ */
+#define DA7281_LOG_BINARY(level, ...) do {                                                  \
+    const da7281_log_arg_t da7281_log_args_[] = {                                           \
+        {DA7281_LOG_ARG_U32, {0U}},                                                         \
+        DA7281_LOG_CAT(DA7281_LOG_ARGS_, DA7281_LOG_NARG(__VA_ARGS__))(__VA_ARGS__)          \
+    };                                                                                      \
+    da7281_log_write(DA7281_LOG_SITE, (uint8_t)(level), &da7281_log_args_[1],               \
+                     (uint8_t)((sizeof(da7281_log_args_) / sizeof(da7281_log_args_[0])) - 1U)); \
+} while (0)
+
+/* ========================================================================
+ * Function Prototypes
+ * ======================================================================== */
+
+/**
+ * @brief Store one record (any context, never blocks)
+ *
+ * @param site Log site ID (DA7281_LOG_SITE)
+ * @param level Severity, 1 = error ... 4 = debug (rate-limited per level)
+ * @param args Captured arguments
+ * @param count Number of arguments
+ */
+void da7281_log_write(uint16_t site, uint8_t level, const da7281_log_arg_t *args, uint8_t count);
+
+/**
+ * @brief Move committed records out of the ring buffer
+ *
+ * Copies whole records only. When records were dropped since the last
+ * call, a DA7281_LOG_SITE_DROPPED record comes first. Call from a single
+ * low-priority task and forward the bytes (RTT channel, UART, flash).
+ *
+ * @param[out] buf Destination
+ * @param[in] size Capacity of buf (at least 255 to always make progress)
+ * @return Number of bytes written to buf
+ */
+uint32_t da7281_log_read(uint8_t *buf, uint32_t size);
+
+/**
+ * @brief Logger counters since the last reset
+ *
+ * @param[out] stats Counter snapshot
+ */
+void da7281_log_get_stats(da7281_log_stats_t *stats);
+
+/**
+ * @brief Empty the buffer and zero the counters (no producers may run)
+ */
+void da7281_log_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DA7281_LOG_H */
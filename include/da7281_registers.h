@@ -140,6 +140,21 @@ extern "C" {
 #define DA7281_REG_SNP_MEM_BASE         (0x84U)
 #define DA7281_REG_SNP_MEM_END          (0xE7U)
 
+/** Size of the waveform memory window in bytes */
+#define DA7281_SNP_MEM_SIZE             (DA7281_REG_SNP_MEM_END - DA7281_REG_SNP_MEM_BASE + 1U)
+
+/** Number of register addresses covered by the shadow cache (0x00-0xE7) */
+#define DA7281_REG_CACHE_SIZE           (DA7281_REG_SNP_MEM_END + 1U)
+
+/* ========================================================================
+ * Register Attributes (see da7281_reg_attr())
+ * ======================================================================== */
+
+#define DA7281_REG_ATTR_CACHEABLE       (0x01U)  /**< Only changes when the host writes it */
+#define DA7281_REG_ATTR_VOLATILE        (0x02U)  /**< Changed by the chip, always read from the bus */
+#define DA7281_REG_ATTR_READ_ONLY       (0x04U)  /**< Writes are ignored by the chip */
+#define DA7281_REG_ATTR_NO_BURST        (0x08U)  /**< Command register, written on its own (write sets) */
+
 /* ========================================================================
  * Register Bit Field Definitions
  * ======================================================================== */
@@ -160,6 +175,12 @@ extern "C" {
 #define DA7281_IRQ_EVENT1_E_UVLO            (0x02U)  /**< Bit 1 - Under-voltage lockout */
 #define DA7281_IRQ_EVENT1_E_SEQ_CONTINUE    (0x01U)  /**< Bit 0 - Sequence continue */
 
+/** IRQ_EVENT1 events after which the chip may have changed or reset its registers */
+#define DA7281_IRQ_EVENT1_FAULT_MASK        (DA7281_IRQ_EVENT1_E_OC_FAULT | \
+                                             DA7281_IRQ_EVENT1_E_ACTUATOR_FAULT | \
+                                             DA7281_IRQ_EVENT1_E_OVERTEMP_CRIT | \
+                                             DA7281_IRQ_EVENT1_E_UVLO)
+
 /* TOP_CTL1 (0x22) - Operation Mode Control */
 #define DA7281_TOP_CTL1_OP_MODE_MASK    (0x07U)
 #define DA7281_TOP_CTL1_OP_MODE_SHIFT   (0U)
@@ -194,6 +215,21 @@ extern "C" {
 /* TOP_CTL2 (0x23) - Override Value */
 #define DA7281_TOP_CTL2_OVERRIDE_VAL_MASK   (0xFFU)         /**< Override amplitude value */
 
+/* SEQ_CTL1 (0x24) - Sequencer control */
+#define DA7281_SEQ_CTL1_SEQ_CONTINUE        (0x01U)         /**< Bit 0 - Chain the sequence in SEQ_CTL2 at the end */
+
+/* SEQ_CTL2 (0x28) - Sequence selection for ETWM/RTWM playback */
+#define DA7281_SEQ_CTL2_PS_SEQ_ID_MASK      (0x0FU)         /**< Bits [3:0] - Sequence ID (0-15) */
+#define DA7281_SEQ_CTL2_PS_SEQ_ID_SHIFT     (0U)
+#define DA7281_SEQ_CTL2_PS_SEQ_LOOP_MASK    (0xF0U)         /**< Bits [7:4] - Repeats after the first play */
+#define DA7281_SEQ_CTL2_PS_SEQ_LOOP_SHIFT   (4U)
+
+/* MEM_CTL1 (0x2C) - Waveform memory base address (reset 0x84) */
+#define DA7281_MEM_CTL1_WAV_MEM_BASE_ADDR   DA7281_REG_SNP_MEM_BASE
+
+/* MEM_CTL2 (0x2D) - Waveform memory lock */
+#define DA7281_MEM_CTL2_WAV_MEM_LOCK        (0x80U)         /**< 1: SNP memory writable, 0: writes ignored */
+
 /* ACTUATOR_NOMMAX (0x0C) - Voltage scaling factor */
 #define DA7281_ACTUATOR_NOMMAX_SCALE        (23.4F)         /**< mV per LSB */
 
@@ -211,6 +247,14 @@ extern "C" {
 #define DA7281_V2I_FACTOR_DIVISOR           (1.6104F)       /**< Formula divisor */
 #define DA7281_V2I_FACTOR_IMAX_OFFSET       (4.0F)          /**< IMAX offset in formula */
 
+/* Integer forms of the constants above, used by the fixed-point register math */
+#define DA7281_ACTUATOR_VMAX_MV_NUM         (5U)            /**< 23.4 mV per LSB = 117 / 5 */
+#define DA7281_ACTUATOR_VMAX_MV_DEN         (117U)
+#define DA7281_ACTUATOR_IMAX_OFFSET_DMA     (286U)          /**< 28.6 mA in 0.1 mA */
+#define DA7281_ACTUATOR_IMAX_SCALE_DMA      (72U)           /**< 7.2 mA in 0.1 mA */
+#define DA7281_LRA_PER_HZ_X2                (1500015U)      /**< 2 / LRA_PER_TIME_SCALE, integer part */
+#define DA7281_V2I_FACTOR_DIVISOR_E4        (16104U)        /**< 1.6104 x 10^4 */
+
 /* Expected chip revision value (DA7281 Datasheet v3.1, Table 21) */
 #define DA7281_CHIP_REV_VALUE               (0xCAU)
 /* Legacy chip revision value observed on early boards */
@@ -0,0 +1,209 @@
+/**
+ * @file da7281_sim.h
+ * @brief Behavioral DA7281 Model for Host Builds
+ * @author A. R. Ansari
+ * @date 2024-11-21
+ *
+ * Register-level model of up to four DA7281 devices (0x48..0x4B) on each
+ * of the two TWI buses, driven by the host bus backend
+ * (src/da7281_bus_host.c), which charges every frame in virtual time at
+ * 400 kHz. The model follows da7281_registers.h:
+ *
+ * - CHIP_REV, IRQ_EVENT_WARNING_DIAG, IRQ_EVENT_SEQ_DIAG, IRQ_STATUS1 and
+ *   IRQ_STATUS2 are read-only; writes are acknowledged and dropped.
+ * - IRQ_EVENT1 and IRQ_EVENT_ACTUATOR_FAULT are write-1-to-clear.
+ * - Reserved addresses read 0 and ignore writes.
+ * - TOP_CTL1 OP_MODE accepts INACTIVE, DRO, PWM, RTWM, ETWM and STANDBY;
+ *   reserved codes leave the mode unchanged. Active modes need
+ *   ACTUATOR_NOMMAX and LRA_PER to be non-zero, otherwise the device stays
+ *   INACTIVE and latches E_ACTUATOR_FAULT.
+ * - SEQ_START in RTWM/ETWM plays for the sequence duration times
+ *   (SEQ_CTL2.PS_SEQ_LOOP + 1), then self-clears and latches E_SEQ_DONE.
+ *   SEQ_CTL2 is latched when a segment starts. With SEQ_CTL1.SEQ_CONTINUE
+ *   set, E_SEQ_CONTINUE latches at each segment start, and at its end the
+ *   segment now in SEQ_CTL2 starts on the same edge instead of stopping. In any other mode it self-clears
+ *   at once and latches E_SEQ_FAULT. Leaving the mode aborts playback.
+ * - Conditions (da7281_sim_set_condition()) show in IRQ_STATUS1 and latch
+ *   the same bit in IRQ_EVENT1. DA7281_IRQ_EVENT1_FAULT_MASK conditions
+ *   force the device to INACTIVE.
+ * - nIRQ is asserted while IRQ_EVENT1 has a bit that IRQ_MASK1 does not
+ *   mask.
+ * - SNP memory (0x84..0xE7) ignores writes while MEM_CTL2.WAV_MEM_LOCK is
+ *   clear (the reset state). MEM_CTL1 resets to 0x84.
+ */
+
+#ifndef DA7281_SIM_H
+#define DA7281_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ========================================================================
+ * Configuration
+ * ======================================================================== */
+
+/** Simulated TWI buses */
+#define DA7281_SIM_INSTANCES        (2U)
+
+/** Simulated devices per bus, at 0x48..0x4B */
+#define DA7281_SIM_DEVICES          (4U)
+
+/** Playback time of one pass of a sequence after reset, in microseconds */
+#define DA7281_SIM_SEQ_DEFAULT_US   (10000U)
+
+/* ========================================================================
+ * Type Definitions
+ * ======================================================================== */
+
+/**
+ * @brief nIRQ edge notification
+ *
+ * Called from the bus model (inside a transfer or while virtual time
+ * advances) whenever a device's nIRQ level changes. Must not start
+ * blocking driver calls.
+ *
+ * @param instance TWI instance number
+ * @param address 7-bit device address
+ * @param asserted true when nIRQ went low
+ */
+typedef void (*da7281_sim_irq_handler_t)(uint8_t instance, uint8_t address, bool asserted);
+
+/* ========================================================================
+ * Bus Model Interface (used by the host bus backend)
+ * ======================================================================== */
+
+/**
+ * @brief Address phase: true if the device acknowledges
+ */
+bool da7281_sim_select(uint8_t instance, uint8_t address);
+
+/**
+ * @brief One data byte written to a selected device
+ *
+ * @param first true for the first byte of a frame (register address)
+ */
+void da7281_sim_write(uint8_t instance, uint8_t address, uint8_t byte, bool first);
+
+/**
+ * @brief One data byte read from a selected device (auto-increment)
+ */
+uint8_t da7281_sim_read(uint8_t instance, uint8_t address);
+
+/**
+ * @brief Advance the model to a virtual time
+ *
+ * @param now_ns Virtual time since reset in nanoseconds (monotonic)
+ */
+void da7281_sim_advance(uint64_t now_ns);
+
+/**
+ * @brief Earliest virtual time at which a device changes state on its own
+ *
+ * @return End of the earliest playing segment in nanoseconds, UINT64_MAX
+ *         if nothing is scheduled
+ */
+uint64_t da7281_sim_next_event_ns(void);
+
+/* ========================================================================
+ * Test Interface
+ * ======================================================================== */
+
+/**
+ * @brief Power-on reset of every simulated device
+ *
+ * Registers return to their reset values (CHIP_REV 0xCA, MEM_CTL1 0x84,
+ * everything else 0), all devices acknowledge, conditions clear, virtual time restarts at
+ * 0. The IRQ handler is kept.
+ */
+void da7281_sim_reset(void);
+
+/**
+ * @brief Register value without bus traffic or side effects
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit address (0x48..0x4B)
+ * @param reg Register address
+ * @return Register value (0 for unknown devices)
+ */
+uint8_t da7281_sim_peek(uint8_t instance, uint8_t address, uint8_t reg);
+
+/**
+ * @brief Overwrite a register without bus traffic or side effects
+ *
+ * Fault injection, e.g. a corrupted waveform memory byte.
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit address (0x48..0x4B)
+ * @param reg Register address
+ * @param value New contents
+ */
+void da7281_sim_poke(uint8_t instance, uint8_t address, uint8_t reg, uint8_t value);
+
+/**
+ * @brief Make a simulated device ACK or NACK its address
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit address (0x48..0x4B)
+ * @param present false to NACK every frame to this address
+ */
+void da7281_sim_set_present(uint8_t instance, uint8_t address, bool present);
+
+/**
+ * @brief Raise or clear a live condition (fault, warning, ...)
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit address (0x48..0x4B)
+ * @param bits DA7281_IRQ_EVENT1_E_* bits
+ * @param active true to raise (latches IRQ_EVENT1), false to clear
+ */
+void da7281_sim_set_condition(uint8_t instance, uint8_t address, uint8_t bits, bool active);
+
+/**
+ * @brief Playback time of one pass of a sequence (SEQ_START with PS_SEQ_LOOP 0)
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit address (0x48..0x4B)
+ * @param duration_us Sequence duration in microseconds
+ */
+void da7281_sim_set_seq_duration(uint8_t instance, uint8_t address, uint32_t duration_us);
+
+/**
+ * @brief Idle time between the end of the previous segment and the start
+ *        of the latest one (0 for a chained start or the first segment)
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit address (0x48..0x4B)
+ * @return Gap in microseconds
+ */
+uint32_t da7281_sim_seq_gap_us(uint8_t instance, uint8_t address);
+
+/**
+ * @brief Segments started since reset (SEQ_START and chained starts)
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit address (0x48..0x4B)
+ * @return Segment count
+ */
+uint32_t da7281_sim_seq_segments(uint8_t instance, uint8_t address);
+
+/**
+ * @brief Current nIRQ level of a device
+ *
+ * @return true while nIRQ is asserted (low)
+ */
+bool da7281_sim_nirq(uint8_t instance, uint8_t address);
+
+/**
+ * @brief Install the nIRQ edge handler (NULL to remove)
+ */
+void da7281_sim_set_irq_handler(da7281_sim_irq_handler_t handler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DA7281_SIM_H */
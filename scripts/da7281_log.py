@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+DA7281 binary log tools (DA7281_LOG_BACKEND = 4)
+
+The firmware stores log site IDs and raw arguments instead of text (see
+include/da7281_log.h). This script rebuilds the messages on the host.
+
+Usage:
+  da7281_log.py table <source.c>... > table.json
+      Build the string table: site ID -> level and format string. Sources
+      without '#define DA7281_LOG_FILE_ID' use file number 0.
+
+  da7281_log.py decode <table.json> <log.bin>
+      Print the records in a drained byte stream as text.
+
+The table must be built from the same sources as the firmware, since the
+site ID contains the line number of each DA7281_LOG_* call.
+
+Author: A. R. Ansari
+Date: 2024-11-21
+"""
+
+import json
+import re
+import struct
+import sys
+
+SITE_DROPPED = 0xFFFF
+HEADER_LEN = 7
+
+LEVEL_TAGS = {"ERROR": "ERR", "WARNING": "WRN", "INFO": "INF", "DEBUG": "DBG"}
+
+FILE_ID_RE = re.compile(r"#define\s+DA7281_LOG_FILE_ID\s+\(?\s*(\d+)U?\s*\)?")
+CALL_RE = re.compile(r"\bDA7281_LOG_(ERROR|WARNING|INFO|DEBUG)\s*\(")
+LITERAL_RE = re.compile(r'\s*"((?:[^"\\]|\\.)*)"')
+SPEC_RE = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z)?([diouxXfFeEgGcs%])")
+
+
+# ==========================================================================
+# String table
+# ==========================================================================
+
+def unescape(text):
+    return text.encode("latin-1").decode("unicode_escape")
+
+
+def scan_source(path, table):
+    with open(path, encoding="utf-8") as f:
+        src = f.read()
+
+    match = FILE_ID_RE.search(src)
+    file_id = int(match.group(1)) if match else 0
+
+    for call in CALL_RE.finditer(src):
+        # Skip the macro definitions themselves
+        line_start = src.rfind("\n", 0, call.start()) + 1
+        if src[line_start:call.start()].lstrip().startswith("#"):
+            continue
+
+        pos = call.end()
+        parts = []
+        while True:
+            lit = LITERAL_RE.match(src, pos)
+            if lit is None:
+                break
+            parts.append(unescape(lit.group(1)))
+            pos = lit.end()
+        if not parts:
+            continue
+
+        line = src.count("\n", 0, call.start()) + 1
+        site = (file_id << 12) | (line & 0x0FFF)
+        if str(site) in table:
+            sys.exit("error: duplicate log site 0x%04X (%s:%d)" % (site, path, line))
+        table[str(site)] = {
+            "level": call.group(1),
+            "fmt": "".join(parts),
+            "where": "%s:%d" % (path, line),
+        }
+
+
+def cmd_table(sources):
+    table = {}
+    for path in sources:
+        scan_source(path, table)
+    json.dump(table, sys.stdout, indent=1, sort_keys=True)
+    sys.stdout.write("\n")
+    return 0
+
+
+# ==========================================================================
+# Decoder
+# ==========================================================================
+
+def format_record(fmt, payload):
+    """Substitute the raw arguments into fmt, in printf style"""
+    out = []
+    pos = 0
+    last = 0
+    for spec in SPEC_RE.finditer(fmt):
+        out.append(fmt[last:spec.start()])
+        last = spec.end()
+        flags, width, prec, _, conv = spec.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+
+        if conv == "s":
+            n = payload[pos]
+            value = payload[pos + 1:pos + 1 + n].decode("latin-1")
+            pos += 1 + n
+        elif conv in "fFeEgG":
+            value = struct.unpack_from("<f", payload, pos)[0]
+            pos += 4
+        elif conv in "di":
+            value = struct.unpack_from("<i", payload, pos)[0]
+            pos += 4
+        else:
+            value = struct.unpack_from("<I", payload, pos)[0]
+            pos += 4
+
+        pyspec = "%" + flags + width + ("." + prec if prec is not None else "") + conv
+        out.append(pyspec % value)
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode(table, data):
+    lines = []
+    pos = 0
+    while pos + HEADER_LEN <= len(data):
+        length = data[pos]
+        if length < HEADER_LEN or pos + length > len(data):
+            lines.append("<corrupt record at offset %d>" % pos)
+            break
+        site, ts = struct.unpack_from("<HI", data, pos + 1)
+        payload = data[pos + HEADER_LEN:pos + length]
+        pos += length
+
+        stamp = "[%10.6f]" % (ts / 1e6)
+        if site == SITE_DROPPED:
+            lost = struct.unpack_from("<I", payload, 0)[0]
+            lines.append("%s [---] DA7281: <%u record(s) dropped>" % (stamp, lost))
+            continue
+
+        entry = table.get(str(site))
+        if entry is None:
+            lines.append("%s [???] DA7281: <unknown site 0x%04X, %d argument bytes>"
+                         % (stamp, site, len(payload)))
+            continue
+
+        try:
+            text = format_record(entry["fmt"], payload)
+        except (IndexError, struct.error):
+            text = "<argument mismatch: %s>" % entry["fmt"]
+        lines.append("%s [%s] DA7281: %s" % (stamp, LEVEL_TAGS[entry["level"]], text))
+    return lines
+
+
+def cmd_decode(table_path, log_path):
+    with open(table_path, encoding="utf-8") as f:
+        table = json.load(f)
+    with open(log_path, "rb") as f:
+        data = f.read()
+    for line in decode(table, data):
+        print(line)
+    return 0
+
+
+def main(argv):
+    if len(argv) >= 3 and argv[1] == "table":
+        return cmd_table(argv[2:])
+    if len(argv) == 4 and argv[1] == "decode":
+        return cmd_decode(argv[2], argv[3])
+    sys.stderr.write(__doc__)
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""
+DA7281 actuator profile compiler
+
+Turns a table of actuator profiles into a C header of const register
+images (da7281_register_image_t) for da7281_apply_register_image(), so
+firmware ships the LRA register bytes instead of computing them at boot.
+
+Usage:
+  da7281_profiles.py <profiles.csv|profiles.json> [-o da7281_profiles.h]
+
+CSV: one profile per line, '#' comments, header line optional:
+  name,resonant_freq_hz,impedance_ohm,nom_max_v_rms,abs_max_v_peak,max_current_ma
+JSON: a list of objects with the same keys.
+
+The values are computed exactly as da7281_lra_compute() in src/da7281.c
+does it: the float fields are rounded to mohm / mV in single precision,
+then the same integer formulas apply. tests/test_profiles.c checks the
+generated images against da7281_lra_compute().
+
+Author: A. R. Ansari
+Date: 2024-11-21
+"""
+
+import csv
+import json
+import os
+import re
+import struct
+import sys
+
+FIELDS = ["name", "resonant_freq_hz", "impedance_ohm", "nom_max_v_rms",
+          "abs_max_v_peak", "max_current_ma"]
+
+# Datasheet limits checked by da7281_lra_compute()
+LIMITS = {
+    "resonant_freq_hz": (50, 300),
+    "impedance_ohm": (1.0, 50.0),
+    "nom_max_v_rms": (0.5, 6.0),
+    "abs_max_v_peak": (1.0, 12.0),
+    "max_current_ma": (50, 500),
+}
+
+# Integer constants from include/da7281_registers.h
+LRA_PER_HZ_X2 = 1500015
+IMAX_OFFSET_DMA = 286
+IMAX_SCALE_DMA = 72
+V2I_DIVISOR_E4 = 16104
+VMAX_MV_NUM = 5
+VMAX_MV_DEN = 117
+
+REG_LRA_PER_H = 0x0A
+
+
+# ==========================================================================
+# Register math (mirrors src/da7281.c)
+# ==========================================================================
+
+def f32(value):
+    """Round to IEEE-754 single precision"""
+    return struct.unpack("<f", struct.pack("<f", value))[0]
+
+
+def milli(value):
+    """(uint32_t)((value * 1000.0F) + 0.5F), evaluated in single precision"""
+    product = f32(f32(value) * f32(1000.0))
+    return int(f32(product + 0.5))
+
+
+def lra_per_from_hz(freq_hz):
+    lra_per = (LRA_PER_HZ_X2 + freq_hz) // (2 * freq_hz)
+    return max(1, min(lra_per, 0xFFFF))
+
+
+def imax_from_ma(current_ma):
+    current_dma = current_ma * 10
+    bias = IMAX_OFFSET_DMA - IMAX_SCALE_DMA // 2
+    if current_dma < bias:
+        return 0
+    return min((current_dma - bias) // IMAX_SCALE_DMA, 0xFF)
+
+
+def v2i_from_mohm(impedance_mohm, current_ma):
+    den = (IMAX_SCALE_DMA * V2I_DIVISOR_E4) // 2
+    imax_term = current_ma * 10 + 4 * IMAX_SCALE_DMA - IMAX_OFFSET_DMA
+    v2i = (impedance_mohm * imax_term * 5 + den // 2) // den
+    return max(1, min(v2i, 0xFFFF))
+
+
+def vmax_from_mv(voltage_mv):
+    return min((voltage_mv * VMAX_MV_NUM) // VMAX_MV_DEN, 0xFF)
+
+
+def lra_registers(profile):
+    """Register values 0x0A..0x10 (LRA_PER_H .. V2I_FACTOR_L)"""
+    lra_per = lra_per_from_hz(profile["resonant_freq_hz"])
+    imax = imax_from_ma(profile["max_current_ma"])
+    v2i = v2i_from_mohm(milli(profile["impedance_ohm"]), profile["max_current_ma"])
+    nommax = vmax_from_mv(milli(profile["nom_max_v_rms"]))
+    absmax = vmax_from_mv(milli(profile["abs_max_v_peak"]))
+    return [lra_per >> 8, lra_per & 0xFF, nommax, absmax, imax, v2i >> 8, v2i & 0xFF]
+
+
+# ==========================================================================
+# Input
+# ==========================================================================
+
+def parse_profile(raw, where):
+    profile = {"name": str(raw["name"]).strip()}
+    if not re.match(r"^[A-Za-z_][A-Za-z0-9_]*$", profile["name"]):
+        sys.exit("%s: profile name '%s' is not a C identifier" % (where, profile["name"]))
+    for key in FIELDS[1:]:
+        try:
+            value = float(raw[key])
+        except (KeyError, TypeError, ValueError):
+            sys.exit("%s: missing or invalid %s" % (where, key))
+        if key in ("resonant_freq_hz", "max_current_ma"):
+            if value != int(value):
+                sys.exit("%s: %s must be an integer" % (where, key))
+            value = int(value)
+        low, high = LIMITS[key]
+        # Same comparison as DA7281_CHECK_RANGE, in single precision for the float fields
+        checked = value if isinstance(value, int) else f32(value)
+        if checked < low or checked > high:
+            sys.exit("%s: %s = %s outside %s..%s" % (where, key, raw[key], low, high))
+        profile[key] = value
+    return profile
+
+
+def load_profiles(path):
+    profiles = []
+    if path.endswith(".json"):
+        with open(path, encoding="utf-8") as f:
+            rows = json.load(f)
+        for index, raw in enumerate(rows):
+            profiles.append(parse_profile(raw, "%s[%d]" % (path, index)))
+    else:
+        with open(path, encoding="utf-8", newline="") as f:
+            lines = [(n, l) for n, l in enumerate(f, 1) if l.strip() and not l.lstrip().startswith("#")]
+        for (number, row) in zip([n for n, _ in lines], csv.reader([l for _, l in lines])):
+            row = [cell.strip() for cell in row]
+            if row[0] == "name":
+                continue
+            if len(row) != len(FIELDS):
+                sys.exit("%s:%d: expected %d columns" % (path, number, len(FIELDS)))
+            profiles.append(parse_profile(dict(zip(FIELDS, row)), "%s:%d" % (path, number)))
+
+    names = [p["name"] for p in profiles]
+    duplicates = sorted(set(n for n in names if names.count(n) > 1))
+    if duplicates:
+        sys.exit("%s: duplicate profile names: %s" % (path, ", ".join(duplicates)))
+    if not profiles:
+        sys.exit("%s: no profiles" % path)
+    return profiles
+
+
+# ==========================================================================
+# Output
+# ==========================================================================
+
+def emit_header(profiles, source):
+    out = []
+    out.append("/**")
+    out.append(" * @file da7281_profiles.h")
+    out.append(" * @brief DA7281 actuator register images (generated, do not edit)")
+    out.append(" *")
+    out.append(" * Source: %s" % os.path.basename(source))
+    out.append(" * Generator: scripts/da7281_profiles.py")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef DA7281_PROFILES_H")
+    out.append("#define DA7281_PROFILES_H")
+    out.append("")
+    out.append('#include "da7281.h"')
+    out.append("")
+    out.append("/** Number of profiles in da7281_profiles[] */")
+    out.append("#define DA7281_PROFILE_COUNT (%dU)" % len(profiles))
+    for profile in profiles:
+        regs = lra_registers(profile)
+        ident = profile["name"]
+        out.append("")
+        out.append("/* %s: %d Hz, %s ohm, %s V RMS, %s V peak, %d mA */" % (
+            ident, profile["resonant_freq_hz"], repr(profile["impedance_ohm"]),
+            repr(profile["nom_max_v_rms"]), repr(profile["abs_max_v_peak"]),
+            profile["max_current_ma"]))
+        out.append("static const da7281_reg_value_t da7281_profile_%s_regs[] = {" % ident)
+        entries = ["{0x%02XU, 0x%02XU}" % (REG_LRA_PER_H + i, value) for i, value in enumerate(regs)]
+        out.append("    " + ", ".join(entries[:4]) + ",")
+        out.append("    " + ", ".join(entries[4:]))
+        out.append("};")
+        out.append("static const da7281_register_image_t da7281_profile_%s = {" % ident)
+        out.append('    "%s", da7281_profile_%s_regs, %dU' % (ident, ident, len(regs)))
+        out.append("};")
+    out.append("")
+    out.append("/** All profiles, in table order */")
+    out.append("static const da7281_register_image_t *const da7281_profiles[DA7281_PROFILE_COUNT] = {")
+    out.append(",\n".join("    &da7281_profile_%s" % p["name"] for p in profiles))
+    out.append("};")
+    out.append("")
+    out.append("#endif /* DA7281_PROFILES_H */")
+    return "\n".join(out) + "\n"
+
+
+def main(argv):
+    args = argv[1:]
+    output = None
+    if "-o" in args:
+        index = args.index("-o")
+        if index + 1 >= len(args):
+            sys.stderr.write(__doc__)
+            return 2
+        output = args[index + 1]
+        del args[index:index + 2]
+    if len(args) != 1:
+        sys.stderr.write(__doc__)
+        return 2
+
+    header = emit_header(load_profiles(args[0]), args[0])
+    if output is None:
+        sys.stdout.write(header)
+    else:
+        with open(output, "w", encoding="utf-8") as f:
+            f.write(header)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -5,12 +5,139 @@
  * @date 2024-11-21
  */
 
+/** Binary log file number (DA7281_LOG_BACKEND 4) */
+#define DA7281_LOG_FILE_ID (1U)
+
 #include "da7281.h"
-#include "nrf_gpio.h"
-#include "nrf_delay.h"
-#include "FreeRTOS.h"
-#include "task.h"
-#include <math.h>
+#include "da7281_bus.h"
+
+static void da7281_sequence_complete(da7281_device_t *device, da7281_error_t result);
+static bool da7281_seq_halted(da7281_device_t *device);
+
+/* ========================================================================
+ * Readback Verification
+ * ======================================================================== */
+
+/**
+ * @brief Verify a register write according to a policy
+ *
+ * ALWAYS reads the register back now and logs a warning on mismatch (the
+ * write itself succeeded, so the call still returns DA7281_OK). DEFERRED
+ * records the expected bits for da7281_verify_flush(); a second check of
+ * the same register merges into the first. A full queue is flushed first;
+ * if that readback fails the queue stays full and the new check is dropped.
+ *
+ * @param device Pointer to device handle
+ * @param verify Policy
+ * @param reg_addr Register that was written
+ * @param mask Bits to check
+ * @param expected Expected value of the masked bits
+ * @return DA7281_OK, or the result of the flush forced by a full queue
+ */
+static da7281_error_t da7281_verify_write(da7281_device_t *device, da7281_verify_t verify,
+                                          uint8_t reg_addr, uint8_t mask, uint8_t expected)
+{
+    if (verify == DA7281_VERIFY_NEVER) {
+        return DA7281_OK;
+    }
+
+    if (verify == DA7281_VERIFY_DEFERRED) {
+        for (uint8_t i = 0; i < device->verify_count; i++) {
+            da7281_write_entry_t *entry = &device->verify_queue[i];
+            if (entry->reg == reg_addr) {
+                entry->value = (uint8_t)((entry->value & ~mask) | (expected & mask));
+                entry->mask |= mask;
+                return DA7281_OK;
+            }
+        }
+
+        da7281_error_t err = DA7281_OK;
+        if (device->verify_count >= DA7281_VERIFY_QUEUE_DEPTH) {
+            err = da7281_verify_flush(device);
+            if (device->verify_count >= DA7281_VERIFY_QUEUE_DEPTH) {
+                return err;     /* Readback failed, the queue is kept: this check is dropped */
+            }
+        }
+        da7281_write_entry_t *entry = &device->verify_queue[device->verify_count++];
+        entry->reg = reg_addr;
+        entry->mask = mask;
+        entry->value = (uint8_t)(expected & mask);
+        return err;
+    }
+
+    uint8_t value = 0;
+    if ((da7281_read_register(device, reg_addr, &value) == DA7281_OK) &&
+        (((value ^ expected) & mask) != 0U)) {
+        DA7281_LOG_WARNING("Readback mismatch: reg=0x%02X, expected 0x%02X, got 0x%02X (mask 0x%02X)",
+                           reg_addr, expected & mask, value & mask, mask);
+    }
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Read back every deferred check in one burst
+ *
+ * Reads the address range spanned by the queued registers with one
+ * da7281_read_burst() (TOP_CFG1 and TOP_CTL1: 16 bytes, one frame) and
+ * compares the masked bits. The queue is emptied once the read succeeds,
+ * whatever the comparison gives; after a read error it is kept for a retry.
+ *
+ * @param device Pointer to device handle
+ * @return DA7281_OK if every register holds its expected bits or nothing is pending
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_VERIFY_FAILED if at least one register differs
+ * @return DA7281_ERROR_I2C_READ if the readback fails
+ */
+da7281_error_t da7281_verify_flush(da7281_device_t *device)
+{
+    DA7281_CHECK_NULL(device);
+
+    if (device->verify_count == 0U) {
+        return DA7281_OK;
+    }
+
+    uint8_t first = 0xFFU;
+    uint8_t last = 0U;
+    for (uint8_t i = 0; i < device->verify_count; i++) {
+        uint8_t reg = device->verify_queue[i].reg;
+        first = (reg < first) ? reg : first;
+        last = (reg > last) ? reg : last;
+    }
+
+    uint8_t buf[DA7281_I2C_MAX_BURST_LEN];
+    uint16_t span = (uint16_t)(last - first) + 1U;
+    bool one_burst = (span <= DA7281_I2C_MAX_BURST_LEN);
+    da7281_error_t err = DA7281_OK;
+    if (one_burst) {
+        err = da7281_read_burst(device, first, buf, (uint8_t)span);
+        if (err != DA7281_OK) {
+            return err;
+        }
+    }
+
+    uint8_t mismatches = 0U;
+    for (uint8_t i = 0; i < device->verify_count; i++) {
+        const da7281_write_entry_t *entry = &device->verify_queue[i];
+        uint8_t value = 0;
+        if (one_burst) {
+            value = buf[entry->reg - first];
+        } else {
+            err = da7281_read_register(device, entry->reg, &value);
+            if (err != DA7281_OK) {
+                return err;
+            }
+        }
+        if (((value ^ entry->value) & entry->mask) != 0U) {
+            DA7281_LOG_WARNING("Deferred readback mismatch: reg=0x%02X, expected 0x%02X, got 0x%02X",
+                               entry->reg, entry->value, value & entry->mask);
+            mismatches++;
+        }
+    }
+    device->verify_count = 0U;
+
+    return (mismatches == 0U) ? DA7281_OK : DA7281_ERROR_VERIFY_FAILED;
+}
 
 /* ========================================================================
  * Initialization & Control Functions
@@ -49,6 +176,25 @@ da7281_error_t da7281_init(da7281_device_t *device)
 
     DA7281_LOG_INFO("Starting device initialization...");
 
+    /* Bring up the bus once here so register accesses skip any setup work */
+    err = da7281_bus_init(device->twi_instance);
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("Failed to initialize TWI%d", device->twi_instance);
+        return err;
+    }
+
+    /* Register state is unknown until it has been read or written */
+    (void)da7281_cache_invalidate(device);
+    device->verify_count = 0U;
+    device->seq_pending = false;
+    device->seq_callback = NULL;
+    device->seq_context = NULL;
+    device->seq_continue = false;
+    device->playlist_head = 0U;
+    device->playlist_count = 0U;
+    device->irq_handler = NULL;
+    device->irq_context = NULL;
+
     /* Read and verify chip revision */
     err = da7281_read_chip_revision(device, &chip_rev);
     DA7281_LOG_DEBUG("Error code: %d", err);
@@ -88,17 +234,9 @@ da7281_error_t da7281_init(da7281_device_t *device)
         return err;
     }
 
-    /* Verify actuator type was set correctly */
-    uint8_t top_cfg1 = 0;
-    err = da7281_read_register(device, DA7281_REG_TOP_CFG1, &top_cfg1);
-    if (err == DA7281_OK) {
-        uint8_t actuator_type = top_cfg1 & DA7281_TOP_CFG1_ACTUATOR_TYPE;
-        if (actuator_type == DA7281_ACTUATOR_TYPE_LRA) {
-            DA7281_LOG_INFO("Actuator type verified: LRA");
-        } else {
-            DA7281_LOG_WARNING("Actuator type verification failed: expected LRA, got 0x%02X", actuator_type);
-        }
-    }
+    /* Verify actuator type per device->verify */
+    (void)da7281_verify_write(device, device->verify, DA7281_REG_TOP_CFG1,
+                              DA7281_TOP_CFG1_ACTUATOR_TYPE, DA7281_ACTUATOR_TYPE_LRA);
 
     /* Mark initialized before calling set_operation_mode so guard passes.
      * Roll back on failure. */
@@ -138,6 +276,10 @@ da7281_error_t da7281_deinit(da7281_device_t *device)
     /* Disable amplifier */
     (void)da7281_set_amplifier_enable(device, false);
 
+    if (device->irq_handler != NULL) {
+        (void)da7281_irq_configure(device, device->irq_pin, NULL, NULL);
+    }
+
     device->initialized = false;
 
     DA7281_LOG_INFO("Device deinitialized");
@@ -149,42 +291,124 @@ da7281_error_t da7281_deinit(da7281_device_t *device)
  * Configuration Functions
  * ======================================================================== */
 
+/* ========================================================================
+ * LRA Register Math (fixed point)
+ * ======================================================================== */
+
 /**
- * @brief Configure LRA (Linear Resonant Actuator) parameters
+ * @brief LRA_PER for a resonant frequency
  *
- * Calculates and programs all LRA-specific registers based on motor specifications.
- * This function must be called after initialization and before starting haptic playback.
+ * LRA_PER = (1 / f) / 1.33332 us, rounded to nearest:
+ * floor((2 / 1.33332 us + f) / 2f). The constant is truncated to
+ * DA7281_LRA_PER_HZ_X2; its fraction (0.00015) is below 1 and cannot move
+ * the quotient across an integer.
  *
- * Register Calculations (per DA7281 Datasheet v3.1):
+ * @param freq_hz Resonant frequency in Hz
+ * @return LRA_PER, saturated to 1..65535
+ */
+uint16_t da7281_lra_per_from_hz(uint16_t freq_hz)
+{
+    if (freq_hz == 0U) {
+        return UINT16_MAX;
+    }
+
+    uint32_t lra_per = (DA7281_LRA_PER_HZ_X2 + freq_hz) / (2UL * freq_hz);
+    if (lra_per > UINT16_MAX) {
+        lra_per = UINT16_MAX;
+    }
+
+    return (lra_per == 0U) ? 1U : (uint16_t)lra_per;
+}
+
+/**
+ * @brief ACTUATOR_IMAX for a current limit
  *
- * 1. LRA_PER (Period Register):
- *    See datasheet Table 29 for formula
+ * IMAX = (I - 28.6 mA) / 7.2 mA, rounded to nearest, in 0.1 mA units:
+ * (10 I - 286 + 36) / 72.
  *
- * 2. V2I_FACTOR (Voltage-to-Current Factor):
- *    See datasheet Table 34 for formula
+ * @param current_ma Maximum current in mA
+ * @return IMAX, 0 below 28.6 mA, saturated to 255
+ */
+uint8_t da7281_imax_from_ma(uint16_t current_ma)
+{
+    uint32_t current_dma = (uint32_t)current_ma * 10U;
+    uint32_t bias = DA7281_ACTUATOR_IMAX_OFFSET_DMA - (DA7281_ACTUATOR_IMAX_SCALE_DMA / 2U);
+
+    if (current_dma < bias) {
+        return 0U;
+    }
+
+    uint32_t imax = (current_dma - bias) / DA7281_ACTUATOR_IMAX_SCALE_DMA;
+    return (imax > UINT8_MAX) ? UINT8_MAX : (uint8_t)imax;
+}
+
+/**
+ * @brief V2I_FACTOR for an impedance and current limit
  *
- * 3. ACTUATOR_NOMMAX (Nominal Maximum Voltage):
- *    See datasheet Table 31 for formula
+ * V2I_FACTOR = Z * (IMAX + 4) / 1.6104, with the unrounded IMAX, rounded to
+ * nearest. With Z in milliohm and IMAX + 4 = (10 I + 2) / 72 this is
+ * Z * (10 I + 2) * 5 / 579744 (72 * 16104 / 2), exact in 32 bits for
+ * Z <= 50000 mohm and I <= 500 mA.
  *
- * 4. ACTUATOR_ABSMAX (Absolute Maximum Voltage):
- *    See datasheet Table 32 for formula
+ * @param impedance_mohm Actuator impedance in milliohm (1000..50000)
+ * @param current_ma Maximum current in mA (50..500)
+ * @return V2I_FACTOR, saturated to 1..65535
+ */
+uint16_t da7281_v2i_from_mohm(uint32_t impedance_mohm, uint16_t current_ma)
+{
+    const uint32_t den = (DA7281_ACTUATOR_IMAX_SCALE_DMA * DA7281_V2I_FACTOR_DIVISOR_E4) / 2U;
+    uint32_t imax_term = ((uint32_t)current_ma * 10U) + (4U * DA7281_ACTUATOR_IMAX_SCALE_DMA) -
+                         DA7281_ACTUATOR_IMAX_OFFSET_DMA;
+    uint32_t num = impedance_mohm * imax_term * 5U;
+
+    uint32_t v2i = (num + (den / 2U)) / den;
+    if (v2i > UINT16_MAX) {
+        v2i = UINT16_MAX;
+    }
+
+    return (v2i == 0U) ? 1U : (uint16_t)v2i;
+}
+
+/**
+ * @brief ACTUATOR_NOMMAX / ACTUATOR_ABSMAX for a voltage
  *
- * 5. ACTUATOR_IMAX (Maximum Current):
- *    See datasheet Table 33 for formula
+ * Code = V / 23.4 mV, rounded down so the limit never exceeds the request:
+ * mV * 5 / 117.
  *
- * @param device Pointer to initialized device handle
- * @param config Pointer to LRA configuration structure
+ * @param voltage_mv Voltage in mV (RMS for NOMMAX, peak for ABSMAX)
+ * @return Register code, saturated to 255 (5.967 V)
+ */
+uint8_t da7281_vmax_from_mv(uint16_t voltage_mv)
+{
+    uint32_t code = ((uint32_t)voltage_mv * DA7281_ACTUATOR_VMAX_MV_NUM) / DA7281_ACTUATOR_VMAX_MV_DEN;
+    return (code > UINT8_MAX) ? UINT8_MAX : (uint8_t)code;
+}
+
+/**
+ * @brief Convert a float quantity to integer thousandths (mV, mohm), rounded
+ */
+static uint32_t lra_milli(float value)
+{
+    return (uint32_t)((value * 1000.0F) + 0.5F);
+}
+
+/**
+ * @brief Compute the LRA register values for a configuration
+ *
+ * Validates the configuration against the datasheet limits, converts the
+ * float fields to mohm and mV (one rounding each) and runs the integer
+ * conversions above. Touches no device.
+ *
+ * @param config LRA configuration
+ * @param regs Register values
  * @return DA7281_OK on success
- * @return DA7281_ERROR_NULL_POINTER if device or config is NULL
- * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_NULL_POINTER if config or regs is NULL
  * @return DA7281_ERROR_INVALID_PARAM if parameters out of range
- * @return DA7281_ERROR_I2C_WRITE if register write fails
  */
-da7281_error_t da7281_configure_lra(da7281_device_t *device,
-                                     const da7281_lra_config_t *config)
+da7281_error_t da7281_lra_compute(const da7281_lra_config_t *config, da7281_lra_regs_t *regs)
 {
-    DA7281_CHECK_DEVICE(device);
     DA7281_CHECK_NULL(config);
+    DA7281_CHECK_NULL(regs);
 
     /* Validate parameters against datasheet limits */
     DA7281_CHECK_RANGE(config->resonant_freq_hz, 50, 300);
@@ -193,139 +417,273 @@ da7281_error_t da7281_configure_lra(da7281_device_t *device,
     DA7281_CHECK_RANGE(config->abs_max_v_peak, 1.0F, 12.0F);
     DA7281_CHECK_RANGE(config->max_current_ma, 50, 500);
 
-    da7281_error_t err;
-
-    /* ===== 1. Configure LRA Period ===== */
-    /* Calculate period in seconds, then convert to register value */
-    /* DA7281 Datasheet Table 29: LRA_PER = T / (1334.32 × 10^-9) */
-    float period_seconds = 1.0F / (float)config->resonant_freq_hz;
-    float lra_per_float = period_seconds / DA7281_LRA_PER_TIME_SCALE;
-
-    /* Round to nearest integer and clamp to valid 16-bit range (1-65535) */
-    uint16_t lra_per = (uint16_t)roundf(lra_per_float);
-    if (lra_per == 0) {
-        lra_per = 1;  /* Minimum valid value */
-        DA7281_LOG_WARNING("LRA_PER calculated as 0, clamped to 1");
-    }
+    regs->lra_per = da7281_lra_per_from_hz(config->resonant_freq_hz);
+    regs->imax = da7281_imax_from_ma(config->max_current_ma);
+    regs->v2i_factor = da7281_v2i_from_mohm(lra_milli(config->impedance_ohm), config->max_current_ma);
+    regs->nommax = da7281_vmax_from_mv((uint16_t)lra_milli(config->nom_max_v_rms));
+    regs->absmax = da7281_vmax_from_mv((uint16_t)lra_milli(config->abs_max_v_peak));
 
-    DA7281_LOG_DEBUG("LRA period calculation: f=%uHz, T=%.6fs, LRA_PER=0x%04X (rounded from %.2f)",
-                     config->resonant_freq_hz, period_seconds, lra_per, lra_per_float);
+    return DA7281_OK;
+}
 
-    /* Write LRA period (16-bit register, high byte first) */
-    err = da7281_write_register(device, DA7281_REG_LRA_PER_H,
-                                  (uint8_t)(lra_per >> 8));
-    if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Failed to write LRA_PER_H register");
-        return err;
-    }
+/**
+ * @brief Compute and write the LRA registers
+ *
+ * @param device Pointer to initialized device handle
+ * @param config Pointer to LRA configuration structure
+ * @param diff Write only registers that differ from the shadow cache
+ * @param skipped Registers left unwritten in diff mode (may be NULL)
+ * @return DA7281_OK on success, error code otherwise
+ */
+static da7281_error_t da7281_lra_write(da7281_device_t *device,
+                                       const da7281_lra_config_t *config,
+                                       bool diff, uint8_t *skipped)
+{
+    DA7281_CHECK_DEVICE(device);
+    DA7281_CHECK_NULL(config);
 
-    err = da7281_write_register(device, DA7281_REG_LRA_PER_L,
-                                  (uint8_t)(lra_per & 0xFF));
+    da7281_lra_regs_t regs;
+    da7281_error_t err = da7281_lra_compute(config, &regs);
     if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Failed to write LRA_PER_L register");
         return err;
     }
 
-    DA7281_LOG_INFO("LRA period configured: %u Hz -> LRA_PER=0x%04X",
-                    config->resonant_freq_hz, lra_per);
-
-    /* ===== 2. Configure V2I Factor ===== */
-    /* V2I factor converts voltage to current based on actuator impedance */
-    /* DA7281 Datasheet Section 9.4.6: V2I_FACTOR = (Z * (IMAX + 4)) / 1.6104 */
-    /* First calculate IMAX register value for the formula */
-    float imax = ((float)config->max_current_ma - DA7281_ACTUATOR_IMAX_OFFSET) / DA7281_ACTUATOR_IMAX_SCALE;
-    float v2i_float = (config->impedance_ohm * (imax + DA7281_V2I_FACTOR_IMAX_OFFSET)) / DA7281_V2I_FACTOR_DIVISOR;
-
-    /* Round to nearest integer and clamp to valid 16-bit range (1-65535) */
-    uint16_t v2i_factor = (uint16_t)roundf(v2i_float);
-    if (v2i_factor == 0) {
-        v2i_factor = 1;  /* Minimum valid value */
-        DA7281_LOG_WARNING("V2I_FACTOR calculated as 0, clamped to 1");
-    }
-
-    DA7281_LOG_DEBUG("V2I calculation: Z=%.2f ohm, IMAX=%.2f, V2I=0x%04X (rounded from %.2f)",
-                     config->impedance_ohm, imax, v2i_factor, v2i_float);
+    /* ===== Program LRA_PER_H .. V2I_FACTOR_L (0x0A-0x10) in one burst ===== */
+    /* 16-bit registers are high byte first */
+    const uint8_t lra_regs[DA7281_REG_V2I_FACTOR_L - DA7281_REG_LRA_PER_H + 1U] = {
+        (uint8_t)(regs.lra_per >> 8),       /* 0x0A LRA_PER_H */
+        (uint8_t)(regs.lra_per & 0xFF),     /* 0x0B LRA_PER_L */
+        regs.nommax,                        /* 0x0C ACTUATOR_NOMMAX */
+        regs.absmax,                        /* 0x0D ACTUATOR_ABSMAX */
+        regs.imax,                          /* 0x0E ACTUATOR_IMAX */
+        (uint8_t)(regs.v2i_factor >> 8),    /* 0x0F V2I_FACTOR_H */
+        (uint8_t)(regs.v2i_factor & 0xFF)   /* 0x10 V2I_FACTOR_L */
+    };
 
-    /* Write V2I factor (16-bit register, high byte first) */
-    err = da7281_write_register(device, DA7281_REG_V2I_FACTOR_H,
-                                  (uint8_t)(v2i_factor >> 8));
-    if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Failed to write V2I_FACTOR_H register");
-        return err;
+    if (diff) {
+        err = da7281_write_burst_diff(device, DA7281_REG_LRA_PER_H, lra_regs, sizeof(lra_regs), skipped);
+    } else {
+        err = da7281_write_burst(device, DA7281_REG_LRA_PER_H, lra_regs, sizeof(lra_regs));
     }
-
-    err = da7281_write_register(device, DA7281_REG_V2I_FACTOR_L,
-                                  (uint8_t)(v2i_factor & 0xFF));
     if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Failed to write V2I_FACTOR_L register");
+        DA7281_LOG_ERROR("Failed to write LRA registers 0x%02X-0x%02X",
+                         DA7281_REG_LRA_PER_H, DA7281_REG_V2I_FACTOR_L);
         return err;
     }
 
+    DA7281_LOG_INFO("LRA period configured: %u Hz -> LRA_PER=0x%04X",
+                    config->resonant_freq_hz, regs.lra_per);
     DA7281_LOG_INFO("V2I factor configured: %.2f ohm -> V2I=0x%04X",
-                    config->impedance_ohm, v2i_factor);
+                    config->impedance_ohm, regs.v2i_factor);
+    DA7281_LOG_INFO("Nominal max voltage: %.2f V RMS -> NOMMAX=0x%02X",
+                    config->nom_max_v_rms, regs.nommax);
+    DA7281_LOG_INFO("Absolute max voltage: %.2f V peak -> ABSMAX=0x%02X",
+                    config->abs_max_v_peak, regs.absmax);
+    DA7281_LOG_INFO("Max current: %u mA -> IMAX=0x%02X",
+                    config->max_current_ma, regs.imax);
 
-    /* ===== 3. Configure Nominal Maximum Voltage ===== */
-    /* This is the normal operating voltage (RMS) */
-    uint8_t nommax = (uint8_t)((config->nom_max_v_rms * 1000.0F) /
-                                DA7281_ACTUATOR_NOMMAX_SCALE);
+    DA7281_LOG_INFO("LRA configuration complete - all parameters programmed successfully");
 
-    DA7281_LOG_DEBUG("NOMMAX calculation: V_rms=%.2fV, NOMMAX=0x%02X",
-                     config->nom_max_v_rms, nommax);
+    return DA7281_OK;
+}
 
-    err = da7281_write_register(device, DA7281_REG_ACTUATOR_NOMMAX, nommax);
-    if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Failed to write ACTUATOR_NOMMAX register");
-        return err;
-    }
+/**
+ * @brief Configure LRA (Linear Resonant Actuator) parameters
+ *
+ * Calculates and programs all LRA-specific registers based on motor specifications.
+ * This function must be called after initialization and before starting haptic playback.
+ *
+ * Register Calculations (per DA7281 Datasheet v3.1), in integer arithmetic
+ * (see da7281_lra_compute()):
+ *
+ * 1. LRA_PER (Period Register):
+ *    See datasheet Table 29 for formula
+ *
+ * 2. V2I_FACTOR (Voltage-to-Current Factor):
+ *    See datasheet Table 34 for formula
+ *
+ * 3. ACTUATOR_NOMMAX (Nominal Maximum Voltage):
+ *    See datasheet Table 31 for formula
+ *
+ * 4. ACTUATOR_ABSMAX (Absolute Maximum Voltage):
+ *    See datasheet Table 32 for formula
+ *
+ * 5. ACTUATOR_IMAX (Maximum Current):
+ *    See datasheet Table 33 for formula
+ *
+ * @param device Pointer to initialized device handle
+ * @param config Pointer to LRA configuration structure
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device or config is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if parameters out of range
+ * @return DA7281_ERROR_I2C_WRITE if register write fails
+ *
+ * @note All seven registers (0x0A-0x10) are contiguous and are written with
+ *       a single auto-increment burst (one I2C transaction).
+ */
+da7281_error_t da7281_configure_lra(da7281_device_t *device,
+                                     const da7281_lra_config_t *config)
+{
+    return da7281_lra_write(device, config, false, NULL);
+}
 
-    DA7281_LOG_INFO("Nominal max voltage: %.2f V RMS -> NOMMAX=0x%02X",
-                    config->nom_max_v_rms, nommax);
+/**
+ * @brief Configure LRA parameters, writing only registers that change
+ *
+ * Computes the same seven registers as da7281_configure_lra() and hands
+ * them to da7281_write_burst_diff(): registers whose shadow copy already
+ * holds the new value are skipped, the rest go out in as few bursts as
+ * possible. Re-applying the active configuration costs no bus traffic;
+ * switching between two actuators costs only the bytes that differ.
+ *
+ * @param device Pointer to initialized device handle (with device->cache)
+ * @param config Pointer to LRA configuration structure
+ * @param skipped Receives the number of registers not written (may be NULL)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device or config is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if parameters out of range
+ * @return DA7281_ERROR_I2C_WRITE if register write fails
+ */
+da7281_error_t da7281_configure_lra_diff(da7281_device_t *device,
+                                          const da7281_lra_config_t *config,
+                                          uint8_t *skipped)
+{
+    return da7281_lra_write(device, config, true, skipped);
+}
 
-    /* ===== 4. Configure Absolute Maximum Voltage ===== */
-    /* This is the peak voltage limit for protection */
-    uint8_t absmax = (uint8_t)((config->abs_max_v_peak * 1000.0F) /
-                                DA7281_ACTUATOR_ABSMAX_SCALE);
+/**
+ * @brief Validate a register image and write it run by run
+ *
+ * @param device Pointer to initialized device handle
+ * @param image Register image
+ * @param diff Write only entries that differ from the shadow cache
+ * @param skipped Entries left unwritten in diff mode (may be NULL)
+ * @return DA7281_OK on success, error code otherwise
+ */
+static da7281_error_t da7281_image_write(da7281_device_t *device,
+                                         const da7281_register_image_t *image,
+                                         bool diff, uint8_t *skipped)
+{
+    DA7281_CHECK_DEVICE(device);
+    DA7281_CHECK_NULL(image);
+    DA7281_CHECK_NULL(image->regs);
 
-    DA7281_LOG_DEBUG("ABSMAX calculation: V_peak=%.2fV, ABSMAX=0x%02X",
-                     config->abs_max_v_peak, absmax);
+    if (image->count == 0U) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
 
-    err = da7281_write_register(device, DA7281_REG_ACTUATOR_ABSMAX, absmax);
-    if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Failed to write ACTUATOR_ABSMAX register");
-        return err;
+    /* Validate everything before the first write; count the runs */
+    uint8_t runs = 1U;
+    for (uint8_t i = 0; i < image->count; i++) {
+        if ((da7281_reg_attr(image->regs[i].reg) & DA7281_REG_ATTR_READ_ONLY) != 0U) {
+            return DA7281_ERROR_INVALID_PARAM;
+        }
+        if (i > 0U) {
+            if (image->regs[i].reg <= image->regs[i - 1U].reg) {
+                return DA7281_ERROR_INVALID_PARAM;
+            }
+            if (image->regs[i].reg != (uint8_t)(image->regs[i - 1U].reg + 1U)) {
+                runs++;
+            }
+        }
     }
 
-    DA7281_LOG_INFO("Absolute max voltage: %.2f V peak -> ABSMAX=0x%02X",
-                    config->abs_max_v_peak, absmax);
+    da7281_error_t err = DA7281_OK;
+    if (runs > 1U) {
+        err = da7281_bus_begin(device->twi_instance);
+        if (err != DA7281_OK) {
+            return err;
+        }
+    }
 
-    /* ===== 5. Configure Maximum Current ===== */
-    /* Current limit for actuator protection */
-    /* DA7281 Datasheet: IMAX = (I_mA - 28.6) / 7.2 */
-    float imax_float = ((float)config->max_current_ma - DA7281_ACTUATOR_IMAX_OFFSET) /
-                       DA7281_ACTUATOR_IMAX_SCALE;
-    uint8_t imax = (uint8_t)roundf(imax_float);
-    if (imax_float < 0) {
-        imax = 0;
-        DA7281_LOG_WARNING("IMAX calculated as negative, clamped to 0");
+    uint8_t buf[DA7281_I2C_MAX_BURST_LEN];
+    uint8_t unchanged = 0U;
+    uint8_t i = 0;
+    while ((i < image->count) && (err == DA7281_OK)) {
+        uint8_t start_reg = image->regs[i].reg;
+        uint8_t len = 0;
+        do {
+            buf[len++] = image->regs[i++].value;
+        } while ((i < image->count) && (len < DA7281_I2C_MAX_BURST_LEN) &&
+                 (image->regs[i].reg == (uint8_t)(start_reg + len)));
+
+        if (diff) {
+            uint8_t run_skipped = 0U;
+            err = da7281_write_burst_diff(device, start_reg, buf, len, &run_skipped);
+            unchanged = (uint8_t)(unchanged + run_skipped);
+        } else {
+            err = da7281_write_burst(device, start_reg, buf, len);
+        }
     }
 
-    DA7281_LOG_DEBUG("IMAX calculation: I=%umA, IMAX=0x%02X (rounded from %.2f)",
-                     config->max_current_ma, imax, imax_float);
+    if (runs > 1U) {
+        da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+        if (err == DA7281_OK) {
+            err = end_err;
+        }
+    }
 
-    err = da7281_write_register(device, DA7281_REG_ACTUATOR_IMAX, imax);
     if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Failed to write ACTUATOR_IMAX register");
+        DA7281_LOG_ERROR("Failed to apply register image %s", (image->name != NULL) ? image->name : "?");
         return err;
     }
 
-    DA7281_LOG_INFO("Max current: %u mA -> IMAX=0x%02X",
-                    config->max_current_ma, imax);
+    if (skipped != NULL) {
+        *skipped = unchanged;
+    }
 
-    DA7281_LOG_INFO("LRA configuration complete - all parameters programmed successfully");
+    DA7281_LOG_DEBUG("Register image %s applied: %u registers, %u unchanged",
+                     (image->name != NULL) ? image->name : "?", image->count, unchanged);
 
     return DA7281_OK;
 }
 
+/**
+ * @brief Write a precomputed register image
+ *
+ * Entries with consecutive addresses are written as one auto-increment
+ * burst (split only at DA7281_I2C_MAX_BURST_LEN), so an image costs one
+ * I2C transaction per contiguous run. Several runs share one bus lock.
+ *
+ * @param device Pointer to initialized device handle
+ * @param image Register image (ascending addresses, no read-only registers)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device, image or its entries are NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if the image is empty, unsorted or writes a read-only register
+ * @return DA7281_ERROR_I2C_WRITE if a burst fails
+ */
+da7281_error_t da7281_apply_register_image(da7281_device_t *device,
+                                           const da7281_register_image_t *image)
+{
+    return da7281_image_write(device, image, false, NULL);
+}
+
+/**
+ * @brief Write the entries of a register image that differ from the shadow cache
+ *
+ * Same validation as da7281_apply_register_image(); each contiguous run
+ * goes through da7281_write_burst_diff(). Switching a device between two
+ * profiles that share most bytes writes only the bytes that differ.
+ *
+ * @param device Pointer to initialized device handle (with device->cache)
+ * @param image Register image (ascending addresses, no read-only registers)
+ * @param skipped Receives the number of entries not written (may be NULL)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device, image or its entries are NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if the image is empty, unsorted or writes a read-only register
+ * @return DA7281_ERROR_I2C_WRITE if a burst fails
+ */
+da7281_error_t da7281_apply_register_image_diff(da7281_device_t *device,
+                                                const da7281_register_image_t *image,
+                                                uint8_t *skipped)
+{
+    return da7281_image_write(device, image, true, skipped);
+}
+
 /**
  * @brief Set operation mode
  *
@@ -339,6 +697,9 @@ da7281_error_t da7281_configure_lra(da7281_device_t *device,
  *
  * Note: Always return to INACTIVE mode before changing to a different mode.
  *
+ * TOP_CTL1 is read back according to device->verify, see
+ * da7281_set_operation_mode_policy().
+ *
  * @param device Pointer to initialized device handle
  * @param mode Desired operation mode (0-5)
  * @return DA7281_OK on success
@@ -350,15 +711,44 @@ da7281_error_t da7281_configure_lra(da7281_device_t *device,
 da7281_error_t da7281_set_operation_mode(da7281_device_t *device,
                                           da7281_operation_mode_t mode)
 {
-    DA7281_CHECK_DEVICE(device);
-    DA7281_CHECK_RANGE(mode, DA7281_MODE_INACTIVE, DA7281_MODE_STANDBY);
+    DA7281_CHECK_NULL(device);
 
-    const char *mode_names[] = {
-        "INACTIVE", "DRO", "PWM", "RTWM", "ETWM", "STANDBY"
-    };
+    return da7281_set_operation_mode_policy(device, mode, device->verify);
+}
 
-    DA7281_LOG_DEBUG("Changing operation mode from %s to %s",
-                     mode_names[device->mode], mode_names[mode]);
+/**
+ * @brief Set operation mode with an explicit verify policy
+ *
+ * TOP_CTL1 costs one write with DA7281_VERIFY_NEVER (plus the RMW read
+ * when no shadow cache is attached), a second transaction with ALWAYS,
+ * and its share of one burst read in da7281_verify_flush() with DEFERRED.
+ * Any mode other than ETWM stops the sequencer: a pending
+ * da7281_play_sequence() completes with DA7281_ERROR_ABORTED.
+ *
+ * @param device Pointer to initialized device handle
+ * @param mode Desired operation mode
+ * @param verify Readback policy for this call (device->verify is not changed)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if mode or verify is invalid
+ * @return DA7281_ERROR_I2C_WRITE if write fails
+ */
+da7281_error_t da7281_set_operation_mode_policy(da7281_device_t *device,
+                                                 da7281_operation_mode_t mode,
+                                                 da7281_verify_t verify)
+{
+    DA7281_CHECK_DEVICE(device);
+    DA7281_CHECK_RANGE(mode, DA7281_MODE_INACTIVE, DA7281_MODE_STANDBY);
+    DA7281_CHECK_RANGE(verify, DA7281_VERIFY_ALWAYS, DA7281_VERIFY_NEVER);
+
+    const char *mode_names[] = {
+        "INACTIVE", "DRO", "PWM", "RTWM", "ETWM", "?", "STANDBY"
+    };
+    (void)mode_names;  /* Only referenced by log messages */
+
+    DA7281_LOG_DEBUG("Changing operation mode from %s to %s",
+                     mode_names[device->mode], mode_names[mode]);
 
     /* OP_MODE is bits [2:0] of TOP_CTL1 */
     uint8_t mode_value = ((uint8_t)mode << DA7281_TOP_CTL1_OP_MODE_SHIFT) & DA7281_TOP_CTL1_OP_MODE_MASK;
@@ -372,18 +762,17 @@ da7281_error_t da7281_set_operation_mode(da7281_device_t *device,
         return err;
     }
 
-    /* Verify mode was set correctly */
-    uint8_t top_ctl1 = 0;
-    err = da7281_read_register(device, DA7281_REG_TOP_CTL1, &top_ctl1);
-    if (err == DA7281_OK) {
-        uint8_t actual_mode = (top_ctl1 & DA7281_TOP_CTL1_OP_MODE_MASK) >> DA7281_TOP_CTL1_OP_MODE_SHIFT;
-        if (actual_mode != (uint8_t)mode) {
-            DA7281_LOG_WARNING("Operation mode verification failed: expected %d, got %d",
-                               mode, actual_mode);
-        }
-    }
-
     device->mode = mode;
+    bool aborted = (mode != DA7281_MODE_ETWM) && da7281_seq_halted(device);
+
+    err = da7281_verify_write(device, verify, DA7281_REG_TOP_CTL1,
+                              DA7281_TOP_CTL1_OP_MODE_MASK, mode_value);
+    if (aborted) {
+        da7281_sequence_complete(device, DA7281_ERROR_ABORTED);
+    }
+    if (err != DA7281_OK) {
+        return err;
+    }
 
     DA7281_LOG_INFO("Operation mode set to: %s (%d)", mode_names[mode], mode);
 
@@ -392,6 +781,8 @@ da7281_error_t da7281_set_operation_mode(da7281_device_t *device,
 
 /**
  * @brief Get current operation mode
+ *
+ * Served from the shadow cache without bus access when one is attached.
  */
 da7281_error_t da7281_get_operation_mode(da7281_device_t *device,
                                           da7281_operation_mode_t *mode)
@@ -400,8 +791,8 @@ da7281_error_t da7281_get_operation_mode(da7281_device_t *device,
     DA7281_CHECK_NULL(mode);
 
     uint8_t reg_value = 0;
-    da7281_error_t err = da7281_read_register(device, DA7281_REG_TOP_CTL1,
-                                                &reg_value);
+    da7281_error_t err = da7281_read_register_cached(device, DA7281_REG_TOP_CTL1,
+                                                       &reg_value);
     if (err != DA7281_OK) {
         return err;
     }
@@ -438,6 +829,40 @@ da7281_error_t da7281_set_override_amplitude(da7281_device_t *device,
     return DA7281_OK;
 }
 
+/**
+ * @brief Set override amplitudes on several devices together
+ *
+ * A loop over da7281_set_override_amplitude() makes the last device lag
+ * by one lock plus one transaction per device in front of it. This writes
+ * TOP_CTL2 through da7281_write_register_multi() instead: one lock per
+ * bus, writes chained with repeated STARTs, both buses in parallel.
+ *
+ * @param devices Device handles (any mix of TWI0 and TWI1)
+ * @param amplitudes amplitudes[i] is applied to devices[i]
+ * @param count Number of devices
+ * @return DA7281_OK on success, error code otherwise
+ */
+da7281_error_t da7281_set_override_amplitude_multi(da7281_device_t *const devices[],
+                                                     const uint8_t amplitudes[],
+                                                     uint8_t count)
+{
+    DA7281_CHECK_NULL(devices);
+
+    for (uint8_t i = 0; i < count; i++) {
+        DA7281_CHECK_DEVICE(devices[i]);
+    }
+
+    da7281_error_t err = da7281_write_register_multi(devices, DA7281_REG_TOP_CTL2,
+                                                     amplitudes, count);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    DA7281_LOG_DEBUG("Override amplitude set on %u devices", count);
+
+    return DA7281_OK;
+}
+
 /**
  * @brief Enable/disable amplifier
  */
@@ -461,6 +886,1264 @@ da7281_error_t da7281_set_amplifier_enable(da7281_device_t *device,
     return DA7281_OK;
 }
 
+/**
+ * @brief Shadow copy of a register, when the cache holds a valid one
+ *
+ * @param device Pointer to device handle
+ * @param reg_addr Register address
+ * @param value Receives the shadow value
+ * @return true if value was set (no bus access either way)
+ */
+static bool da7281_shadow(const da7281_device_t *device, uint8_t reg_addr, uint8_t *value)
+{
+    const da7281_reg_cache_t *cache = device->cache;
+    if ((cache == NULL) || (reg_addr >= DA7281_REG_CACHE_SIZE) ||
+        ((cache->valid[reg_addr / 8U] & (1U << (reg_addr % 8U))) == 0U)) {
+        return false;
+    }
+
+    *value = cache->value[reg_addr];
+    return true;
+}
+
+/**
+ * @brief End a pending da7281_play_sequence() and run its callback
+ *
+ * Called outside the bus session, so the callback may start the next
+ * sequence. Sequences still queued are dropped. No-op when nothing is
+ * pending.
+ *
+ * @param device Pointer to device handle
+ * @param result DA7281_OK (SEQ_DONE) or DA7281_ERROR_ABORTED
+ */
+static void da7281_sequence_complete(da7281_device_t *device, da7281_error_t result)
+{
+    if (!device->seq_pending) {
+        return;
+    }
+
+    da7281_xfer_cb_t callback = device->seq_callback;
+    void *context = device->seq_context;
+    device->seq_pending = false;
+    device->seq_callback = NULL;
+    device->seq_context = NULL;
+    device->playlist_head = 0U;
+    device->playlist_count = 0U;
+
+    DA7281_LOG_DEBUG("Sequence done: addr=0x%02X, result=%d", device->i2c_address, result);
+    if (callback != NULL) {
+        callback(device, result, context);
+    }
+}
+
+/**
+ * @brief Set or clear SEQ_CTL1.SEQ_CONTINUE if it differs from the last write
+ *
+ * @param device Pointer to device handle
+ * @param on New state
+ * @return DA7281_OK on success, bus error otherwise
+ */
+static da7281_error_t da7281_seq_set_continue(da7281_device_t *device, bool on)
+{
+    if (device->seq_continue == on) {
+        return DA7281_OK;
+    }
+
+    da7281_error_t err = da7281_modify_register(device, DA7281_REG_SEQ_CTL1, DA7281_SEQ_CTL1_SEQ_CONTINUE,
+                                                on ? DA7281_SEQ_CTL1_SEQ_CONTINUE : 0U);
+    if (err == DA7281_OK) {
+        device->seq_continue = on;
+    }
+    return err;
+}
+
+/**
+ * @brief Clean up after TOP_CTL1 left ETWM with a sequence pending
+ *
+ * The sequencer stops with the mode change and no SEQ_DONE follows.
+ * SEQ_CONTINUE is cleared so queued sequences cannot chain when ETWM is
+ * entered again (a failed clear is redone by the next
+ * da7281_play_sequence()). The caller then completes the sequence with
+ * DA7281_ERROR_ABORTED, outside its bus session.
+ *
+ * @param device Pointer to device handle
+ * @return true if a sequence was pending
+ */
+static bool da7281_seq_halted(da7281_device_t *device)
+{
+    if (!device->seq_pending) {
+        return false;
+    }
+
+    (void)da7281_seq_set_continue(device, false);
+    return true;
+}
+
+/**
+ * @brief Select the sequence the sequencer starts next (SEQ_CTL2)
+ *
+ * Skipped when the shadow cache shows the same ID and loop count.
+ *
+ * @param device Pointer to device handle
+ * @param seq_id Sequence ID (0-15)
+ * @param loops Repeats after the first play (0-15)
+ * @return DA7281_OK on success, bus error otherwise
+ */
+static da7281_error_t da7281_seq_select(da7281_device_t *device, uint8_t seq_id, uint8_t loops)
+{
+    const uint8_t seq_ctl2 = (uint8_t)(((uint8_t)(loops << DA7281_SEQ_CTL2_PS_SEQ_LOOP_SHIFT) &
+                                        DA7281_SEQ_CTL2_PS_SEQ_LOOP_MASK) |
+                                       (seq_id & DA7281_SEQ_CTL2_PS_SEQ_ID_MASK));
+    return da7281_write_burst_diff(device, DA7281_REG_SEQ_CTL2, &seq_ctl2, 1U, NULL);
+}
+
+/**
+ * @brief Common first steps of the playback fast paths
+ *
+ * Reads TOP_CFG1 and TOP_CTL1 through the shadow cache, leaves any other
+ * active mode or STANDBY for INACTIVE (datasheet mode-change rule) and
+ * sets TOP_CFG1.AMP_EN if it is off. Runs inside the caller's bus session.
+ *
+ * @param device Pointer to device handle
+ * @param op_mode Mode about to be entered (DA7281_OP_MODE_*)
+ * @param top_ctl1 Receives TOP_CTL1 with OP_MODE and SEQ_START cleared
+ * @param mode Receives the mode the chip is in now (op_mode or INACTIVE)
+ * @param aborted Set when a pending sequence was stopped (da7281_seq_halted())
+ * @return DA7281_OK on success, bus error otherwise
+ */
+static da7281_error_t da7281_playback_enter(da7281_device_t *device, uint8_t op_mode,
+                                            uint8_t *top_ctl1, uint8_t *mode, bool *aborted)
+{
+    uint8_t top_cfg1 = 0;
+    uint8_t ctl1 = 0;
+    da7281_error_t err = da7281_read_register_cached(device, DA7281_REG_TOP_CFG1, &top_cfg1);
+    if (err == DA7281_OK) {
+        err = da7281_read_register_cached(device, DA7281_REG_TOP_CTL1, &ctl1);
+    }
+    *mode = ctl1 & DA7281_TOP_CTL1_OP_MODE_MASK;
+    *top_ctl1 = ctl1 & (uint8_t)~(DA7281_TOP_CTL1_OP_MODE_MASK | DA7281_TOP_CTL1_SEQ_START);
+
+    if ((err == DA7281_OK) && (*mode != DA7281_OP_MODE_INACTIVE) && (*mode != op_mode)) {
+        err = da7281_write_register(device, DA7281_REG_TOP_CTL1, *top_ctl1 | DA7281_OP_MODE_INACTIVE);
+        *mode = DA7281_OP_MODE_INACTIVE;
+        *aborted = (err == DA7281_OK) && da7281_seq_halted(device);
+    }
+
+    if ((err == DA7281_OK) && ((top_cfg1 & DA7281_TOP_CFG1_AMP_EN) == 0U)) {
+        err = da7281_write_register(device, DA7281_REG_TOP_CFG1, top_cfg1 | DA7281_TOP_CFG1_AMP_EN);
+    }
+
+    return err;
+}
+
+/**
+ * @brief Start (or retune) a DRO vibration
+ *
+ * Goes from any state to DRO at the given amplitude with the fewest
+ * writes, all in one bus session, reading state through the shadow cache:
+ *
+ * 1. PWM, RTWM, ETWM or STANDBY: TOP_CTL1 to INACTIVE first (datasheet
+ *    mode-change rule). A pending da7281_play_sequence() completes with
+ *    DA7281_ERROR_ABORTED.
+ * 2. TOP_CFG1.AMP_EN, only if it is off.
+ * 3. Already in DRO: TOP_CTL2 only, skipped if unchanged. Otherwise
+ *    TOP_CTL1 = DRO and TOP_CTL2 = amplitude as one burst (0x22-0x23),
+ *    when the old TOP_CTL2 is known to be 0 or equal; the mode byte
+ *    latches first, so an unknown or other stale amplitude is written
+ *    alone before the mode instead.
+ *
+ * Cost with a warm cache and DA7281_VERIFY_NEVER/DEFERRED, from stopped
+ * (da7281_stop()): one 4-byte frame, amplitude reached ~93 µs after the
+ * call at 400 kHz; while playing, one 3-byte frame per amplitude change.
+ * DA7281_VERIFY_ALWAYS adds one TOP_CTL1 read after the drive has
+ * started. The separate mode, amplifier and amplitude calls (default
+ * policy) cost six frames, five with a cache, and reach the amplitude
+ * after ~410 µs. Without a cache the three state reads come first
+ * (four frames, ~340 µs).
+ *
+ * @param device Pointer to initialized device handle
+ * @param amplitude TOP_CTL2 override value
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_I2C_READ/WRITE on communication failure
+ */
+da7281_error_t da7281_play_dro(da7281_device_t *device, uint8_t amplitude)
+{
+    DA7281_CHECK_DEVICE(device);
+
+    da7281_error_t err = da7281_bus_begin(device->twi_instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    uint8_t top_ctl1 = 0;
+    uint8_t top_ctl2 = 0;
+    uint8_t mode = 0;
+    bool aborted = false;
+    err = da7281_playback_enter(device, DA7281_OP_MODE_DRO, &top_ctl1, &mode, &aborted);
+
+    bool known = da7281_shadow(device, DA7281_REG_TOP_CTL2, &top_ctl2);
+    if ((err == DA7281_OK) && (mode == DA7281_OP_MODE_DRO)) {
+        if (!known || (top_ctl2 != amplitude)) {
+            err = da7281_write_register(device, DA7281_REG_TOP_CTL2, amplitude);
+        }
+    } else if (err == DA7281_OK) {
+        const uint8_t ctl[2] = {(uint8_t)(top_ctl1 | DA7281_OP_MODE_DRO), amplitude};
+        if (known && ((top_ctl2 == 0U) || (top_ctl2 == amplitude))) {
+            err = da7281_write_burst(device, DA7281_REG_TOP_CTL1, ctl, sizeof(ctl));
+        } else {
+            err = da7281_write_register(device, DA7281_REG_TOP_CTL2, amplitude);
+            if (err == DA7281_OK) {
+                err = da7281_write_register(device, DA7281_REG_TOP_CTL1, ctl[0]);
+            }
+        }
+        if (err == DA7281_OK) {
+            err = da7281_verify_write(device, device->verify, DA7281_REG_TOP_CTL1,
+                                      DA7281_TOP_CTL1_OP_MODE_MASK, DA7281_OP_MODE_DRO);
+        }
+    }
+
+    da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+    if (err == DA7281_OK) {
+        err = end_err;
+    }
+    if (aborted) {
+        da7281_sequence_complete(device, DA7281_ERROR_ABORTED);
+    }
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("DRO play failed: addr=0x%02X, err=%d", device->i2c_address, err);
+        return err;
+    }
+
+    device->mode = DA7281_MODE_DRO;
+    DA7281_LOG_DEBUG("DRO play: addr=0x%02X, amplitude=%u", device->i2c_address, amplitude);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Stop any playback
+ *
+ * From DRO, PWM, RTWM or ETWM: TOP_CTL1 = INACTIVE (SEQ_START cleared) and
+ * TOP_CTL2 = 0 in one burst, mode first. INACTIVE and STANDBY need no
+ * write. AMP_EN stays set so the next da7281_play_dro() is a single frame;
+ * da7281_deinit() and da7281_set_amplifier_enable() turn it off. A pending
+ * da7281_play_sequence() completes with DA7281_ERROR_ABORTED.
+ *
+ * Cost with a warm cache and DA7281_VERIFY_NEVER/DEFERRED: one 4-byte
+ * frame, drive ends ~93 µs after the call at 400 kHz.
+ *
+ * @param device Pointer to initialized device handle
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_I2C_READ/WRITE on communication failure
+ */
+da7281_error_t da7281_stop(da7281_device_t *device)
+{
+    DA7281_CHECK_DEVICE(device);
+
+    da7281_error_t err = da7281_bus_begin(device->twi_instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    uint8_t top_ctl1 = 0;
+    err = da7281_read_register_cached(device, DA7281_REG_TOP_CTL1, &top_ctl1);
+    uint8_t mode = top_ctl1 & DA7281_TOP_CTL1_OP_MODE_MASK;
+    bool playing = (mode != DA7281_OP_MODE_INACTIVE) && (mode != DA7281_OP_MODE_STANDBY);
+
+    if ((err == DA7281_OK) && playing) {
+        const uint8_t ctl[2] = {
+            (uint8_t)((top_ctl1 & (uint8_t)~(DA7281_TOP_CTL1_OP_MODE_MASK | DA7281_TOP_CTL1_SEQ_START)) |
+                      DA7281_OP_MODE_INACTIVE),
+            0U
+        };
+        err = da7281_write_burst(device, DA7281_REG_TOP_CTL1, ctl, sizeof(ctl));
+        if (err == DA7281_OK) {
+            (void)da7281_seq_halted(device);
+            err = da7281_verify_write(device, device->verify, DA7281_REG_TOP_CTL1,
+                                      DA7281_TOP_CTL1_OP_MODE_MASK, DA7281_OP_MODE_INACTIVE);
+        }
+    }
+
+    da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+    if (err == DA7281_OK) {
+        err = end_err;
+    }
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("Stop failed: addr=0x%02X, err=%d", device->i2c_address, err);
+        return err;
+    }
+
+    if (playing) {
+        device->mode = DA7281_MODE_INACTIVE;
+    }
+    DA7281_LOG_DEBUG("Stopped: addr=0x%02X", device->i2c_address);
+    da7281_sequence_complete(device, DA7281_ERROR_ABORTED);
+
+    return DA7281_OK;
+}
+
+/* ========================================================================
+ * Sequence Playback (ETWM)
+ * ======================================================================== */
+
+/**
+ * @brief Play a stored sequence and return; completion arrives as SEQ_DONE
+ *
+ * In one bus session, reading state through the shadow cache:
+ *
+ * 1. Leave any other active mode for INACTIVE and set AMP_EN if it is off
+ *    (as da7281_play_dro()).
+ * 2. SEQ_CTL2 = loops << 4 | seq_id, skipped if the cache holds it;
+ *    SEQ_CTL1.SEQ_CONTINUE set if sequences are queued
+ *    (da7281_queue_sequence()), cleared if left set, otherwise untouched.
+ * 3. TOP_CTL1 = ETWM | SEQ_START, which starts playback.
+ *
+ * Nothing else touches the bus until the chip latches E_SEQ_DONE and
+ * asserts nIRQ; da7281_handle_events() then reads the event block, clears
+ * it and runs the callback. Replaying a 500 ms effect with a warm cache
+ * costs one frame to start and two to finish, and no task waits on it. A
+ * new sequence ID or loop count adds one frame; entering ETWM from another
+ * mode adds the TOP_CTL1 readback of DA7281_VERIFY_ALWAYS.
+ *
+ * The callback is registered before TOP_CTL1 is written, so an event
+ * handler racing the start still finds it.
+ *
+ * @param device Pointer to initialized device handle
+ * @param seq_id Sequence ID (0-15)
+ * @param loops Repeats after the first play (0-15)
+ * @param callback Completion callback (may be NULL: poll seq_pending)
+ * @param context User pointer passed to the callback
+ * @return DA7281_OK once playback has started
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if seq_id or loops is above 15
+ * @return DA7281_ERROR_BUSY if the previous sequence has not completed
+ * @return DA7281_ERROR_I2C_READ/WRITE on communication failure
+ */
+da7281_error_t da7281_play_sequence(da7281_device_t *device,
+                                      uint8_t seq_id,
+                                      uint8_t loops,
+                                      da7281_xfer_cb_t callback,
+                                      void *context)
+{
+    DA7281_CHECK_DEVICE(device);
+#if DA7281_ENABLE_PARAM_CHECK
+    if ((seq_id > DA7281_SEQ_CTL2_PS_SEQ_ID_MASK) ||
+        (loops > (DA7281_SEQ_CTL2_PS_SEQ_LOOP_MASK >> DA7281_SEQ_CTL2_PS_SEQ_LOOP_SHIFT))) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+#endif
+
+    da7281_error_t err = da7281_bus_begin(device->twi_instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+    if (device->seq_pending) {
+        (void)da7281_bus_end(device->twi_instance);
+        return DA7281_ERROR_BUSY;
+    }
+
+    uint8_t top_ctl1 = 0;
+    uint8_t mode = 0;
+    bool aborted = false;   /* Nothing pending here */
+    err = da7281_playback_enter(device, DA7281_OP_MODE_ETWM, &top_ctl1, &mode, &aborted);
+
+    if (err == DA7281_OK) {
+        err = da7281_seq_select(device, seq_id, loops);
+    }
+    if (err == DA7281_OK) {
+        err = da7281_seq_set_continue(device, device->playlist_count != 0U);
+    }
+
+    if (err == DA7281_OK) {
+        device->seq_callback = callback;
+        device->seq_context = context;
+        device->seq_pending = true;
+        err = da7281_write_register(device, DA7281_REG_TOP_CTL1,
+                                    top_ctl1 | DA7281_OP_MODE_ETWM | DA7281_TOP_CTL1_SEQ_START);
+        if (err != DA7281_OK) {
+            device->seq_pending = false;
+            device->seq_callback = NULL;
+            device->seq_context = NULL;
+        }
+    }
+    if ((err == DA7281_OK) && (mode != DA7281_OP_MODE_ETWM)) {
+        err = da7281_verify_write(device, device->verify, DA7281_REG_TOP_CTL1,
+                                  DA7281_TOP_CTL1_OP_MODE_MASK, DA7281_OP_MODE_ETWM);
+    }
+
+    da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+    if (err == DA7281_OK) {
+        err = end_err;
+    }
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("Sequence start failed: addr=0x%02X, err=%d", device->i2c_address, err);
+        return err;
+    }
+
+    device->mode = DA7281_MODE_ETWM;
+    DA7281_LOG_DEBUG("Sequence start: addr=0x%02X, id=%u, loops=%u", device->i2c_address, seq_id, loops);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Queue a sequence to follow the current one without a gap
+ *
+ * The sequencer latches SEQ_CTL2 when a segment starts, and with
+ * SEQ_CTL1.SEQ_CONTINUE set it starts whatever SEQ_CTL2 then holds on the
+ * same edge the current segment ends, latching E_SEQ_CONTINUE. So:
+ *
+ * - No sequence pending: the entry waits; da7281_play_sequence() sets
+ *   SEQ_CONTINUE when it starts the first one.
+ * - Pending, last segment playing (SEQ_CONTINUE clear): SEQ_CTL2 = entry
+ *   and SEQ_CONTINUE set now, two frames.
+ * - Pending, a segment already armed: the entry waits; each
+ *   E_SEQ_CONTINUE handled by da7281_handle_events() writes the next one
+ *   into SEQ_CTL2, and clears SEQ_CONTINUE after the last.
+ *
+ * The host has one segment's duration to service E_SEQ_CONTINUE; a later
+ * service replays the previous segment instead of the queued one.
+ *
+ * @param device Pointer to initialized device handle
+ * @param seq_id Sequence ID (0-15)
+ * @param loops Repeats after the first play (0-15)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if seq_id or loops is above 15
+ * @return DA7281_ERROR_BUSY if DA7281_PLAYLIST_DEPTH sequences are queued
+ * @return DA7281_ERROR_I2C_READ/WRITE on communication failure
+ */
+da7281_error_t da7281_queue_sequence(da7281_device_t *device, uint8_t seq_id, uint8_t loops)
+{
+    DA7281_CHECK_DEVICE(device);
+#if DA7281_ENABLE_PARAM_CHECK
+    if ((seq_id > DA7281_SEQ_CTL2_PS_SEQ_ID_MASK) ||
+        (loops > (DA7281_SEQ_CTL2_PS_SEQ_LOOP_MASK >> DA7281_SEQ_CTL2_PS_SEQ_LOOP_SHIFT))) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+#endif
+
+    da7281_error_t err = da7281_bus_begin(device->twi_instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    if (device->seq_pending && !device->seq_continue) {
+        err = da7281_seq_select(device, seq_id, loops);
+        if (err == DA7281_OK) {
+            err = da7281_seq_set_continue(device, true);
+        }
+    } else if (device->playlist_count < DA7281_PLAYLIST_DEPTH) {
+        da7281_seq_entry_t *entry =
+            &device->playlist[(device->playlist_head + device->playlist_count) % DA7281_PLAYLIST_DEPTH];
+        entry->seq_id = seq_id;
+        entry->loops = loops;
+        device->playlist_count++;
+    } else {
+        err = DA7281_ERROR_BUSY;
+    }
+
+    da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+    if (err == DA7281_OK) {
+        err = end_err;
+    }
+
+    return err;
+}
+
+/**
+ * @brief Arm or restart chained sequences after an event
+ *
+ * Runs inside the event session of da7281_handle_events().
+ *
+ * @param device Pointer to device handle with a pending sequence
+ * @param event1 IRQ_EVENT1 as read
+ * @param restarted Set when a missed chain was restarted with SEQ_START
+ * @return DA7281_OK on success, bus error otherwise
+ */
+static da7281_error_t da7281_seq_chain(da7281_device_t *device, uint8_t event1, bool *restarted)
+{
+    da7281_error_t err = DA7281_OK;
+
+    if ((event1 & DA7281_IRQ_EVENT1_E_SEQ_DONE) != 0U) {
+        /* Stopped although SEQ_CONTINUE is set: it was armed after the end */
+        if (device->seq_continue) {
+            uint8_t top_ctl1 = 0;
+            err = da7281_read_register_cached(device, DA7281_REG_TOP_CTL1, &top_ctl1);
+            if (err == DA7281_OK) {
+                err = da7281_write_register(device, DA7281_REG_TOP_CTL1,
+                                            (uint8_t)(top_ctl1 | DA7281_TOP_CTL1_SEQ_START));
+            }
+            *restarted = (err == DA7281_OK);
+        }
+    } else if ((event1 & DA7281_IRQ_EVENT1_E_SEQ_CONTINUE) != 0U) {
+        if (device->playlist_count != 0U) {
+            const da7281_seq_entry_t *next = &device->playlist[device->playlist_head];
+            err = da7281_seq_select(device, next->seq_id, next->loops);
+            if (err == DA7281_OK) {
+                device->playlist_head = (uint8_t)((device->playlist_head + 1U) % DA7281_PLAYLIST_DEPTH);
+                device->playlist_count--;
+            }
+        } else {
+            err = da7281_seq_set_continue(device, false);
+        }
+    }
+
+    return err;
+}
+
+/** IRQ_EVENT1..IRQ_STATUS1, read as one burst */
+#define DA7281_STATUS_BLOCK_LEN (DA7281_REG_IRQ_STATUS1 - DA7281_REG_IRQ_EVENT1 + 1U)
+
+/**
+ * @brief Unpack a status block burst
+ *
+ * A reported fault invalidates the shadow register cache.
+ *
+ * @param device Device the block was read from
+ * @param regs IRQ_EVENT1..IRQ_STATUS1 as read
+ * @param status Unpacked block
+ */
+static void da7281_status_decode(da7281_device_t *device, const uint8_t *regs,
+                                 da7281_status_block_t *status)
+{
+    status->irq_event1 = regs[DA7281_REG_IRQ_EVENT1 - DA7281_REG_IRQ_EVENT1];
+    status->irq_event_warning_diag = regs[DA7281_REG_IRQ_EVENT_WARNING_DIAG - DA7281_REG_IRQ_EVENT1];
+    status->irq_event_seq_diag = regs[DA7281_REG_IRQ_EVENT_SEQ_DIAG - DA7281_REG_IRQ_EVENT1];
+    status->irq_status1 = regs[DA7281_REG_IRQ_STATUS1 - DA7281_REG_IRQ_EVENT1];
+
+    /* Faults can change mode or reset the chip - shadow copies are stale */
+    if ((status->irq_event1 & DA7281_IRQ_EVENT1_FAULT_MASK) != 0U) {
+        (void)da7281_cache_invalidate(device);
+    }
+
+    DA7281_LOG_DEBUG("Status block: EVENT1=0x%02X, WARN=0x%02X, SEQ=0x%02X, STATUS1=0x%02X",
+                     status->irq_event1, status->irq_event_warning_diag,
+                     status->irq_event_seq_diag, status->irq_status1);
+}
+
+/** IRQ_EVENT1 bits that end a pending sequence with DA7281_ERROR_ABORTED */
+#define DA7281_SEQ_ABORT_EVENTS (DA7281_IRQ_EVENT1_E_SEQ_FAULT | DA7281_IRQ_EVENT1_FAULT_MASK)
+
+/**
+ * @brief Chain a pending sequence after its events were cleared
+ *
+ * Runs inside the event session.
+ *
+ * @param device Device whose events were read and cleared
+ * @param event1 IRQ_EVENT1 as read
+ * @param restarted Set when a missed chain was restarted with SEQ_START
+ * @return DA7281_OK on success, bus error otherwise
+ */
+static da7281_error_t da7281_events_chain(da7281_device_t *device, uint8_t event1, bool *restarted)
+{
+    *restarted = false;
+    if (device->seq_pending && ((event1 & DA7281_SEQ_ABORT_EVENTS) == 0U)) {
+        return da7281_seq_chain(device, event1, restarted);
+    }
+    return DA7281_OK;
+}
+
+/**
+ * @brief Complete a pending sequence once the event session has ended
+ *
+ * @param device Device whose events were handled
+ * @param event1 IRQ_EVENT1 as read
+ * @param restarted The chain was restarted, the sequence goes on
+ */
+static void da7281_events_complete(da7281_device_t *device, uint8_t event1, bool restarted)
+{
+    if ((event1 & DA7281_SEQ_ABORT_EVENTS) != 0U) {
+        da7281_sequence_complete(device, DA7281_ERROR_ABORTED);
+    } else if (((event1 & DA7281_IRQ_EVENT1_E_SEQ_DONE) != 0U) && !restarted) {
+        da7281_sequence_complete(device, DA7281_OK);
+    }
+}
+
+/**
+ * @brief Read, clear and act on latched events
+ *
+ * Reads IRQ_EVENT1..IRQ_STATUS1 in one burst (da7281_read_status_block())
+ * and, if IRQ_EVENT1 has latched bits, writes exactly those bits back to
+ * clear them, which releases nIRQ: two frames per event, one when nothing
+ * is latched. E_SEQ_CONTINUE adds one frame to arm the next queued
+ * sequence (da7281_queue_sequence()). A pending da7281_play_sequence()
+ * then completes:
+ *
+ * - E_SEQ_DONE: DA7281_OK, after the last queued sequence
+ * - E_SEQ_FAULT or a DA7281_IRQ_EVENT1_FAULT_MASK fault: DA7281_ERROR_ABORTED
+ *
+ * The callback runs after the bus session has ended.
+ *
+ * @param device Pointer to initialized device handle
+ * @param status Receives the block as read, before clearing (may be NULL)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_I2C_READ/WRITE on communication failure
+ */
+da7281_error_t da7281_handle_events(da7281_device_t *device, da7281_status_block_t *status)
+{
+    DA7281_CHECK_DEVICE(device);
+
+    da7281_status_block_t block;
+    da7281_error_t err = da7281_bus_begin(device->twi_instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    bool restarted = false;
+    err = da7281_read_status_block(device, &block);
+    if ((err == DA7281_OK) && (block.irq_event1 != 0U)) {
+        err = da7281_write_register(device, DA7281_REG_IRQ_EVENT1, block.irq_event1);
+    }
+    if (err == DA7281_OK) {
+        err = da7281_events_chain(device, block.irq_event1, &restarted);
+    }
+
+    da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+    if (err == DA7281_OK) {
+        err = end_err;
+    }
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("Event handling failed: addr=0x%02X, err=%d", device->i2c_address, err);
+        return err;
+    }
+
+    if (status != NULL) {
+        *status = block;
+    }
+
+    da7281_events_complete(device, block.irq_event1, restarted);
+
+    return DA7281_OK;
+}
+
+/* ========================================================================
+ * Interrupt Handling (nIRQ)
+ * ======================================================================== */
+
+#if (DA7281_IRQ_MAX_DEVICES > 8U)
+#error "DA7281_IRQ_MAX_DEVICES must not exceed 8 (one pending bit per device)"
+#endif
+
+/** Service passes while a line stays asserted, before backing off */
+#define DA7281_IRQ_MAX_PASSES   (4U)
+
+/** Back-off before serving a line that stayed asserted through every pass */
+#define DA7281_IRQ_RETRY_MS     (10U)
+
+/** Dispatched events, faults first */
+static const uint8_t s_irq_dispatch_order[] = {
+    DA7281_EVENT_OC_FAULT,
+    DA7281_EVENT_ACTUATOR_FAULT,
+    DA7281_EVENT_OVERTEMP,
+    DA7281_EVENT_UVLO,
+    DA7281_EVENT_WARNING,
+    DA7281_EVENT_SEQ_FAULT,
+    DA7281_EVENT_SEQ_DONE
+};
+
+/** Devices attached with da7281_irq_configure() */
+static da7281_device_t *s_irq_devices[DA7281_IRQ_MAX_DEVICES];
+
+/** Devices whose nIRQ line fell since the last service, one bit per slot */
+static volatile uint8_t s_irq_pending;
+
+/** s_irq_clock when each slot last had events (0 = never), scan order of shared lines */
+static uint32_t s_irq_active[DA7281_IRQ_MAX_DEVICES];
+static uint32_t s_irq_clock;
+
+/**
+ * @brief Slots of the devices attached to a GPIO
+ *
+ * @param pin GPIO number
+ * @return One bit per slot of s_irq_devices
+ */
+static uint8_t da7281_irq_line(uint8_t pin)
+{
+    uint8_t slots = 0U;
+    for (uint8_t i = 0; i < DA7281_IRQ_MAX_DEVICES; i++) {
+        if ((s_irq_devices[i] != NULL) && (s_irq_devices[i]->irq_pin == pin)) {
+            slots |= (uint8_t)(1U << i);
+        }
+    }
+    return slots;
+}
+
+/**
+ * @brief Call the device's handler once per latched event
+ *
+ * @param device Device whose events were read
+ * @param status Block as read by da7281_handle_events()
+ */
+static void da7281_irq_dispatch(da7281_device_t *device, const da7281_status_block_t *status)
+{
+    for (uint8_t i = 0; i < sizeof(s_irq_dispatch_order); i++) {
+        uint8_t event = s_irq_dispatch_order[i];
+        /* Re-read each time: a handler may detach the device */
+        if (((status->irq_event1 & event) != 0U) && (device->irq_handler != NULL)) {
+            device->irq_handler(device, (da7281_event_t)event, status, device->irq_context);
+        }
+    }
+}
+
+/**
+ * @brief Most recently active slot of a set on one bus
+ *
+ * @param slots Candidate slots, one bit each
+ * @param instance TWI instance number
+ * @return Slot index, DA7281_IRQ_MAX_DEVICES if no candidate is on the bus
+ */
+static uint8_t da7281_irq_next(uint8_t slots, uint8_t instance)
+{
+    uint8_t best = DA7281_IRQ_MAX_DEVICES;
+    for (uint8_t i = 0; i < DA7281_IRQ_MAX_DEVICES; i++) {
+        if (((slots & (1U << i)) != 0U) && (s_irq_devices[i] != NULL) &&
+            (s_irq_devices[i]->twi_instance == instance) &&
+            ((best == DA7281_IRQ_MAX_DEVICES) || (s_irq_active[i] > s_irq_active[best]))) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Slots of a set whose nIRQ line is still asserted
+ *
+ * @param slots Slots to check, one bit each
+ * @return The subset on a low line
+ */
+static uint8_t da7281_irq_asserted(uint8_t slots)
+{
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    uint8_t low = 0U;
+    for (uint8_t i = 0; i < DA7281_IRQ_MAX_DEVICES; i++) {
+        da7281_device_t *device = s_irq_devices[i];
+        if (((slots & (1U << i)) != 0U) && (device != NULL) && ops->pin_asserted(device->irq_pin)) {
+            low |= (uint8_t)(1U << i);
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Serve up to one device per bus with the two buses in parallel
+ *
+ * In one session per bus: the status blocks in one read chain
+ * (da7281_read_burst_multi()), then the latched IRQ_EVENT1 bits of every
+ * device that has any in one write chain (da7281_write_register_multi()),
+ * then sequence chaining. Completion callbacks and handlers run after the
+ * sessions. Per device this is the traffic of da7281_handle_events(); if
+ * the read fails, each device falls back to da7281_handle_events().
+ *
+ * @param slot Slot to serve per TWI instance (DA7281_IRQ_MAX_DEVICES = none)
+ */
+static void da7281_irq_round(const uint8_t slot[2])
+{
+    da7281_device_t *devices[2];
+    uint8_t index[2];
+    uint8_t regs[2][DA7281_STATUS_BLOCK_LEN];
+    uint8_t *const bufs[2] = {regs[0], regs[1]};
+    da7281_status_block_t status[2];
+    bool served[2] = {false, false};
+    bool restarted[2] = {false, false};
+    bool opened[2] = {false, false};
+    uint8_t count = 0U;
+
+    for (uint8_t b = 0; b < 2U; b++) {
+        if (slot[b] < DA7281_IRQ_MAX_DEVICES) {
+            index[count] = slot[b];
+            devices[count++] = s_irq_devices[slot[b]];
+        }
+    }
+
+    /* TWI0 before TWI1, the lock order of the multi-bus calls */
+    da7281_error_t err = DA7281_OK;
+    for (uint8_t i = 0; (i < count) && (err == DA7281_OK); i++) {
+        err = da7281_bus_begin(devices[i]->twi_instance);
+        opened[i] = (err == DA7281_OK);
+    }
+    if (err == DA7281_OK) {
+        err = da7281_read_burst_multi(devices, DA7281_REG_IRQ_EVENT1, bufs, DA7281_STATUS_BLOCK_LEN, count);
+    }
+    bool read = (err == DA7281_OK);
+
+    if (read) {
+        da7281_device_t *clear[2];
+        uint8_t bits[2];
+        uint8_t clears = 0U;
+        for (uint8_t i = 0; i < count; i++) {
+            da7281_status_decode(devices[i], regs[i], &status[i]);
+            served[i] = true;
+            if (status[i].irq_event1 != 0U) {
+                s_irq_active[index[i]] = ++s_irq_clock;
+                clear[clears] = devices[i];
+                bits[clears++] = status[i].irq_event1;
+            }
+        }
+
+        /* A failed chain does not say which bus failed: clear one by one */
+        if ((clears != 0U) &&
+            (da7281_write_register_multi(clear, DA7281_REG_IRQ_EVENT1, bits, clears) != DA7281_OK)) {
+            for (uint8_t i = 0; i < count; i++) {
+                if ((status[i].irq_event1 != 0U) &&
+                    (da7281_write_register(devices[i], DA7281_REG_IRQ_EVENT1, status[i].irq_event1) != DA7281_OK)) {
+                    served[i] = false;
+                }
+            }
+        }
+
+        for (uint8_t i = 0; i < count; i++) {
+            if (served[i] &&
+                (da7281_events_chain(devices[i], status[i].irq_event1, &restarted[i]) != DA7281_OK)) {
+                served[i] = false;
+            }
+        }
+    }
+
+    for (uint8_t i = count; i > 0U; i--) {
+        if (opened[i - 1U]) {
+            (void)da7281_bus_end(devices[i - 1U]->twi_instance);
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (!read) {
+            served[i] = (da7281_handle_events(devices[i], &status[i]) == DA7281_OK);
+            if (served[i] && (status[i].irq_event1 != 0U)) {
+                s_irq_active[index[i]] = ++s_irq_clock;
+            }
+        } else if (served[i]) {
+            da7281_events_complete(devices[i], status[i].irq_event1, restarted[i]);
+        } else {
+            DA7281_LOG_ERROR("nIRQ service failed: addr=0x%02X", devices[i]->i2c_address);
+        }
+        if (served[i]) {
+            da7281_irq_dispatch(devices[i], &status[i]);
+        }
+    }
+}
+
+/**
+ * @brief Serve the device from its nIRQ line instead of polling
+ *
+ * Attaches the device to pin and arms a falling-edge interrupt there
+ * through the bus backend (GPIOTE on nRF52). Each edge marks the device
+ * and wakes the driver's interrupt task (da7281_bus_pin_event()), which
+ * runs da7281_irq_service(): da7281_handle_events() reads
+ * IRQ_EVENT1..IRQ_STATUS1 in one burst and clears the latched bits in
+ * one write, then handler runs once per da7281_event_t, faults first.
+ *
+ * Several devices may share one pin (wired-OR nIRQ), see
+ * da7281_irq_service(). Events latched before this call leave nIRQ low
+ * without a new edge, so an asserted line is served at once. Calling again moves the device to
+ * another pin or handler; a NULL handler detaches it and disarms the pin
+ * once no other device uses it. The interrupt masks are left alone:
+ * events masked in IRQ_MASK1 never assert nIRQ.
+ *
+ * @param device Pointer to initialized device handle
+ * @param pin GPIO number of the nIRQ input
+ * @param handler Typed event handler (NULL to detach)
+ * @param context User pointer passed to the handler
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_BUSY if DA7281_IRQ_MAX_DEVICES devices are attached
+ * @return DA7281_ERROR_INVALID_PARAM if the backend cannot arm pin
+ * @return DA7281_ERROR_MUTEX_FAILED if the interrupt task cannot be created
+ */
+da7281_error_t da7281_irq_configure(da7281_device_t *device, uint8_t pin,
+                                      da7281_event_cb_t handler, void *context)
+{
+    DA7281_CHECK_DEVICE(device);
+
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    uint8_t slot = DA7281_IRQ_MAX_DEVICES;
+    bool attached = false;
+    for (uint8_t i = 0; i < DA7281_IRQ_MAX_DEVICES; i++) {
+        if (s_irq_devices[i] == device) {
+            slot = i;
+            attached = true;
+            break;
+        }
+        if ((s_irq_devices[i] == NULL) && (slot == DA7281_IRQ_MAX_DEVICES)) {
+            slot = i;
+        }
+    }
+
+    if (handler != NULL) {
+        if (slot >= DA7281_IRQ_MAX_DEVICES) {
+            return DA7281_ERROR_BUSY;
+        }
+        /* Arm the new line first: on failure the old attachment stays */
+        uint8_t others = (uint8_t)(da7281_irq_line(pin) & ~(1U << slot));
+        if ((others == 0U) && !(attached && (device->irq_pin == pin))) {
+            da7281_error_t err = ops->pin_irq(pin, true);
+            if (err != DA7281_OK) {
+                DA7281_LOG_ERROR("nIRQ pin %u not armed: err=%d", pin, err);
+                return err;
+            }
+        }
+    }
+
+    uint32_t state;
+    if (attached) {
+        uint8_t old_pin = device->irq_pin;
+        state = ops->irq_lock();
+        s_irq_devices[slot] = NULL;
+        s_irq_pending &= (uint8_t)~(1U << slot);
+        ops->irq_unlock(state);
+        device->irq_handler = NULL;
+        if ((da7281_irq_line(old_pin) == 0U) && ((handler == NULL) || (old_pin != pin))) {
+            (void)ops->pin_irq(old_pin, false);
+        }
+    }
+
+    if (handler == NULL) {
+        return DA7281_OK;
+    }
+
+    device->irq_pin = pin;
+    device->irq_handler = handler;
+    device->irq_context = context;
+
+    if (!attached) {
+        s_irq_active[slot] = 0U;
+    }
+
+    state = ops->irq_lock();
+    s_irq_devices[slot] = device;
+    bool asserted = ops->pin_asserted(pin);
+    if (asserted) {
+        s_irq_pending |= (uint8_t)(1U << slot);
+    }
+    ops->irq_unlock(state);
+
+    if (asserted) {
+        ops->defer();
+    }
+
+    DA7281_LOG_DEBUG("nIRQ attached: addr=0x%02X, pin=%u", device->i2c_address, pin);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Falling edge on an armed nIRQ input (interrupt context)
+ *
+ * @param pin GPIO number
+ */
+void da7281_bus_pin_event(uint8_t pin)
+{
+    uint8_t slots = da7281_irq_line(pin);
+    if (slots != 0U) {
+        s_irq_pending |= slots;
+        da7281_bus_get_ops()->defer();
+    }
+}
+
+/**
+ * @brief Serve every device whose nIRQ line fell (interrupt task)
+ *
+ * One edge on a shared (wired-OR) line marks every device on it. They
+ * are scanned in rounds of up to one device per bus, the two buses in
+ * parallel (da7281_irq_round()), each bus taking its most recently
+ * active device first. After each round the line is checked again: once
+ * it is released, the devices not yet read cannot be asserting it and
+ * are skipped. An event that latches during the scan keeps the line low,
+ * so the scan goes on; one that latches in a device already read keeps
+ * it low after the scan, and the devices on that line are scanned again,
+ * up to DA7281_IRQ_MAX_PASSES passes. A line still low after that (e.g.
+ * its clear keeps failing) would never see another falling edge, so its
+ * devices are marked pending again and the task reschedules itself after
+ * DA7281_IRQ_RETRY_MS. A line released before the task runs costs no bus
+ * access.
+ */
+void da7281_irq_service(void)
+{
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+
+    uint32_t state = ops->irq_lock();
+    uint8_t pending = s_irq_pending;
+    s_irq_pending = 0U;
+    ops->irq_unlock(state);
+
+    /* A line already released again has nothing latched behind it */
+    pending = da7281_irq_asserted(pending);
+    for (uint8_t pass = 0; pending != 0U; pass++) {
+        if (pass >= DA7281_IRQ_MAX_PASSES) {
+            DA7281_LOG_WARNING("nIRQ still asserted after %u passes, retry in %u ms: slots=0x%02X",
+                               pass, DA7281_IRQ_RETRY_MS, pending);
+            state = ops->irq_lock();
+            s_irq_pending |= pending;
+            ops->irq_unlock(state);
+            ops->delay(DA7281_IRQ_RETRY_MS);
+            ops->defer();
+            break;
+        }
+
+        uint8_t scan = pending;
+        while (scan != 0U) {
+            uint8_t slot[2] = {da7281_irq_next(scan, 0U), da7281_irq_next(scan, 1U)};
+            if ((slot[0] == DA7281_IRQ_MAX_DEVICES) && (slot[1] == DA7281_IRQ_MAX_DEVICES)) {
+                break;  /* Detached by a handler */
+            }
+            da7281_irq_round(slot);
+            for (uint8_t b = 0; b < 2U; b++) {
+                if (slot[b] < DA7281_IRQ_MAX_DEVICES) {
+                    scan &= (uint8_t)~(1U << slot[b]);
+                }
+            }
+            scan = da7281_irq_asserted(scan);
+        }
+
+        pending = da7281_irq_asserted(pending);
+    }
+}
+
+/* ========================================================================
+ * Waveform Memory (SNP)
+ * ======================================================================== */
+
+/**
+ * @brief Continue a CRC-16/CCITT-FALSE over more bytes
+ *
+ * Bitwise (no table): 100 bytes cost about 800 shift/xor steps, far below
+ * the 2.3 ms the same bytes take on the bus.
+ *
+ * @param crc CRC so far (0xFFFF to start)
+ * @param data Bytes to add
+ * @param len Number of bytes
+ * @return Updated CRC
+ */
+static uint16_t da7281_crc16_update(uint16_t crc, const uint8_t *data, uint8_t len)
+{
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8);
+        for (uint8_t bit = 0; bit < 8U; bit++) {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief CRC of a waveform memory image
+ *
+ * CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF, no
+ * reflection, no final XOR): the value da7281_snp_verify() expects.
+ *
+ * @param image Image bytes (SNP_MEM_0 first)
+ * @param len Number of bytes
+ * @return CRC, 0xFFFF for an empty or NULL image
+ */
+uint16_t da7281_snp_crc(const uint8_t *image, uint8_t len)
+{
+    if (image == NULL) {
+        return 0xFFFFU;
+    }
+    return da7281_crc16_update(0xFFFFU, image, len);
+}
+
+/**
+ * @brief Check the start of the waveform memory against a CRC
+ *
+ * Reads SNP_MEM_0 .. SNP_MEM_(len - 1) in DA7281_I2C_MAX_BURST_LEN bursts
+ * (one frame for the whole window) and compares the CRC of what came back
+ * with the expected one, so no copy of the image is needed: a CRC kept
+ * with the firmware is enough to check the memory after a brown-out.
+ *
+ * @param device Pointer to initialized device handle
+ * @param len Number of bytes to check (1 to DA7281_SNP_MEM_SIZE)
+ * @param crc Expected da7281_snp_crc() of those bytes
+ * @return DA7281_OK if the memory matches
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if len is out of range
+ * @return DA7281_ERROR_VERIFY_FAILED if the CRC differs
+ * @return DA7281_ERROR_I2C_READ on communication failure
+ */
+da7281_error_t da7281_snp_verify(da7281_device_t *device, uint8_t len, uint16_t crc)
+{
+    DA7281_CHECK_DEVICE(device);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_SNP_MEM_SIZE);
+
+    uint8_t buf[DA7281_I2C_MAX_BURST_LEN];
+    uint16_t readback = 0xFFFFU;
+    da7281_error_t err = DA7281_OK;
+    for (uint8_t offset = 0; (err == DA7281_OK) && (offset < len); ) {
+        uint8_t chunk = (uint8_t)(len - offset);
+        chunk = (chunk > DA7281_I2C_MAX_BURST_LEN) ? (uint8_t)DA7281_I2C_MAX_BURST_LEN : chunk;
+        err = da7281_read_burst(device, (uint8_t)(DA7281_REG_SNP_MEM_BASE + offset), buf, chunk);
+        readback = da7281_crc16_update(readback, buf, chunk);
+        offset = (uint8_t)(offset + chunk);
+    }
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    if (readback != crc) {
+        DA7281_LOG_WARNING("SNP CRC mismatch: addr=0x%02X, len=%u, expected 0x%04X, got 0x%04X",
+                           device->i2c_address, len, crc, readback);
+        return DA7281_ERROR_VERIFY_FAILED;
+    }
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Load a waveform image into the SNP memory and verify it
+ *
+ * In one bus session:
+ *
+ * 1. An active mode (DRO, PWM, RTWM, ETWM) is left for INACTIVE so no
+ *    sequence plays from a half-written memory; a pending
+ *    da7281_play_sequence() completes with DA7281_ERROR_ABORTED.
+ * 2. MEM_CTL1 (base address) and MEM_CTL2 (WAV_MEM_LOCK set) are written
+ *    as one two-byte burst; with a shadow cache, bytes that already hold
+ *    their value are skipped.
+ * 3. The image is written from SNP_MEM_0 in DA7281_I2C_MAX_BURST_LEN
+ *    bursts: one frame for any image up to the full 100-byte window.
+ * 4. WAV_MEM_LOCK is restored if it was clear.
+ * 5. da7281_snp_verify() reads the image back in one burst and compares
+ *    CRCs.
+ *
+ * Bytes past len keep their contents. On a CRC mismatch the shadow cache
+ * is invalidated, since the copies of the written bytes are not what the
+ * chip holds.
+ *
+ * @param device Pointer to initialized device handle
+ * @param image Image bytes (SNP_MEM_0 first)
+ * @param len Number of bytes (1 to DA7281_SNP_MEM_SIZE)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device or image is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_INVALID_PARAM if len is out of range
+ * @return DA7281_ERROR_VERIFY_FAILED if the readback CRC differs
+ * @return DA7281_ERROR_I2C_READ/WRITE on communication failure
+ */
+da7281_error_t da7281_snp_upload(da7281_device_t *device, const uint8_t *image, uint8_t len)
+{
+    DA7281_CHECK_DEVICE(device);
+    DA7281_CHECK_NULL(image);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_SNP_MEM_SIZE);
+
+    da7281_error_t err = da7281_bus_begin(device->twi_instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    uint8_t top_ctl1 = 0;
+    uint8_t mem_ctl2 = 0;
+    bool stopped = false;
+    bool aborted = false;
+    err = da7281_read_register_cached(device, DA7281_REG_TOP_CTL1, &top_ctl1);
+    uint8_t mode = top_ctl1 & DA7281_TOP_CTL1_OP_MODE_MASK;
+    if ((err == DA7281_OK) && (mode >= DA7281_OP_MODE_DRO) && (mode <= DA7281_OP_MODE_ETWM)) {
+        err = da7281_write_register(device, DA7281_REG_TOP_CTL1,
+                                    (uint8_t)((top_ctl1 & (uint8_t)~(DA7281_TOP_CTL1_OP_MODE_MASK |
+                                                                     DA7281_TOP_CTL1_SEQ_START)) |
+                                              DA7281_OP_MODE_INACTIVE));
+        stopped = (err == DA7281_OK);
+        aborted = stopped && da7281_seq_halted(device);
+    }
+    if (err == DA7281_OK) {
+        err = da7281_read_register_cached(device, DA7281_REG_MEM_CTL2, &mem_ctl2);
+    }
+
+    bool unlocked = false;
+    if (err == DA7281_OK) {
+        const uint8_t mem_ctl[2] = {
+            DA7281_MEM_CTL1_WAV_MEM_BASE_ADDR,
+            (uint8_t)(mem_ctl2 | DA7281_MEM_CTL2_WAV_MEM_LOCK)
+        };
+        err = da7281_write_burst_diff(device, DA7281_REG_MEM_CTL1, mem_ctl, sizeof(mem_ctl), NULL);
+        unlocked = (err == DA7281_OK) && ((mem_ctl2 & DA7281_MEM_CTL2_WAV_MEM_LOCK) == 0U);
+    }
+
+    for (uint8_t offset = 0; (err == DA7281_OK) && (offset < len); ) {
+        uint8_t chunk = (uint8_t)(len - offset);
+        chunk = (chunk > DA7281_I2C_MAX_BURST_LEN) ? (uint8_t)DA7281_I2C_MAX_BURST_LEN : chunk;
+        err = da7281_write_burst(device, (uint8_t)(DA7281_REG_SNP_MEM_BASE + offset), &image[offset], chunk);
+        offset = (uint8_t)(offset + chunk);
+    }
+
+    /* Relock even after a failed write */
+    if (unlocked) {
+        da7281_error_t lock_err = da7281_write_register(device, DA7281_REG_MEM_CTL2, mem_ctl2);
+        if (err == DA7281_OK) {
+            err = lock_err;
+        }
+    }
+
+    if (err == DA7281_OK) {
+        err = da7281_snp_verify(device, len, da7281_snp_crc(image, len));
+        if (err == DA7281_ERROR_VERIFY_FAILED) {
+            (void)da7281_cache_invalidate(device);
+        }
+    }
+
+    da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+    if (err == DA7281_OK) {
+        err = end_err;
+    }
+    if (stopped) {
+        device->mode = DA7281_MODE_INACTIVE;
+    }
+    if (aborted) {
+        da7281_sequence_complete(device, DA7281_ERROR_ABORTED);
+    }
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("SNP upload failed: addr=0x%02X, len=%u, err=%d", device->i2c_address, len, err);
+        return err;
+    }
+
+    DA7281_LOG_INFO("SNP upload: addr=0x%02X, %u bytes verified", device->i2c_address, len);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Read all IRQ event and status registers
+ *
+ * IRQ_EVENT1, IRQ_EVENT_WARNING_DIAG, IRQ_EVENT_SEQ_DIAG and IRQ_STATUS1
+ * are contiguous (0x03-0x06), so a fault check is one burst read: one
+ * mutex acquisition and one write/repeated-start/read cycle instead of four.
+ * A reported fault invalidates the shadow register cache.
+ *
+ * @param device Pointer to initialized device handle
+ * @param status Pointer to store the register block
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device or status is NULL
+ * @return DA7281_ERROR_NOT_INITIALIZED if device not initialized
+ * @return DA7281_ERROR_I2C_READ on communication failure
+ */
+da7281_error_t da7281_read_status_block(da7281_device_t *device,
+                                         da7281_status_block_t *status)
+{
+    DA7281_CHECK_DEVICE(device);
+    DA7281_CHECK_NULL(status);
+
+    uint8_t regs[DA7281_STATUS_BLOCK_LEN];
+
+    da7281_error_t err = da7281_read_burst(device, DA7281_REG_IRQ_EVENT1,
+                                             regs, sizeof(regs));
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    da7281_status_decode(device, regs, status);
+
+    return DA7281_OK;
+}
+
 /**
  * @brief Read chip revision
  */
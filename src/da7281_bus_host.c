@@ -0,0 +1,381 @@
+/**
+ * @file da7281_bus_host.c
+ * @brief DA7281 Bus Backend for native (host) builds
+ * @author A. R. Ansari
+ * @date 2024-11-21
+ *
+ * Implements da7281_bus_ops_t without hardware or RTOS so the real driver
+ * can be profiled on a PC. Each TWI instance carries four DA7281 models
+ * (src/da7281_sim.c) at 0x48..0x4B. Frames complete synchronously inside
+ * transfer() and are charged in virtual time at 400 kHz:
+ *
+ * - START or repeated START: 1 bit, address byte + ACK: 9 bits
+ * - every further byte + ACK/NACK: 9 bits
+ * - STOP: 1 bit
+ *
+ * Single-threaded: locks only count, interrupt masking is a no-op. nIRQ
+ * outputs wired to GPIOs (da7281_bus_host_wire_irq()) are sampled every
+ * time virtual time moves; the driver's interrupt task runs inside
+ * delay(), which stops at the next model event so the task starts at the
+ * virtual time of the edge, as a higher-priority task would preempt the
+ * sleeping caller. It waits while a bus lock is held.
+ */
+
+#include "da7281_bus.h"
+#include "da7281_sim.h"
+#include <string.h>
+
+/* ========================================================================
+ * Private Definitions
+ * ======================================================================== */
+
+#define HOST_BUS_INSTANCES      DA7281_SIM_INSTANCES
+
+/** Address of the first simulated device on each bus */
+#define HOST_BUS_FIRST_ADDR     (0x48U)
+
+/** Bus time per bit at 400 kHz, in nanoseconds */
+#define HOST_BUS_NS_PER_BIT     (2500U)
+
+/* ========================================================================
+ * Private Variables
+ * ======================================================================== */
+
+static bool s_signalled[HOST_BUS_INSTANCES];
+static da7281_bus_host_stats_t s_stats;
+
+/** GPIO each device's nIRQ is wired to, if s_irq_wired */
+static uint8_t s_irq_pin[HOST_BUS_INSTANCES][DA7281_SIM_DEVICES];
+static bool s_irq_wired[HOST_BUS_INSTANCES][DA7281_SIM_DEVICES];
+
+/** Armed falling-edge inputs, and inputs low at the last sample (bit per GPIO) */
+static uint32_t s_pins_armed;
+static uint32_t s_pins_low;
+
+/** Interrupt task woken (defer()) and not run yet */
+static bool s_deferred;
+
+/** Interrupt task running (its own delay() calls must not re-enter it) */
+static bool s_in_task;
+
+/** Bus locks held */
+static uint32_t s_locks;
+
+/** Virtual time since reset in nanoseconds */
+static uint64_t s_time_ns;
+
+/** Injected NACKs (da7281_bus_host_fail()) */
+static struct {
+    uint8_t instance;
+    uint8_t address;
+    uint8_t kinds;
+    uint32_t count;
+} s_fail;
+
+/* ========================================================================
+ * Private Functions
+ * ======================================================================== */
+
+/**
+ * @brief Sample the wired nIRQ lines and report falling edges on armed pins
+ */
+static void host_bus_sample_pins(void)
+{
+    uint32_t low = 0U;
+    for (uint8_t i = 0; i < HOST_BUS_INSTANCES; i++) {
+        for (uint8_t d = 0; d < DA7281_SIM_DEVICES; d++) {
+            if (s_irq_wired[i][d] && da7281_sim_nirq(i, (uint8_t)(HOST_BUS_FIRST_ADDR + d))) {
+                low |= 1UL << s_irq_pin[i][d];
+            }
+        }
+    }
+
+    uint32_t fell = low & ~s_pins_low & s_pins_armed;
+    s_pins_low = low;
+    for (uint8_t pin = 0; fell != 0U; pin++, fell >>= 1) {
+        if ((fell & 1U) != 0U) {
+            da7281_bus_pin_event(pin);
+        }
+    }
+}
+
+/**
+ * @brief Advance virtual time and let the device models catch up
+ */
+static void host_bus_elapse(uint64_t ns)
+{
+    s_time_ns += ns;
+    da7281_sim_advance(s_time_ns);
+    host_bus_sample_pins();
+}
+
+/**
+ * @brief Charge bus time for a number of SCL clocks on one bus
+ */
+static void host_bus_clock(uint8_t instance, uint32_t bits)
+{
+    s_stats.bits += bits;
+    s_stats.bus_bits[instance] += bits;
+    host_bus_elapse((uint64_t)bits * HOST_BUS_NS_PER_BIT);
+}
+
+/* ========================================================================
+ * Bus Operations
+ * ======================================================================== */
+
+static da7281_error_t host_bus_init(uint8_t instance, uint8_t scl_pin, uint8_t sda_pin)
+{
+    (void)scl_pin;
+    (void)sda_pin;
+    return (instance < HOST_BUS_INSTANCES) ? DA7281_OK : DA7281_ERROR_INVALID_PARAM;
+}
+
+/**
+ * @brief Clock one frame through the simulated devices and report it
+ *
+ * Each byte reaches the device model once its ACK clock has been charged,
+ * so register side effects happen at their time on the bus.
+ */
+static da7281_error_t host_bus_transfer(uint8_t instance, const da7281_bus_frame_t *frame)
+{
+    s_stats.address_phases++;
+    host_bus_clock(instance, 1U + 9U);
+
+    uint8_t kind = (frame->rx != NULL) ? DA7281_BUS_HOST_FAIL_READS : DA7281_BUS_HOST_FAIL_WRITES;
+    bool fail = (s_fail.count != 0U) && (s_fail.instance == instance) &&
+                (s_fail.address == frame->address) && ((s_fail.kinds & kind) != 0U);
+    if (fail && (s_fail.count != UINT32_MAX)) {
+        s_fail.count--;
+    }
+
+    if (fail || !da7281_sim_select(instance, frame->address)) {
+        s_stats.nacks++;
+        s_stats.transactions++;
+        host_bus_clock(instance, 1U);
+        da7281_bus_event(instance, false);
+        return DA7281_OK;
+    }
+
+    for (uint16_t i = 0; i < frame->tx_len; i++) {
+        s_stats.bytes++;
+        host_bus_clock(instance, 9U);
+        da7281_sim_write(instance, frame->address, frame->tx[i], i == 0U);
+    }
+
+    if (frame->rx != NULL) {
+        s_stats.address_phases++;
+        host_bus_clock(instance, 1U + 9U);
+        for (uint16_t i = 0; i < frame->rx_len; i++) {
+            frame->rx[i] = da7281_sim_read(instance, frame->address);
+            s_stats.bytes++;
+            host_bus_clock(instance, 9U);
+        }
+    }
+
+    if ((frame->rx != NULL) || !frame->no_stop) {
+        s_stats.transactions++;
+        host_bus_clock(instance, 1U);
+    }
+
+    da7281_bus_event(instance, true);
+    return DA7281_OK;
+}
+
+static da7281_error_t host_bus_lock(uint8_t instance)
+{
+    (void)instance;
+    s_stats.lock_takes++;
+    s_locks++;
+    return DA7281_OK;
+}
+
+static void host_bus_unlock(uint8_t instance)
+{
+    (void)instance;
+    s_locks--;
+}
+
+/** Frames complete inside transfer(), so the signal is already there or never comes */
+static da7281_error_t host_bus_wait(uint8_t instance, uint32_t timeout_ms)
+{
+    if (!s_signalled[instance]) {
+        host_bus_elapse((uint64_t)timeout_ms * 1000000ULL);
+        return DA7281_ERROR_TIMEOUT;
+    }
+    s_signalled[instance] = false;
+    return DA7281_OK;
+}
+
+static void host_bus_signal(uint8_t instance)
+{
+    s_signalled[instance] = true;
+}
+
+static uint32_t host_bus_irq_lock(void)
+{
+    return 0U;
+}
+
+static void host_bus_irq_unlock(uint32_t state)
+{
+    (void)state;
+}
+
+/**
+ * @brief Sleep, running the interrupt task at the time of each edge
+ *
+ * A task run that sleeps past the end (interrupt back-off) leaves its
+ * next run to the next delay().
+ */
+static void host_bus_delay(uint32_t ms)
+{
+    uint64_t end = s_time_ns + ((uint64_t)ms * 1000000ULL);
+
+    host_bus_sample_pins();
+    for (;;) {
+        if (s_deferred && !s_in_task && (s_locks == 0U) && (s_time_ns <= end)) {
+            s_deferred = false;
+            s_in_task = true;
+            da7281_irq_service();
+            s_in_task = false;
+            continue;
+        }
+        uint64_t next = da7281_sim_next_event_ns();
+        if ((next >= end) || (next < s_time_ns)) {
+            break;
+        }
+        host_bus_elapse(next - s_time_ns);
+    }
+
+    if (end > s_time_ns) {
+        host_bus_elapse(end - s_time_ns);
+    }
+}
+
+static uint32_t host_bus_now(void)
+{
+    return (uint32_t)(s_time_ns / 1000U);
+}
+
+static void *host_bus_self(void)
+{
+    return (void *)&s_stats;    /* One task */
+}
+
+static da7281_error_t host_bus_pin_irq(uint8_t pin, bool enable)
+{
+    if (pin >= DA7281_BUS_HOST_PINS) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    if (enable) {
+        s_pins_armed |= 1UL << pin;
+    } else {
+        s_pins_armed &= ~(1UL << pin);
+    }
+    return DA7281_OK;
+}
+
+static bool host_bus_pin_asserted(uint8_t pin)
+{
+    host_bus_sample_pins();
+    return (pin < DA7281_BUS_HOST_PINS) && ((s_pins_low & (1UL << pin)) != 0U);
+}
+
+static void host_bus_defer(void)
+{
+    s_deferred = true;
+}
+
+/** Host bus backend */
+const da7281_bus_ops_t da7281_bus_ops_host = {
+    .init = host_bus_init,
+    .transfer = host_bus_transfer,
+    .lock = host_bus_lock,
+    .unlock = host_bus_unlock,
+    .wait = host_bus_wait,
+    .signal = host_bus_signal,
+    .irq_lock = host_bus_irq_lock,
+    .irq_unlock = host_bus_irq_unlock,
+    .delay = host_bus_delay,
+    .now = host_bus_now,
+    .self = host_bus_self,
+    .pin_irq = host_bus_pin_irq,
+    .pin_asserted = host_bus_pin_asserted,
+    .defer = host_bus_defer
+};
+
+/* ========================================================================
+ * Public Functions
+ * ======================================================================== */
+
+/**
+ * @brief Reset the host backend: device models, counters and virtual time
+ */
+void da7281_bus_host_reset(void)
+{
+    da7281_sim_reset();
+    memset(s_signalled, 0, sizeof(s_signalled));
+    memset(&s_stats, 0, sizeof(s_stats));
+    memset(s_irq_wired, 0, sizeof(s_irq_wired));
+    s_pins_armed = 0U;
+    s_pins_low = 0U;
+    s_deferred = false;
+    memset(&s_fail, 0, sizeof(s_fail));
+    s_time_ns = 0U;
+}
+
+/**
+ * @brief Host backend traffic counters since the last reset
+ *
+ * @param stats Counter snapshot
+ */
+void da7281_bus_host_stats(da7281_bus_host_stats_t *stats)
+{
+    if (stats != NULL) {
+        *stats = s_stats;
+    }
+}
+
+/**
+ * @brief Clear the host backend counters (devices and time are kept)
+ */
+void da7281_bus_host_clear_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/**
+ * @brief Wire a simulated device's nIRQ output to a host GPIO
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit device address (0x48..0x4B)
+ * @param pin GPIO below DA7281_BUS_HOST_PINS, or DA7281_BUS_HOST_NO_PIN
+ */
+void da7281_bus_host_wire_irq(uint8_t instance, uint8_t address, uint8_t pin)
+{
+    if ((instance >= HOST_BUS_INSTANCES) || (address < HOST_BUS_FIRST_ADDR) ||
+        (address >= (HOST_BUS_FIRST_ADDR + DA7281_SIM_DEVICES)) ||
+        ((pin >= DA7281_BUS_HOST_PINS) && (pin != DA7281_BUS_HOST_NO_PIN))) {
+        return;
+    }
+    s_irq_pin[instance][address - HOST_BUS_FIRST_ADDR] = pin;
+    s_irq_wired[instance][address - HOST_BUS_FIRST_ADDR] = (pin != DA7281_BUS_HOST_NO_PIN);
+    host_bus_sample_pins();
+}
+
+/**
+ * @brief NACK the next frames of some kinds sent to one device
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param address 7-bit device address
+ * @param kinds DA7281_BUS_HOST_FAIL_READS and/or DA7281_BUS_HOST_FAIL_WRITES
+ * @param count Frames to fail (UINT32_MAX = until cleared, 0 = clear)
+ */
+void da7281_bus_host_fail(uint8_t instance, uint8_t address, uint8_t kinds, uint32_t count)
+{
+    s_fail.instance = instance;
+    s_fail.address = address;
+    s_fail.kinds = kinds;
+    s_fail.count = count;
+}
@@ -0,0 +1,665 @@
+/**
+ * @file da7281_bus_nrf.c
+ * @brief DA7281 Bus Backend for nRF52 with FreeRTOS
+ * @author A. R. Ansari
+ * @date 2024-11-21
+ *
+ * Implements da7281_bus_ops_t on the Qorvo/Nordic SDK:
+ *
+ * - Transport (DA7281_I2C_BACKEND): the legacy nrf_drv_twi driver, where
+ *   the TWI peripheral interrupts for every byte, or nrfx_twim, where
+ *   EasyDMA moves a whole frame (register address plus burst data, or
+ *   address write then burst read) as one job. Both run with an event
+ *   handler, so transfer() returns as soon as the peripheral is started.
+ * - Locking (DA7281_BUS_LOCK): per-bus FreeRTOS mutex, scheduler lock or
+ *   nothing, resolved by the preprocessor.
+ * - Completion: a binary semaphore per bus, or a flag the caller spins on
+ *   while the scheduler is suspended (DA7281_BUS_LOCK_CRITICAL).
+ * - nIRQ: nrf_drv_gpiote falling-edge IN events; the handler only
+ *   notifies the interrupt task, which serves the devices over I2C.
+ *
+ * NOTE: Nordic nrf_drv_twi API expects 7-bit I2C addresses (0x48..0x4B).
+ *       The R/W bit is handled internally by the driver. Do not left-shift addresses.
+ */
+
+/** Binary log file number (DA7281_LOG_BACKEND 4) */
+#define DA7281_LOG_FILE_ID (3U)
+
+#include "da7281_bus.h"
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+#include "nrfx_twim.h"
+#else
+#include "nrf_drv_twi.h"
+#endif
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "app_util_platform.h"
+#include "nrf_drv_gpiote.h"
+#include "nrf_timer.h"
+
+/* ========================================================================
+ * Private Variables
+ * ======================================================================== */
+
+#if DA7281_STATIC_ALLOCATION && (!defined(configSUPPORT_STATIC_ALLOCATION) || (configSUPPORT_STATIC_ALLOCATION == 0))
+#error "DA7281_STATIC_ALLOCATION requires configSUPPORT_STATIC_ALLOCATION = 1 in FreeRTOSConfig.h"
+#endif
+
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_MUTEX)
+/** FreeRTOS mutex for thread-safe I2C access (one per TWI bus) */
+static SemaphoreHandle_t s_i2c_mutex[2] = {NULL, NULL};
+#endif
+
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_CRITICAL)
+/** Set by signal(); the waiting caller spins on it with the scheduler suspended */
+static volatile bool s_i2c_signalled[2] = {false, false};
+#else
+/** Given when a blocking call completes (one per TWI bus) */
+static SemaphoreHandle_t s_i2c_done[2] = {NULL, NULL};
+#endif
+
+#if DA7281_STATIC_ALLOCATION
+/** Kernel object storage for the per-bus mutex and completion semaphore (no heap) */
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_MUTEX)
+static StaticSemaphore_t s_i2c_mutex_storage[2];
+#endif
+#if (DA7281_BUS_LOCK != DA7281_BUS_LOCK_CRITICAL)
+static StaticSemaphore_t s_i2c_done_storage[2];
+#endif
+#endif
+
+/** Interrupt task, created by the first armed nIRQ pin */
+static TaskHandle_t s_irq_task = NULL;
+
+#if DA7281_STATIC_ALLOCATION
+/** Interrupt task control block and stack (no heap) */
+static StaticTask_t s_irq_task_storage;
+static StackType_t s_irq_task_stack[DA7281_IRQ_TASK_STACK_WORDS];
+#endif
+
+/** Event handler context: the instance number of each bus */
+static const uint8_t s_instance_ids[2] = {0U, 1U};
+
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+/** TWIM instance handles (EasyDMA; only instantiate enabled instances) */
+static const nrfx_twim_t s_twim_instances[2] = {
+#if defined(NRFX_TWIM0_ENABLED) && NRFX_TWIM0_ENABLED
+    NRFX_TWIM_INSTANCE(0),
+#else
+    {0},
+#endif
+#if defined(NRFX_TWIM1_ENABLED) && NRFX_TWIM1_ENABLED
+    NRFX_TWIM_INSTANCE(1)
+#else
+    {0}
+#endif
+};
+#else
+/** TWI instance handles (only instantiate enabled instances) */
+static nrf_drv_twi_t s_twi_instances[2] = {
+#if (defined(NRFX_TWIM0_ENABLED) && NRFX_CHECK(NRFX_TWIM0_ENABLED)) || (defined(NRFX_TWI0_ENABLED) && NRFX_CHECK(NRFX_TWI0_ENABLED))
+    NRF_DRV_TWI_INSTANCE(0),
+#else
+    {0},
+#endif
+#if (defined(NRFX_TWIM1_ENABLED) && NRFX_CHECK(NRFX_TWIM1_ENABLED)) || (defined(NRFX_TWI1_ENABLED) && NRFX_CHECK(NRFX_TWI1_ENABLED))
+    NRF_DRV_TWI_INSTANCE(1)
+#else
+    {0}
+#endif
+};
+#endif
+
+/* ========================================================================
+ * Private Function Prototypes
+ * ======================================================================== */
+
+static da7281_error_t da7281_nrf_init_mutex(uint8_t instance);
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+static void da7281_nrf_event_handler(nrfx_twim_evt_t const *p_event, void *p_context);
+#else
+static void da7281_nrf_event_handler(nrf_drv_twi_evt_t const *p_event, void *p_context);
+#endif
+
+/* ========================================================================
+ * Private Function Implementations
+ * ======================================================================== */
+
+/**
+ * @brief Initialize I2C mutex for thread-safe operation (per TWI bus)
+ *
+ * Creates a FreeRTOS mutex to protect I2C bus access from concurrent threads.
+ * Each TWI bus has its own mutex to allow parallel access to different buses.
+ * Also creates the binary semaphore blocking calls sleep on. With
+ * DA7281_STATIC_ALLOCATION both live in static storage and cannot fail.
+ * Only the objects the selected DA7281_BUS_LOCK mode uses are created.
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex creation fails
+ */
+static da7281_error_t da7281_nrf_init_mutex(uint8_t instance)
+{
+    (void)instance;  /* Unused when DA7281_BUS_LOCK_CRITICAL needs no kernel objects */
+
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_MUTEX)
+    if (s_i2c_mutex[instance] == NULL) {
+#if DA7281_STATIC_ALLOCATION
+        s_i2c_mutex[instance] = xSemaphoreCreateMutexStatic(&s_i2c_mutex_storage[instance]);
+#else
+        s_i2c_mutex[instance] = xSemaphoreCreateMutex();
+#endif
+        if (s_i2c_mutex[instance] == NULL) {
+            DA7281_LOG_ERROR("Failed to create I2C mutex for TWI%d - insufficient heap memory", instance);
+            return DA7281_ERROR_MUTEX_FAILED;
+        }
+        DA7281_LOG_INFO("I2C mutex created successfully for TWI%d", instance);
+    }
+#endif
+
+#if (DA7281_BUS_LOCK != DA7281_BUS_LOCK_CRITICAL)
+    if (s_i2c_done[instance] == NULL) {
+#if DA7281_STATIC_ALLOCATION
+        s_i2c_done[instance] = xSemaphoreCreateBinaryStatic(&s_i2c_done_storage[instance]);
+#else
+        s_i2c_done[instance] = xSemaphoreCreateBinary();
+#endif
+        if (s_i2c_done[instance] == NULL) {
+            DA7281_LOG_ERROR("Failed to create I2C completion semaphore for TWI%d", instance);
+            return DA7281_ERROR_MUTEX_FAILED;
+        }
+    }
+#endif
+    return DA7281_OK;
+}
+
+/**
+ * @brief TWI driver event handler (interrupt context)
+ *
+ * @param p_event Driver event
+ * @param p_context Instance number registered in da7281_nrf_init()
+ */
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+static void da7281_nrf_event_handler(nrfx_twim_evt_t const *p_event, void *p_context)
+{
+    da7281_bus_event(*(const uint8_t *)p_context, p_event->type == NRFX_TWIM_EVT_DONE);
+}
+#else
+static void da7281_nrf_event_handler(nrf_drv_twi_evt_t const *p_event, void *p_context)
+{
+    da7281_bus_event(*(const uint8_t *)p_context, p_event->type == NRF_DRV_TWI_EVT_DONE);
+}
+#endif
+
+/**
+ * @brief Interrupt task: serve the nIRQ lines each time an edge wakes it
+ *
+ * @param p_arg Unused
+ */
+static void da7281_nrf_irq_task(void *p_arg)
+{
+    (void)p_arg;
+
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        da7281_irq_service();
+    }
+}
+
+/**
+ * @brief GPIOTE event handler (interrupt context)
+ *
+ * @param pin Input that saw the falling edge
+ * @param action Polarity of the event (always HITOLO)
+ */
+static void da7281_nrf_gpiote_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+    (void)action;
+    da7281_bus_pin_event((uint8_t)pin);
+}
+
+/**
+ * @brief Create the interrupt task if it does not exist yet
+ *
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_MUTEX_FAILED if the task cannot be created (heap build only)
+ */
+static da7281_error_t da7281_nrf_init_irq_task(void)
+{
+    if (s_irq_task != NULL) {
+        return DA7281_OK;
+    }
+
+#if DA7281_STATIC_ALLOCATION
+    s_irq_task = xTaskCreateStatic(da7281_nrf_irq_task, "da7281_irq", DA7281_IRQ_TASK_STACK_WORDS,
+                                   NULL, DA7281_IRQ_TASK_PRIORITY, s_irq_task_stack, &s_irq_task_storage);
+#else
+    if (xTaskCreate(da7281_nrf_irq_task, "da7281_irq", DA7281_IRQ_TASK_STACK_WORDS,
+                    NULL, DA7281_IRQ_TASK_PRIORITY, &s_irq_task) != pdPASS) {
+        s_irq_task = NULL;
+    }
+#endif
+    if (s_irq_task == NULL) {
+        DA7281_LOG_ERROR("Failed to create nIRQ task - insufficient heap memory");
+        return DA7281_ERROR_MUTEX_FAILED;
+    }
+
+    return DA7281_OK;
+}
+
+/* ========================================================================
+ * Bus Operations
+ * ======================================================================== */
+
+/**
+ * @brief Create the lock objects and initialize the TWI hardware instance
+ *
+ * Configuration:
+ * - Frequency: 400 kHz (Fast Mode)
+ * - Interrupt priority: High
+ * - Event handler: da7281_nrf_event_handler (non-blocking transfers)
+ * - Driver: nrf_drv_twi, or nrfx_twim with DA7281_I2C_BACKEND_TWIM
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param scl_pin GPIO pin number for SCL
+ * @param sda_pin GPIO pin number for SDA
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex creation fails (heap build only)
+ * @return DA7281_ERROR_I2C_WRITE if TWI initialization fails
+ */
+static da7281_error_t da7281_nrf_init(uint8_t instance, uint8_t scl_pin, uint8_t sda_pin)
+{
+    da7281_error_t err = da7281_nrf_init_mutex(instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+    /* TWIM configuration with application-specified pins */
+    const nrfx_twim_config_t twi_config = {
+        .scl = scl_pin,
+        .sda = sda_pin,
+        .frequency = NRF_TWIM_FREQ_400K,
+        .interrupt_priority = APP_IRQ_PRIORITY_HIGH,
+        .hold_bus_uninit = false
+    };
+
+    DA7281_LOG_DEBUG("Initializing TWIM%d (EasyDMA): SCL=P0.%lu, SDA=P0.%lu, freq=400kHz",
+                     instance, (unsigned long)twi_config.scl, (unsigned long)twi_config.sda);
+
+    /* Event handler makes nrfx_twim_xfer() non-blocking */
+    nrfx_err_t err_code = nrfx_twim_init(&s_twim_instances[instance],
+                                         &twi_config,
+                                         da7281_nrf_event_handler,
+                                         (void *)&s_instance_ids[instance]);
+    if (err_code != NRFX_SUCCESS) {
+        DA7281_LOG_ERROR("TWIM%d init failed with error code: 0x%08lX", instance, (unsigned long)err_code);
+        return DA7281_ERROR_I2C_WRITE;
+    }
+
+    nrfx_twim_enable(&s_twim_instances[instance]);
+#else
+    /* TWI configuration with application-specified pins */
+    const nrf_drv_twi_config_t twi_config = {
+        .scl = scl_pin,
+        .sda = sda_pin,
+        .frequency = NRF_DRV_TWI_FREQ_400K,
+        .interrupt_priority = APP_IRQ_PRIORITY_HIGH,
+        .clear_bus_init = false
+    };
+
+    DA7281_LOG_DEBUG("Initializing TWI%d: SCL=P0.%lu, SDA=P0.%lu, freq=400kHz",
+                     instance, (unsigned long)twi_config.scl, (unsigned long)twi_config.sda);
+
+    /* Event handler makes nrf_drv_twi_xfer() non-blocking */
+    ret_code_t err_code = nrf_drv_twi_init(&s_twi_instances[instance],
+                                            &twi_config,
+                                            da7281_nrf_event_handler,
+                                            (void *)&s_instance_ids[instance]);
+    if (err_code != NRF_SUCCESS) {
+        DA7281_LOG_ERROR("TWI%d init failed with error code: 0x%08lX", instance, (unsigned long)err_code);
+        return DA7281_ERROR_I2C_WRITE;
+    }
+
+    nrf_drv_twi_enable(&s_twi_instances[instance]);
+#endif
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Start one frame on the TWI peripheral
+ *
+ * Writes go out as one TX job, reads as a TXRX pair (register pointer,
+ * repeated START, data). With the TWIM backend each descriptor is a single
+ * EasyDMA job (TXRX uses the LASTTX_STARTRX shortcut), so the CPU only runs
+ * here and in the end interrupt.
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param frame Frame to start (buffers must be in RAM for EasyDMA)
+ * @return DA7281_OK if started
+ * @return DA7281_ERROR_I2C_WRITE / DA7281_ERROR_I2C_READ if the driver refused it
+ */
+static da7281_error_t da7281_nrf_transfer(uint8_t instance, const da7281_bus_frame_t *frame)
+{
+    bool started;
+
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+    nrfx_twim_xfer_desc_t desc_rx = NRFX_TWIM_XFER_DESC_TXRX(frame->address, (uint8_t *)frame->tx,
+                                                             frame->tx_len, frame->rx, frame->rx_len);
+    nrfx_twim_xfer_desc_t desc_tx = NRFX_TWIM_XFER_DESC_TX(frame->address, (uint8_t *)frame->tx,
+                                                           frame->tx_len);
+    nrfx_err_t ret = nrfx_twim_xfer(&s_twim_instances[instance],
+                                    (frame->rx != NULL) ? &desc_rx : &desc_tx,
+                                    frame->no_stop ? NRFX_TWIM_FLAG_TX_NO_STOP : 0U);
+    started = (ret == NRFX_SUCCESS);
+#else
+    nrf_drv_twi_xfer_desc_t desc_rx = NRF_DRV_TWI_XFER_DESC_TXRX(frame->address, (uint8_t *)frame->tx,
+                                                                 (uint8_t)frame->tx_len, frame->rx,
+                                                                 (uint8_t)frame->rx_len);
+    nrf_drv_twi_xfer_desc_t desc_tx = NRF_DRV_TWI_XFER_DESC_TX(frame->address, (uint8_t *)frame->tx,
+                                                               (uint8_t)frame->tx_len);
+    ret_code_t ret = nrf_drv_twi_xfer(&s_twi_instances[instance],
+                                      (frame->rx != NULL) ? &desc_rx : &desc_tx,
+                                      frame->no_stop ? NRF_DRV_TWI_FLAG_TX_NO_STOP : 0U);
+    started = (ret == NRF_SUCCESS);
+#endif
+
+    if (!started) {
+        DA7281_LOG_ERROR("TWI%d transfer start failed: addr=0x%02X, err=0x%08lX",
+                         instance, frame->address, (unsigned long)ret);
+        return (frame->rx != NULL) ? DA7281_ERROR_I2C_READ : DA7281_ERROR_I2C_WRITE;
+    }
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Lock the bus according to DA7281_BUS_LOCK
+ *
+ * MUTEX takes the per-bus mutex, CRITICAL suspends the scheduler, NONE
+ * compiles to nothing.
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ */
+static da7281_error_t da7281_nrf_lock(uint8_t instance)
+{
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_MUTEX)
+    /* Take mutex with timeout (per-bus mutex for parallel access to different buses) */
+    if (xSemaphoreTake(s_i2c_mutex[instance], DA7281_MUTEX_TIMEOUT_TICKS) != pdTRUE) {
+        DA7281_LOG_ERROR("Failed to acquire I2C mutex for TWI%d (timeout after %d ms)",
+                         instance, DA7281_I2C_TIMEOUT_MS);
+        return DA7281_ERROR_MUTEX_FAILED;
+    }
+#elif (DA7281_BUS_LOCK == DA7281_BUS_LOCK_CRITICAL)
+    (void)instance;
+    vTaskSuspendAll();  /* No task switch; TWI interrupt still runs */
+#else
+    (void)instance;     /* Single owner per bus */
+#endif
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Unlock the bus locked by da7281_nrf_lock()
+ *
+ * @param instance TWI instance number (0 or 1)
+ */
+static void da7281_nrf_unlock(uint8_t instance)
+{
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_MUTEX)
+    xSemaphoreGive(s_i2c_mutex[instance]);
+#elif (DA7281_BUS_LOCK == DA7281_BUS_LOCK_CRITICAL)
+    (void)instance;
+    (void)xTaskResumeAll();
+#else
+    (void)instance;
+#endif
+}
+
+/**
+ * @brief Wait for the completion signal of a blocking call
+ *
+ * Sleeps on the completion semaphore, except in DA7281_BUS_LOCK_CRITICAL
+ * mode where the scheduler is suspended and the caller has to spin
+ * (bounded by DA7281_I2C_SPIN_LIMIT instead of timeout_ms).
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param timeout_ms Maximum wait (0 = only consume a pending signal)
+ * @return DA7281_OK if signalled
+ * @return DA7281_ERROR_TIMEOUT otherwise
+ */
+static da7281_error_t da7281_nrf_wait(uint8_t instance, uint32_t timeout_ms)
+{
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_CRITICAL)
+    uint32_t limit = (timeout_ms == 0U) ? 1U : DA7281_I2C_SPIN_LIMIT;
+
+    for (uint32_t spins = 0; !s_i2c_signalled[instance]; spins++) {
+        if (spins >= limit) {
+            return DA7281_ERROR_TIMEOUT;
+        }
+    }
+    s_i2c_signalled[instance] = false;
+    return DA7281_OK;
+#else
+    if (xSemaphoreTake(s_i2c_done[instance], pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        return DA7281_ERROR_TIMEOUT;
+    }
+    return DA7281_OK;
+#endif
+}
+
+/**
+ * @brief Wake the task blocked in da7281_nrf_wait() (interrupt context)
+ *
+ * @param instance TWI instance number (0 or 1)
+ */
+static void da7281_nrf_signal(uint8_t instance)
+{
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_CRITICAL)
+    s_i2c_signalled[instance] = true;
+#else
+    BaseType_t woken = pdFALSE;
+    (void)xSemaphoreGiveFromISR(s_i2c_done[instance], &woken);
+    portYIELD_FROM_ISR(woken);
+#endif
+}
+
+/**
+ * @brief Enter an SDK critical region (masks the TWI interrupt)
+ *
+ * @return Nesting state for da7281_nrf_irq_unlock()
+ */
+static uint32_t da7281_nrf_irq_lock(void)
+{
+    uint8_t nested = 0U;
+    app_util_critical_region_enter(&nested);
+    return nested;
+}
+
+/**
+ * @brief Leave the critical region entered by da7281_nrf_irq_lock()
+ *
+ * @param state Nesting state returned by da7281_nrf_irq_lock()
+ */
+static void da7281_nrf_irq_unlock(uint32_t state)
+{
+    app_util_critical_region_exit((uint8_t)state);
+}
+
+/**
+ * @brief Sleep the calling task
+ *
+ * @param ms Delay in milliseconds
+ */
+static void da7281_nrf_delay(uint32_t ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+/**
+ * @brief Monotonic time from a free-running 1 MHz TIMER (DA7281_NOW_TIMER)
+ *
+ * Started by the first call. Capture and read form one critical region,
+ * so a task and the TWI interrupt cannot overwrite each other's CC value.
+ * No RTOS call: safe from interrupts and with the scheduler suspended.
+ *
+ * @return Time in microseconds
+ */
+static uint32_t da7281_nrf_now(void)
+{
+    static bool started = false;
+    uint8_t nested = 0U;
+
+    app_util_critical_region_enter(&nested);
+    if (!started) {
+        nrf_timer_mode_set(DA7281_NOW_TIMER, NRF_TIMER_MODE_TIMER);
+        nrf_timer_bit_width_set(DA7281_NOW_TIMER, NRF_TIMER_BIT_WIDTH_32);
+        nrf_timer_frequency_set(DA7281_NOW_TIMER, NRF_TIMER_FREQ_1MHz);
+        nrf_timer_task_trigger(DA7281_NOW_TIMER, NRF_TIMER_TASK_CLEAR);
+        nrf_timer_task_trigger(DA7281_NOW_TIMER, NRF_TIMER_TASK_START);
+        started = true;
+    }
+    nrf_timer_task_trigger(DA7281_NOW_TIMER, nrf_timer_capture_task_get(NRF_TIMER_CC_CHANNEL0));
+    uint32_t now = nrf_timer_cc_read(DA7281_NOW_TIMER, NRF_TIMER_CC_CHANNEL0);
+    app_util_critical_region_exit(nested);
+
+    return now;
+}
+
+/** Owner identity of handler mode (never a task handle) */
+static uint8_t s_isr_self;
+
+/**
+ * @brief Identity of the calling context
+ *
+ * Completion callbacks run in the TWI interrupt, where the current task
+ * handle is the interrupted task; they get their own identity so that
+ * they never pass for the owner of its bus session.
+ *
+ * @return TaskHandle_t of the current task, or a handler-mode sentinel
+ */
+static void *da7281_nrf_self(void)
+{
+    if (__get_IPSR() != 0U) {
+        return (void *)&s_isr_self;
+    }
+    return (void *)xTaskGetCurrentTaskHandle();
+}
+
+/**
+ * @brief Arm or disarm the falling-edge interrupt of an nIRQ input
+ *
+ * Uses a GPIOTE IN event (one of eight channels) rather than PORT
+ * sensing, so the edge raises the interrupt directly. The internal
+ * pull-up holds the open-drain line high; an external one may replace it.
+ *
+ * @param pin GPIO number (P1 pins from 32)
+ * @param enable true to arm
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_MUTEX_FAILED if the interrupt task cannot be created
+ * @return DA7281_ERROR_INVALID_PARAM if GPIOTE refuses the pin (in use, no free channel)
+ */
+static da7281_error_t da7281_nrf_pin_irq(uint8_t pin, bool enable)
+{
+    if (!enable) {
+        nrf_drv_gpiote_in_event_disable(pin);
+        nrf_drv_gpiote_in_uninit(pin);
+        return DA7281_OK;
+    }
+
+    da7281_error_t err = da7281_nrf_init_irq_task();
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    ret_code_t ret = NRF_SUCCESS;
+    if (!nrf_drv_gpiote_is_init()) {
+        ret = nrf_drv_gpiote_init();
+    }
+    if (ret == NRF_SUCCESS) {
+        nrf_drv_gpiote_in_config_t config = GPIOTE_CONFIG_IN_SENSE_HITOLO(true);
+        config.pull = NRF_GPIO_PIN_PULLUP;
+        ret = nrf_drv_gpiote_in_init(pin, &config, da7281_nrf_gpiote_handler);
+    }
+    if (ret != NRF_SUCCESS) {
+        DA7281_LOG_ERROR("GPIOTE init failed for pin %u: err=0x%08lX", pin, (unsigned long)ret);
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    nrf_drv_gpiote_in_event_enable(pin, true);
+    return DA7281_OK;
+}
+
+/**
+ * @brief Level of an nIRQ input
+ *
+ * @param pin GPIO number
+ * @return true while the line is low
+ */
+static bool da7281_nrf_pin_asserted(uint8_t pin)
+{
+    return !nrf_drv_gpiote_in_is_set(pin);
+}
+
+/**
+ * @brief Wake the interrupt task (interrupt context, or a task)
+ */
+static void da7281_nrf_defer(void)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_irq_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/** nRF52 / FreeRTOS bus backend */
+const da7281_bus_ops_t da7281_bus_ops_nrf = {
+    .init = da7281_nrf_init,
+    .transfer = da7281_nrf_transfer,
+    .lock = da7281_nrf_lock,
+    .unlock = da7281_nrf_unlock,
+    .wait = da7281_nrf_wait,
+    .signal = da7281_nrf_signal,
+    .irq_lock = da7281_nrf_irq_lock,
+    .irq_unlock = da7281_nrf_irq_unlock,
+    .delay = da7281_nrf_delay,
+    .now = da7281_nrf_now,
+    .self = da7281_nrf_self,
+    .pin_irq = da7281_nrf_pin_irq,
+    .pin_asserted = da7281_nrf_pin_asserted,
+    .defer = da7281_nrf_defer
+};
+
+/* ========================================================================
+ * Public Functions
+ * ======================================================================== */
+
+/**
+ * @brief Completion callback that wakes the task passed as context
+ *
+ * Example:
+ *   da7281_write_register_async(&dev, reg, val, da7281_xfer_notify_task,
+ *                               xTaskGetCurrentTaskHandle());
+ *   ... other work ...
+ *   ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+ *
+ * @param device Device the transfer was issued for (unused)
+ * @param result Transfer result (unused)
+ * @param context TaskHandle_t of the task to notify
+ */
+void da7281_xfer_notify_task(da7281_device_t *device, da7281_error_t result, void *context)
+{
+    BaseType_t woken = pdFALSE;
+
+    (void)device;
+    (void)result;
+
+    if (context != NULL) {
+        vTaskNotifyGiveFromISR((TaskHandle_t)context, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
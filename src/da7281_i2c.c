@@ -4,39 +4,71 @@
  * @author A. R. Ansari
  * @date 2024-11-21
  *
- * Thread-safe I2C communication functions for DA7281 using
- * Qorvo SDK TWI driver with FreeRTOS mutex protection.
+ * Thread-safe I2C communication functions for DA7281. Hardware and RTOS
+ * access goes through the bus backend in da7281_bus.h (nRF52/FreeRTOS or
+ * host), so this layer builds and runs natively as well.
  *
- * NOTE: Nordic nrf_drv_twi API expects 7-bit I2C addresses (0x48..0x4B).
- *       The R/W bit is handled internally by the driver. Do not left-shift addresses.
+ * Transfers are interrupt driven: each TWI bus owns a small queue that is
+ * started by the submitter and advanced from the backend's completion
+ * event, so the CPU is free while bytes are clocked out. The blocking API
+ * submits to the same queue and waits on the backend until the completion.
  */
 
+/** Binary log file number (DA7281_LOG_BACKEND 4) */
+#define DA7281_LOG_FILE_ID (2U)
+
 #include "da7281.h"
-#include "nrf_drv_twi.h"
-#include "FreeRTOS.h"
-#include "semphr.h"
-#include "nrf_gpio.h"
+#include "da7281_bus.h"
 #include <string.h>
 
 /* ========================================================================
  * Private Variables
  * ======================================================================== */
 
-/** FreeRTOS mutex for thread-safe I2C access (one per TWI bus) */
-static SemaphoreHandle_t s_i2c_mutex[2] = {NULL, NULL};
-
-/** TWI instance handles (only instantiate enabled instances) */
-static nrf_drv_twi_t s_twi_instances[2] = {
-#if (defined(NRFX_TWIM0_ENABLED) && NRFX_CHECK(NRFX_TWIM0_ENABLED)) || (defined(NRFX_TWI0_ENABLED) && NRFX_CHECK(NRFX_TWI0_ENABLED))
-    NRF_DRV_TWI_INSTANCE(0),
+/** Active bus backend */
+#if (DA7281_PLATFORM == DA7281_PLATFORM_HOST)
+static const da7281_bus_ops_t *s_ops = &da7281_bus_ops_host;
 #else
-    {0},
+static const da7281_bus_ops_t *s_ops = &da7281_bus_ops_nrf;
 #endif
-#if (defined(NRFX_TWIM1_ENABLED) && NRFX_CHECK(NRFX_TWIM1_ENABLED)) || (defined(NRFX_TWI1_ENABLED) && NRFX_CHECK(NRFX_TWI1_ENABLED))
-    NRF_DRV_TWI_INSTANCE(1)
-#else
-    {0}
+
+/** One queued transfer */
+typedef struct {
+    da7281_device_t *device;        /**< Target device */
+    const uint8_t *tx;              /**< Burst write source (NULL = single byte in value) */
+    uint8_t *rx;                    /**< Read destination (NULL = write transfer) */
+    uint8_t reg;                    /**< First register address */
+    uint8_t len;                    /**< Number of data bytes */
+    uint8_t value;                  /**< Payload of a single-byte write */
+    bool no_stop;                   /**< Chain into the next queued write with a repeated START */
+    bool cancelled;                 /**< Abandoned before it started: never goes on the bus */
+    da7281_xfer_cb_t callback;      /**< Completion callback (may be NULL) */
+    void *context;                  /**< User pointer for the callback */
+} da7281_xfer_t;
+
+/** Per-bus transfer queue, advanced from the TWI event handler */
+typedef struct {
+    da7281_xfer_t queue[DA7281_I2C_QUEUE_DEPTH];    /**< Ring buffer, queue[head] is in flight */
+    uint8_t head;                                   /**< Index of the oldest entry */
+    uint8_t count;                                  /**< Entries queued (0 = bus idle) */
+    uint8_t instance;                               /**< TWI instance number */
+    uint8_t frame[1U + DA7281_I2C_MAX_BURST_LEN];   /**< [register, data...] of the transfer in flight */
+    uint8_t sync_buf[DA7281_I2C_MAX_BURST_LEN];     /**< Read bounce buffer for blocking calls */
+    uint8_t sync_tx[DA7281_I2C_MAX_BURST_LEN];      /**< Write bounce buffer for blocking calls */
+    volatile da7281_error_t sync_result;            /**< Result of the last blocking call */
+    void *session_owner;                            /**< Task inside da7281_bus_begin() (NULL = none) */
+    uint8_t session_depth;                          /**< Nested da7281_bus_begin() calls */
+    volatile uint8_t chain_left;                    /**< Writes of a blocking chain still queued */
+    volatile da7281_error_t chain_result;           /**< First error of a blocking chain */
+#if DA7281_ENABLE_STATS
+    uint32_t frame_start;                           /**< now() when queue[head] went on the bus */
 #endif
+} da7281_bus_t;
+
+/** Transfer queues (one per TWI bus) */
+static da7281_bus_t s_bus[2] = {
+    {.instance = 0},
+    {.instance = 1}
 };
 
 /** TWI initialization status */
@@ -52,113 +84,808 @@ static struct {
     {0, 0, false}   /* TWI1 - not configured */
 };
 
+/**
+ * Register attribute table (DA7281 Datasheet v3.1, Table 20).
+ * Addresses not listed are reserved and get no attributes (never cached).
+ * The SNP memory window 0x84-0xE7 is handled in da7281_reg_attr().
+ */
+static const uint8_t s_reg_attr[DA7281_REG_SNP_MEM_BASE] = {
+    [DA7281_REG_CHIP_REV]                 = DA7281_REG_ATTR_CACHEABLE | DA7281_REG_ATTR_READ_ONLY,
+    [DA7281_REG_IRQ_EVENT1]               = DA7281_REG_ATTR_VOLATILE,
+    [DA7281_REG_IRQ_EVENT_WARNING_DIAG]   = DA7281_REG_ATTR_VOLATILE | DA7281_REG_ATTR_READ_ONLY,
+    [DA7281_REG_IRQ_EVENT_SEQ_DIAG]       = DA7281_REG_ATTR_VOLATILE | DA7281_REG_ATTR_READ_ONLY,
+    [DA7281_REG_IRQ_STATUS1]              = DA7281_REG_ATTR_VOLATILE | DA7281_REG_ATTR_READ_ONLY,
+    [DA7281_REG_IRQ_MASK1]                = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_CIF_I2C1]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_CIF_I2C2]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_LRA_PER_H]                = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_LRA_PER_L]                = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_ACTUATOR_NOMMAX]          = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_ACTUATOR_ABSMAX]          = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_ACTUATOR_IMAX]            = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_V2I_FACTOR_H]             = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_V2I_FACTOR_L]             = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_CALIB_IMP_H]              = DA7281_REG_ATTR_VOLATILE,   /* Updated by calibration */
+    [DA7281_REG_CALIB_IMP_L]              = DA7281_REG_ATTR_VOLATILE,
+    [DA7281_REG_TOP_CFG1]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_CFG2]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_CFG3]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_CFG4]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_INT_CFG1]             = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_INT_CFG6_H]           = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_INT_CFG6_L]           = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_INT_CFG7_H]           = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_INT_CFG7_L]           = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_INT_CFG8]             = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_CTL1]                 = DA7281_REG_ATTR_CACHEABLE | DA7281_REG_ATTR_NO_BURST,  /* SEQ_START self-clears */
+    [DA7281_REG_TOP_CTL2]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_SEQ_CTL1]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_SEQ_CTL2]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_GPI_CTL]                  = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_MEM_CTL1]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_MEM_CTL2]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_POLARITY]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_TOP_CFG5]                 = DA7281_REG_ATTR_CACHEABLE,
+    [DA7281_REG_IRQ_EVENT_ACTUATOR_FAULT] = DA7281_REG_ATTR_VOLATILE,
+    [DA7281_REG_IRQ_STATUS2]              = DA7281_REG_ATTR_VOLATILE | DA7281_REG_ATTR_READ_ONLY,
+    [DA7281_REG_IRQ_MASK2]                = DA7281_REG_ATTR_CACHEABLE,
+};
+
+#if DA7281_ENABLE_STATS
+/** Transfer statistics, updated from task and completion context */
+static da7281_stats_t s_stats;
+#endif
+
 /* ========================================================================
  * Private Function Prototypes
  * ======================================================================== */
 
-static da7281_error_t da7281_i2c_init_mutex(uint8_t instance);
-static da7281_error_t da7281_i2c_init_twi(uint8_t instance);
+static da7281_error_t da7281_i2c_wait(da7281_bus_t *bus);
+static void da7281_xfer_abandon(da7281_bus_t *bus);
+static bool da7281_i2c_in_session(const da7281_bus_t *bus);
+static da7281_error_t da7281_xfer_submit(const da7281_xfer_t *xfer);
+static da7281_error_t da7281_xfer_submit_chain(da7281_bus_t *bus, const da7281_xfer_t *chain,
+                                               uint8_t count);
+static void da7281_xfer_start(da7281_bus_t *bus);
+static void da7281_xfer_complete(da7281_bus_t *bus, bool success);
+static void da7281_xfer_sync_done(da7281_device_t *device, da7281_error_t result, void *context);
+static void da7281_xfer_chain_step(da7281_device_t *device, da7281_error_t result, void *context);
+static da7281_error_t da7281_i2c_transfer(da7281_xfer_t *xfer);
+static da7281_error_t da7281_xfer_run_multi(da7281_xfer_t chain[2][DA7281_I2C_QUEUE_DEPTH],
+                                            const uint8_t chain_len[2],
+                                            da7281_error_t bus_err[2]);
+static void da7281_cache_store(da7281_device_t *device, uint8_t reg_addr,
+                               const uint8_t *values, uint8_t len);
+static void da7281_cache_drop(da7281_device_t *device, uint8_t reg_addr, uint8_t len);
+static uint8_t da7281_diff_next(const bool *changed, uint8_t len, uint8_t *pos);
+#if DA7281_ENABLE_STATS
+static void da7281_stats_lock(uint8_t instance, const da7281_device_t *device,
+                              uint32_t t0, da7281_error_t err);
+static void da7281_stats_frame(da7281_bus_t *bus, const da7281_xfer_t *xfer, bool success);
+static void da7281_stats_timeout(uint8_t instance, const da7281_device_t *device);
+#endif
 
 /* ========================================================================
  * Private Function Implementations
  * ======================================================================== */
 
 /**
- * @brief Initialize I2C mutex for thread-safe operation (per TWI bus)
+ * @brief Check whether the calling task holds a bus session
  *
- * Creates a FreeRTOS mutex to protect I2C bus access from concurrent threads.
- * Each TWI bus has its own mutex to allow parallel access to different buses.
+ * Inside a session the bus lock is already held, so register accesses
+ * skip their own lock/unlock.
  *
- * @param instance TWI instance number (0 or 1)
- * @return DA7281_OK on success
- * @return DA7281_ERROR_MUTEX_FAILED if mutex creation fails
+ * @param bus Bus queue
+ * @return true if the current task opened a session on this bus
  */
-static da7281_error_t da7281_i2c_init_mutex(uint8_t instance)
+static bool da7281_i2c_in_session(const da7281_bus_t *bus)
 {
-    if (instance >= 2) {
-        return DA7281_ERROR_INVALID_PARAM;
+    return (bus->session_depth != 0U) && (bus->session_owner == s_ops->self());
+}
+
+/**
+ * @brief Wait for the blocking transfer submitted by da7281_i2c_transfer()
+ *
+ * On timeout the call's transfers are abandoned (da7281_xfer_abandon()).
+ *
+ * @param bus Bus queue
+ * @return Transfer result, or DA7281_ERROR_TIMEOUT
+ */
+static da7281_error_t da7281_i2c_wait(da7281_bus_t *bus)
+{
+    if (s_ops->wait(bus->instance, DA7281_I2C_TIMEOUT_MS) != DA7281_OK) {
+        da7281_xfer_abandon(bus);
+        return DA7281_ERROR_TIMEOUT;
     }
+    return bus->sync_result;
+}
+
+/**
+ * @brief Detach the queued transfers of a timed-out blocking call
+ *
+ * Their completions must not wake, or hand a result to, the next
+ * blocking call on the bus. Each entry loses its callback; entries that
+ * have not started are cancelled and never go on the bus. The one in
+ * flight still completes: if it is a read, its data lands in sync_buf
+ * before any later frame of the bus runs, so only the write bounce
+ * buffer (sync_tx) could be overwritten early, and reads never use it.
+ * If it is a no_stop write, the chain after it still goes out up to its
+ * last entry, whose STOP releases the bus (a cancelled successor would
+ * leave the frame open). A completion signalled before this runs is
+ * drained by the next call.
+ *
+ * @param bus Bus queue
+ */
+static void da7281_xfer_abandon(da7281_bus_t *bus)
+{
+    bool on_bus = true;     /* queue[head] is in flight */
 
-    if (s_i2c_mutex[instance] == NULL) {
-        s_i2c_mutex[instance] = xSemaphoreCreateMutex();
-        if (s_i2c_mutex[instance] == NULL) {
-            DA7281_LOG_ERROR("Failed to create I2C mutex for TWI%d - insufficient heap memory", instance);
-            return DA7281_ERROR_MUTEX_FAILED;
+    uint32_t irq = s_ops->irq_lock();
+    for (uint8_t i = 0; i < bus->count; i++) {
+        da7281_xfer_t *xfer = &bus->queue[(bus->head + i) % DA7281_I2C_QUEUE_DEPTH];
+        if ((xfer->context == bus) &&
+            ((xfer->callback == da7281_xfer_sync_done) || (xfer->callback == da7281_xfer_chain_step))) {
+            xfer->callback = NULL;
+            xfer->cancelled = !on_bus;
         }
-        DA7281_LOG_INFO("I2C mutex created successfully for TWI%d", instance);
+        /* Entries after an open (no_stop) frame belong to it */
+        on_bus = on_bus && xfer->no_stop;
+    }
+    s_ops->irq_unlock(irq);
+}
+
+/**
+ * @brief Append a transfer to its bus queue and start it if the bus is idle
+ *
+ * Safe to call from tasks and from completion callbacks. While another
+ * task holds a bus session the transfer is refused: it would land between
+ * that session's frames (e.g. between the read and the write of a
+ * read-modify-write). The check and the append are one critical section,
+ * and da7281_bus_begin() records its owner under the same lock, so an
+ * entry accepted just before a session opens is ahead of all its frames.
+ *
+ * @param xfer Transfer description (copied into the queue)
+ * @return DA7281_OK if queued
+ * @return DA7281_ERROR_NOT_INITIALIZED if da7281_bus_init() was not called
+ * @return DA7281_ERROR_BUSY if the queue is full or another task holds a
+ *         session on the bus
+ */
+static da7281_error_t da7281_xfer_submit(const da7281_xfer_t *xfer)
+{
+    uint8_t instance = xfer->device->twi_instance;
+
+#if DA7281_ENABLE_PARAM_CHECK
+    if ((instance >= 2U) || !s_twi_initialized[instance]) {
+        DA7281_LOG_ERROR("TWI%d not initialized - call da7281_bus_init() first", instance);
+        return DA7281_ERROR_NOT_INITIALIZED;
+    }
+#endif
+
+    da7281_bus_t *bus = &s_bus[instance];
+    void *self = s_ops->self();
+    bool idle;
+
+    uint32_t irq = s_ops->irq_lock();
+    if ((bus->session_depth != 0U) && (bus->session_owner != self)) {
+        s_ops->irq_unlock(irq);
+        DA7281_LOG_WARNING("TWI%d transfer refused: bus session held by another task", instance);
+        return DA7281_ERROR_BUSY;
+    }
+    if (bus->count >= DA7281_I2C_QUEUE_DEPTH) {
+        s_ops->irq_unlock(irq);
+        DA7281_LOG_WARNING("TWI%d transfer queue full (%u entries)", instance, DA7281_I2C_QUEUE_DEPTH);
+        return DA7281_ERROR_BUSY;
+    }
+    bus->queue[(bus->head + bus->count) % DA7281_I2C_QUEUE_DEPTH] = *xfer;
+    bus->count++;
+    idle = (bus->count == 1U);
+    s_ops->irq_unlock(irq);
+
+    /* Only the submitter that moves the queue from empty to non-empty starts the bus;
+     * otherwise the completion interrupt picks the entry up */
+    if (idle) {
+        da7281_xfer_start(bus);
+    }
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Append several transfers to a bus queue as one uninterrupted run
+ *
+ * Either all entries are queued back to back or none is, so entries
+ * flagged no_stop are always followed by their successor.
+ *
+ * @param bus Bus queue
+ * @param chain Transfers in bus order (copied into the queue)
+ * @param count Number of transfers
+ * @return DA7281_OK if queued
+ * @return DA7281_ERROR_BUSY if the queue cannot take all of them
+ */
+static da7281_error_t da7281_xfer_submit_chain(da7281_bus_t *bus, const da7281_xfer_t *chain,
+                                               uint8_t count)
+{
+    bool idle;
+
+    uint32_t irq = s_ops->irq_lock();
+    if ((bus->count + count) > DA7281_I2C_QUEUE_DEPTH) {
+        s_ops->irq_unlock(irq);
+        DA7281_LOG_WARNING("TWI%d transfer queue cannot take %u chained writes", bus->instance, count);
+        return DA7281_ERROR_BUSY;
     }
+    for (uint8_t i = 0; i < count; i++) {
+        bus->queue[(bus->head + bus->count) % DA7281_I2C_QUEUE_DEPTH] = chain[i];
+        bus->count++;
+    }
+    idle = (bus->count == count);
+    s_ops->irq_unlock(irq);
+
+    if (idle) {
+        da7281_xfer_start(bus);
+    }
+
     return DA7281_OK;
 }
 
 /**
- * @brief Initialize TWI (I2C) hardware instance
+ * @brief Put the transfer at the head of the queue on the bus
  *
- * Configures and enables the specified TWI peripheral for I2C communication.
- * Supports TWI0 and TWI1 for multi-device configurations.
+ * Writes go out as one frame [register, data...]. Reads write the
+ * register pointer, then read after a repeated START. If the backend
+ * refuses the frame, or the entry was cancelled by a timed-out blocking
+ * call, it is completed with an error straight away.
  *
- * Configuration:
- * - Pins: Must be configured via da7281_i2c_configure_pins() before first use
- * - Frequency: 400 kHz (Fast Mode)
- * - Interrupt priority: High
+ * The frame is always built in the bus RAM buffer (EasyDMA cannot read
+ * flash); read destinations must be RAM buffers.
  *
- * @param instance TWI instance number (0 or 1)
+ * A write flagged no_stop ends without STOP, so the next queued write
+ * begins with a repeated START and no other master can claim the bus in
+ * between.
+ *
+ * @param bus Bus queue with at least one entry
+ */
+static void da7281_xfer_start(da7281_bus_t *bus)
+{
+    const da7281_xfer_t *xfer = &bus->queue[bus->head];
+
+    if (xfer->cancelled) {
+        da7281_xfer_complete(bus, false);
+        return;
+    }
+
+    bus->frame[0] = xfer->reg;
+    if (xfer->rx == NULL) {
+        memcpy(&bus->frame[1], (xfer->tx != NULL) ? xfer->tx : &xfer->value, xfer->len);
+    }
+
+    da7281_bus_frame_t frame = {
+        .address = xfer->device->i2c_address,
+        .tx = bus->frame,
+        .tx_len = (xfer->rx != NULL) ? 1U : (uint16_t)(xfer->len + 1U),
+        .rx = xfer->rx,
+        .rx_len = (xfer->rx != NULL) ? xfer->len : 0U,
+        .no_stop = xfer->no_stop
+    };
+
+#if DA7281_ENABLE_STATS
+    bus->frame_start = s_ops->now();
+#endif
+    if (s_ops->transfer(bus->instance, &frame) != DA7281_OK) {
+        DA7281_LOG_ERROR("TWI%d transfer start failed: addr=0x%02X, reg=0x%02X",
+                         bus->instance, xfer->device->i2c_address, xfer->reg);
+        da7281_xfer_complete(bus, false);
+    }
+}
+
+/**
+ * @brief Finish the transfer at the head of the queue
+ *
+ * Updates the shadow cache, pops the entry, starts the next queued
+ * transfer so the bus does not idle, then runs the completion callback.
+ *
+ * @param bus Bus queue
+ * @param success true if the transfer was ACKed end to end
+ */
+static void da7281_xfer_complete(da7281_bus_t *bus, bool success)
+{
+    da7281_xfer_t xfer = bus->queue[bus->head];
+    da7281_error_t result = DA7281_OK;
+    bool more;
+    uint32_t irq;
+
+#if DA7281_ENABLE_STATS
+    if (!xfer.cancelled) {
+        da7281_stats_frame(bus, &xfer, success);
+    }
+#endif
+
+    if (xfer.rx != NULL) {
+        if (success) {
+            da7281_cache_store(xfer.device, xfer.reg, xfer.rx, xfer.len);
+        } else {
+            result = DA7281_ERROR_I2C_READ;
+        }
+    } else {
+        if (success) {
+            da7281_cache_store(xfer.device, xfer.reg,
+                               (xfer.tx != NULL) ? xfer.tx : &xfer.value, xfer.len);
+        } else {
+            da7281_cache_drop(xfer.device, xfer.reg, xfer.len);
+            result = DA7281_ERROR_I2C_WRITE;
+        }
+    }
+
+    irq = s_ops->irq_lock();
+    bus->head = (uint8_t)((bus->head + 1U) % DA7281_I2C_QUEUE_DEPTH);
+    bus->count--;
+    more = (bus->count != 0U);
+    s_ops->irq_unlock(irq);
+
+    if (more) {
+        da7281_xfer_start(bus);
+    }
+
+    if (xfer.callback != NULL) {
+        xfer.callback(xfer.device, result, xfer.context);
+    }
+}
+
+/**
+ * @brief Completion callback used by the blocking API
+ *
+ * @param device Device the transfer was issued for (unused)
+ * @param result Transfer result
+ * @param context Bus queue of the waiting task
+ */
+static void da7281_xfer_sync_done(da7281_device_t *device, da7281_error_t result, void *context)
+{
+    da7281_bus_t *bus = (da7281_bus_t *)context;
+
+    (void)device;
+    bus->sync_result = result;
+    s_ops->signal(bus->instance);
+}
+
+/**
+ * @brief Completion callback for each transfer of a blocking chain
+ *
+ * Keeps the first error and wakes the waiting task after the last one.
+ *
+ * @param device Device the transfer was issued for
+ * @param result Transfer result
+ * @param context Bus queue of the waiting task
+ */
+static void da7281_xfer_chain_step(da7281_device_t *device, da7281_error_t result, void *context)
+{
+    da7281_bus_t *bus = (da7281_bus_t *)context;
+
+    if ((result != DA7281_OK) && (bus->chain_result == DA7281_OK)) {
+        bus->chain_result = result;
+    }
+
+    bus->chain_left--;
+    if (bus->chain_left == 0U) {
+        da7281_xfer_sync_done(device, bus->chain_result, bus);
+    }
+}
+
+/**
+ * @brief Run one transfer through the queue and sleep until it completes
+ *
+ * Data goes through the bus bounce buffers so a timed-out transfer that
+ * completes late cannot touch the caller's stack. On timeout the transfer
+ * is abandoned (da7281_xfer_abandon()): a late completion neither wakes
+ * nor hands its result to the next blocking call. Read results are copied
+ * back to xfer->rx on success.
+ *
+ * @param xfer Transfer description (callback and context are overwritten)
  * @return DA7281_OK on success
- * @return DA7281_ERROR_INVALID_PARAM if instance >= 2 or pins not configured
- * @return DA7281_ERROR_I2C_WRITE if TWI initialization fails
+ * @return DA7281_ERROR_NOT_INITIALIZED if da7281_bus_init() was not called
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_TIMEOUT if the completion interrupt did not arrive
+ * @return DA7281_ERROR_I2C_WRITE / DA7281_ERROR_I2C_READ if the transfer failed
+ */
+static da7281_error_t da7281_i2c_transfer(da7281_xfer_t *xfer)
+{
+    uint8_t instance = xfer->device->twi_instance;
+    uint8_t *dest = xfer->rx;
+
+#if DA7281_ENABLE_PARAM_CHECK
+    if ((instance >= 2U) || !s_twi_initialized[instance]) {
+        DA7281_LOG_ERROR("TWI%d not initialized - call da7281_bus_init() first", instance);
+        return DA7281_ERROR_NOT_INITIALIZED;
+    }
+#endif
+
+    da7281_bus_t *bus = &s_bus[instance];
+    da7281_error_t err;
+
+    /* Inside da7281_bus_begin()/da7281_bus_end() the lock is already held */
+    bool locked = !da7281_i2c_in_session(bus);
+    if (locked) {
+#if DA7281_ENABLE_STATS
+        uint32_t t0 = s_ops->now();
+        err = s_ops->lock(instance);
+        da7281_stats_lock(instance, xfer->device, t0, err);
+#else
+        err = s_ops->lock(instance);
+#endif
+        if (err != DA7281_OK) {
+            return err;
+        }
+    }
+
+    /* Drop a completion left over from an earlier timed-out call */
+    (void)s_ops->wait(instance, 0U);
+
+    if (dest != NULL) {
+        xfer->rx = bus->sync_buf;
+    } else if (xfer->tx != NULL) {
+        memcpy(bus->sync_tx, xfer->tx, xfer->len);
+        xfer->tx = bus->sync_tx;
+    }
+    xfer->callback = da7281_xfer_sync_done;
+    xfer->context = bus;
+
+    err = da7281_xfer_submit(xfer);
+    if (err == DA7281_OK) {
+        err = da7281_i2c_wait(bus);
+        if (err == DA7281_ERROR_TIMEOUT) {
+            DA7281_LOG_ERROR("TWI%d transfer timeout after %d ms", instance, DA7281_I2C_TIMEOUT_MS);
+#if DA7281_ENABLE_STATS
+            da7281_stats_timeout(instance, xfer->device);
+#endif
+        }
+    }
+
+    if ((err == DA7281_OK) && (dest != NULL)) {
+        memcpy(dest, bus->sync_buf, xfer->len);
+    }
+
+    /* Release bus lock */
+    if (locked) {
+        s_ops->unlock(instance);
+    }
+
+    return err;
+}
+
+/**
+ * @brief Lock, start and wait for one chain of queued transfers per bus
  *
- * @note Call da7281_i2c_configure_pins() before using this function
+ * Buses are locked in bus order (TWI0 first, so two concurrent callers
+ * cannot deadlock) unless the calling task holds a session on them. Both
+ * chains are started before the task waits on either, so the two buses
+ * run in parallel. Every entry must complete through
+ * da7281_xfer_chain_step() with its bus as context; the last entry of a
+ * chain always ends with STOP.
+ *
+ * @param chain Transfers per bus, in bus order
+ * @param chain_len Entries per bus (0 = bus not used)
+ * @param bus_err Result per used bus; buses never started get the error that stopped the call
+ * @return DA7281_OK if every chain completed, else the first error
  */
-static da7281_error_t da7281_i2c_init_twi(uint8_t instance)
+static da7281_error_t da7281_xfer_run_multi(da7281_xfer_t chain[2][DA7281_I2C_QUEUE_DEPTH],
+                                            const uint8_t chain_len[2],
+                                            da7281_error_t bus_err[2])
 {
-    if (instance >= 2) {
-        DA7281_LOG_ERROR("Invalid TWI instance: %d (valid: 0-1)", instance);
-        return DA7281_ERROR_INVALID_PARAM;
+    da7281_error_t err = DA7281_OK;
+    bool locked[2] = {false, false};
+    bool started[2] = {false, false};
+
+    /* Lock in bus order so two concurrent multi-bus calls cannot deadlock */
+    for (uint8_t b = 0; (b < 2U) && (err == DA7281_OK); b++) {
+        if (chain_len[b] == 0U) {
+            continue;
+        }
+#if DA7281_ENABLE_PARAM_CHECK
+        if (!s_twi_initialized[b]) {
+            DA7281_LOG_ERROR("TWI%d not initialized - call da7281_bus_init() first", b);
+            err = DA7281_ERROR_NOT_INITIALIZED;
+            break;
+        }
+#endif
+        if (!da7281_i2c_in_session(&s_bus[b])) {
+#if DA7281_ENABLE_STATS
+            uint32_t t0 = s_ops->now();
+            err = s_ops->lock(b);
+            da7281_stats_lock(b, NULL, t0, err);
+#else
+            err = s_ops->lock(b);
+#endif
+            locked[b] = (err == DA7281_OK);
+        }
     }
 
-    if (s_twi_initialized[instance]) {
-        DA7281_LOG_DEBUG("TWI%d already initialized, skipping", instance);
-        return DA7281_OK;  /* Already initialized */
+    /* Start every bus before waiting on any of them */
+    for (uint8_t b = 0; (b < 2U) && (err == DA7281_OK); b++) {
+        if (chain_len[b] == 0U) {
+            continue;
+        }
+        da7281_bus_t *bus = &s_bus[b];
+
+        chain[b][chain_len[b] - 1U].no_stop = false;
+        (void)s_ops->wait(b, 0U);
+        bus->chain_left = chain_len[b];
+        bus->chain_result = DA7281_OK;
+
+        err = da7281_xfer_submit_chain(bus, chain[b], chain_len[b]);
+        started[b] = (err == DA7281_OK);
     }
 
-    /* Check if pins are configured */
-    if (!s_twi_pins[instance].configured) {
-        DA7281_LOG_ERROR("TWI%d pins not configured - call da7281_i2c_configure_pins() first", instance);
-        DA7281_LOG_ERROR("Application must specify SCL/SDA pins for the target hardware");
-        return DA7281_ERROR_INVALID_PARAM;
+    for (uint8_t b = 0; b < 2U; b++) {
+        bus_err[b] = err;
+        if (started[b]) {
+            bus_err[b] = da7281_i2c_wait(&s_bus[b]);
+#if DA7281_ENABLE_STATS
+            if (bus_err[b] == DA7281_ERROR_TIMEOUT) {
+                da7281_stats_timeout(b, NULL);
+            }
+#endif
+            if ((bus_err[b] != DA7281_OK) && (err == DA7281_OK)) {
+                err = bus_err[b];
+            }
+        }
     }
 
-    /* TWI configuration with application-specified pins */
-    const nrf_drv_twi_config_t twi_config = {
-        .scl = s_twi_pins[instance].scl,
-        .sda = s_twi_pins[instance].sda,
-        .frequency = NRF_DRV_TWI_FREQ_400K,
-        .interrupt_priority = APP_IRQ_PRIORITY_HIGH,
-        .clear_bus_init = false
-    };
+    for (uint8_t b = 2U; b > 0U; b--) {
+        if (locked[b - 1U]) {
+            s_ops->unlock(b - 1U);
+        }
+    }
 
-    DA7281_LOG_DEBUG("Initializing TWI%d: SCL=P0.%lu, SDA=P0.%lu, freq=400kHz",
-                     instance, (unsigned long)twi_config.scl, (unsigned long)twi_config.sda);
+    return err;
+}
 
-    ret_code_t err_code = nrf_drv_twi_init(&s_twi_instances[instance],
-                                            &twi_config,
-                                            NULL,
-                                            NULL);
-    if (err_code != NRF_SUCCESS) {
-        DA7281_LOG_ERROR("TWI%d init failed with error code: 0x%08lX", instance, (unsigned long)err_code);
-        return DA7281_ERROR_I2C_WRITE;
+/**
+ * @brief Update shadow copies after a successful transfer
+ *
+ * Only registers flagged DA7281_REG_ATTR_CACHEABLE are stored. Self-clearing
+ * command bits (TOP_CTL1.SEQ_START) are masked off so the shadow matches
+ * what a later read would return.
+ *
+ * @param device Pointer to device handle
+ * @param reg_addr First register written or read
+ * @param values Register values, values[i] belongs to reg_addr + i
+ * @param len Number of registers
+ */
+static void da7281_cache_store(da7281_device_t *device, uint8_t reg_addr,
+                               const uint8_t *values, uint8_t len)
+{
+    da7281_reg_cache_t *cache = device->cache;
+    if (cache == NULL) {
+        return;
     }
 
-    nrf_drv_twi_enable(&s_twi_instances[instance]);
-    s_twi_initialized[instance] = true;
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t reg = (uint16_t)reg_addr + i;
+        if ((reg >= DA7281_REG_CACHE_SIZE) ||
+            ((da7281_reg_attr((uint8_t)reg) & DA7281_REG_ATTR_CACHEABLE) == 0U)) {
+            continue;
+        }
 
-    DA7281_LOG_INFO("TWI%d initialized and enabled successfully", instance);
-    return DA7281_OK;
+        uint8_t value = values[i];
+        if (reg == DA7281_REG_TOP_CTL1) {
+            value &= (uint8_t)~DA7281_TOP_CTL1_SEQ_START;
+        }
+
+        cache->value[reg] = value;
+        cache->valid[reg / 8U] |= (uint8_t)(1U << (reg % 8U));
+    }
+}
+
+/**
+ * @brief Forget shadow copies whose chip state is unknown (failed write)
+ *
+ * @param device Pointer to device handle
+ * @param reg_addr First register
+ * @param len Number of registers
+ */
+static void da7281_cache_drop(da7281_device_t *device, uint8_t reg_addr, uint8_t len)
+{
+    da7281_reg_cache_t *cache = device->cache;
+    if (cache == NULL) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t reg = (uint16_t)reg_addr + i;
+        if (reg < DA7281_REG_CACHE_SIZE) {
+            cache->valid[reg / 8U] &= (uint8_t)~(1U << (reg % 8U));
+        }
+    }
+}
+
+/**
+ * @brief Find the next burst of a diff write
+ *
+ * A burst starts at a changed byte and ends at a changed byte; runs of at
+ * most DA7281_DIFF_MERGE_GAP unchanged bytes between two changes are
+ * written rather than paying for another frame.
+ *
+ * @param changed changed[i] is true when byte i must be written
+ * @param len Number of bytes
+ * @param pos In: first byte to look at; out: first byte of the burst
+ * @return Burst length, 0 when no changed byte is left
+ */
+static uint8_t da7281_diff_next(const bool *changed, uint8_t len, uint8_t *pos)
+{
+    uint8_t start = *pos;
+    while ((start < len) && !changed[start]) {
+        start++;
+    }
+    *pos = start;
+    if (start == len) {
+        return 0U;
+    }
+
+    uint8_t end = (uint8_t)(start + 1U);    /* One past the last changed byte */
+    for (uint8_t next = end; next < len; next++) {
+        if (changed[next]) {
+            end = (uint8_t)(next + 1U);
+        } else if ((uint8_t)(next - end) >= DA7281_DIFF_MERGE_GAP) {
+            break;
+        }
+    }
+
+    return (uint8_t)(end - start);
 }
 
+#if DA7281_ENABLE_STATS
+/**
+ * @brief Count a duration in its log2 histogram bucket
+ *
+ * Bucket 0 holds durations under 1 us, bucket k holds 2^(k-1) to
+ * 2^k - 1 us and the last bucket everything longer. Bins saturate.
+ *
+ * @param hist Histogram with DA7281_STATS_HIST_BUCKETS bins
+ * @param us Duration in microseconds
+ */
+static void da7281_stats_hist(uint16_t *hist, uint32_t us)
+{
+    uint8_t bucket = 0U;
+    while ((us != 0U) && (bucket < (DA7281_STATS_HIST_BUCKETS - 1U))) {
+        us >>= 1;
+        bucket++;
+    }
+    if (hist[bucket] != UINT16_MAX) {
+        hist[bucket]++;
+    }
+}
+
+/**
+ * @brief Counters of a device address, or NULL outside 0x48..0x4B
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param device Device handle (NULL = none)
+ */
+static da7281_stats_counters_t *da7281_stats_device(uint8_t instance, const da7281_device_t *device)
+{
+    if ((device == NULL) || (device->i2c_address < DA7281_I2C_ADDR_0x48) ||
+        (device->i2c_address > DA7281_I2C_ADDR_0x4B)) {
+        return NULL;
+    }
+    return &s_stats.device[instance][device->i2c_address - DA7281_I2C_ADDR_0x48];
+}
+
+/**
+ * @brief Account one bus lock attempt (task context)
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param device Device of the access (NULL for sessions and multi-writes)
+ * @param t0 now() before the lock attempt
+ * @param err Result of the lock attempt
+ */
+static void da7281_stats_lock(uint8_t instance, const da7281_device_t *device,
+                              uint32_t t0, da7281_error_t err)
+{
+    uint32_t waited = s_ops->now() - t0;
+    da7281_stats_counters_t *counters[2] = {&s_stats.bus[instance], da7281_stats_device(instance, device)};
+
+    uint32_t irq = s_ops->irq_lock();
+    for (uint8_t i = 0; i < 2U; i++) {
+        da7281_stats_counters_t *c = counters[i];
+        if (c == NULL) {
+            continue;
+        }
+        if (err != DA7281_OK) {
+            c->lock_timeouts++;
+        }
+        c->lock_wait_us += waited;
+        da7281_stats_hist(c->lock_wait_hist, waited);
+    }
+    s_ops->irq_unlock(irq);
+}
+
+/**
+ * @brief Account the frame at the head of the queue (completion context)
+ *
+ * @param bus Bus queue
+ * @param xfer Finished transfer
+ * @param success true if the frame was ACKed end to end
+ */
+static void da7281_stats_frame(da7281_bus_t *bus, const da7281_xfer_t *xfer, bool success)
+{
+    uint32_t elapsed = s_ops->now() - bus->frame_start;
+    da7281_stats_counters_t *counters[2] = {&s_stats.bus[bus->instance],
+                                            da7281_stats_device(bus->instance, xfer->device)};
+
+    for (uint8_t i = 0; i < 2U; i++) {
+        da7281_stats_counters_t *c = counters[i];
+        if (c == NULL) {
+            continue;
+        }
+        c->transactions++;
+        c->bytes += 1U + xfer->len;
+        if (!success) {
+            c->errors++;
+        }
+        c->xfer_us += elapsed;
+        da7281_stats_hist(c->xfer_hist, elapsed);
+    }
+}
+
+/**
+ * @brief Account a blocking call whose completion never arrived
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param device Device of the access (NULL for multi-writes)
+ */
+static void da7281_stats_timeout(uint8_t instance, const da7281_device_t *device)
+{
+    da7281_stats_counters_t *dev = da7281_stats_device(instance, device);
+
+    uint32_t irq = s_ops->irq_lock();
+    s_stats.bus[instance].timeouts++;
+    if (dev != NULL) {
+        dev->timeouts++;
+    }
+    s_ops->irq_unlock(irq);
+}
+#endif /* DA7281_ENABLE_STATS */
+
 /* ========================================================================
  * Public Function Implementations
  * ======================================================================== */
 
+/**
+ * @brief Get attributes of a DA7281 register
+ *
+ * @param reg_addr Register address
+ * @return Bitwise OR of DA7281_REG_ATTR_* flags, 0 for reserved addresses
+ */
+uint8_t da7281_reg_attr(uint8_t reg_addr)
+{
+    if (reg_addr < DA7281_REG_SNP_MEM_BASE) {
+        return s_reg_attr[reg_addr];
+    }
+    if (reg_addr <= DA7281_REG_SNP_MEM_END) {
+        return DA7281_REG_ATTR_CACHEABLE;  /* Waveform memory only changes when written */
+    }
+    return 0U;
+}
+
+/**
+ * @brief Invalidate every shadow register of a device
+ *
+ * Hit/miss counters are preserved.
+ *
+ * @param device Pointer to device handle
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ */
+da7281_error_t da7281_cache_invalidate(da7281_device_t *device)
+{
+    DA7281_CHECK_NULL(device);
+
+    if (device->cache != NULL) {
+        memset(device->cache->valid, 0, sizeof(device->cache->valid));
+        DA7281_LOG_DEBUG("Register cache invalidated: addr=0x%02X", device->i2c_address);
+    }
+
+    return DA7281_OK;
+}
+
 /**
  * @brief Configure TWI pins for a specific instance
  *
@@ -197,82 +924,517 @@ da7281_error_t da7281_i2c_configure_pins(uint8_t instance, uint8_t scl_pin, uint
     s_twi_pins[instance].sda = sda_pin;
     s_twi_pins[instance].configured = true;
 
-    DA7281_LOG_INFO("TWI%d pins configured: SCL=P0.%d, SDA=P0.%d", instance, scl_pin, sda_pin);
+    DA7281_LOG_INFO("TWI%d pins configured: SCL=P0.%d, SDA=P0.%d", instance, scl_pin, sda_pin);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Bring up a TWI bus once, outside the transfer path
+ *
+ * Lets the bus backend create its lock and completion objects and
+ * initialize the TWI peripheral with the pins set by
+ * da7281_i2c_configure_pins(). Register accesses then only lock, transfer
+ * and unlock. Calling it again for a ready bus is a no-op.
+ * da7281_init() calls it for the device's bus.
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_INVALID_PARAM if instance >= 2 or pins not configured
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex creation fails (heap build only)
+ * @return DA7281_ERROR_I2C_WRITE if TWI initialization fails
+ *
+ * @note Not thread-safe: call once per bus from startup code or a single task
+ */
+da7281_error_t da7281_bus_init(uint8_t instance)
+{
+    if (instance >= 2) {
+        DA7281_LOG_ERROR("Invalid TWI instance: %d (valid: 0-1)", instance);
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    if (s_twi_initialized[instance]) {
+        return DA7281_OK;
+    }
+
+    /* Check if pins are configured */
+    if (!s_twi_pins[instance].configured) {
+        DA7281_LOG_ERROR("TWI%d pins not configured - call da7281_i2c_configure_pins() first", instance);
+        DA7281_LOG_ERROR("Application must specify SCL/SDA pins for the target hardware");
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    da7281_error_t err = s_ops->init(instance, s_twi_pins[instance].scl, s_twi_pins[instance].sda);
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("TWI%d initialization failed", instance);
+        return err;
+    }
+
+    s_twi_initialized[instance] = true;
+
+    DA7281_LOG_INFO("TWI%d initialized and enabled successfully", instance);
+    return DA7281_OK;
+}
+
+/**
+ * @brief Install a bus backend
+ *
+ * The default comes from DA7281_PLATFORM. Replace it before the first
+ * da7281_bus_init() (for example with da7281_bus_ops_host to run the
+ * driver against simulated devices).
+ *
+ * @param ops Backend operations (must stay valid)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if ops is NULL
+ * @return DA7281_ERROR_ALREADY_INITIALIZED if a bus is already up
+ */
+da7281_error_t da7281_bus_set_ops(const da7281_bus_ops_t *ops)
+{
+    DA7281_CHECK_NULL(ops);
+
+    if (s_twi_initialized[0] || s_twi_initialized[1]) {
+        DA7281_LOG_ERROR("Bus backend cannot change after da7281_bus_init()");
+        return DA7281_ERROR_ALREADY_INITIALIZED;
+    }
+
+    s_ops = ops;
+    return DA7281_OK;
+}
+
+/**
+ * @brief Backend currently in use
+ *
+ * @return Pointer to the active operations table
+ */
+const da7281_bus_ops_t *da7281_bus_get_ops(void)
+{
+    return s_ops;
+}
+
+/**
+ * @brief Frame completion reported by the bus backend (interrupt context)
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @param success true if every byte was acknowledged
+ */
+void da7281_bus_event(uint8_t instance, bool success)
+{
+    if (instance < 2U) {
+        da7281_xfer_complete(&s_bus[instance], success);
+    }
+}
+
+/**
+ * @brief Open a bus session: take the bus lock once for many accesses
+ *
+ * Until da7281_bus_end(), every blocking register call the same task makes
+ * on this bus (any device, any mix of reads, writes and read-modify-writes)
+ * runs without re-locking, and no other task can use the bus in between:
+ * other tasks block on the lock, and their asynchronous calls (also those
+ * made from completion callbacks) return DA7281_ERROR_BUSY until the
+ * session ends. Sessions nest; the lock is released by the outermost
+ * da7281_bus_end().
+ *
+ * In DA7281_BUS_LOCK_CRITICAL mode the scheduler stays suspended for the
+ * whole session, so keep sessions short. In DA7281_BUS_LOCK_NONE mode the
+ * session only does bookkeeping.
+ *
+ * Example (four actuators fire together):
+ *   da7281_bus_begin(0);
+ *   for (i = 0; i < 4; i++) da7281_set_override_amplitude(&dev[i], amp);
+ *   da7281_bus_end(0);
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_INVALID_PARAM if instance >= 2
+ * @return DA7281_ERROR_NOT_INITIALIZED if da7281_bus_init() was not called
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ */
+da7281_error_t da7281_bus_begin(uint8_t instance)
+{
+    if (instance >= 2) {
+        DA7281_LOG_ERROR("Invalid TWI instance: %d (valid: 0-1)", instance);
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+#if DA7281_ENABLE_PARAM_CHECK
+    if (!s_twi_initialized[instance]) {
+        DA7281_LOG_ERROR("TWI%d not initialized - call da7281_bus_init() first", instance);
+        return DA7281_ERROR_NOT_INITIALIZED;
+    }
+#endif
+
+    da7281_bus_t *bus = &s_bus[instance];
+
+    if (da7281_i2c_in_session(bus)) {
+        bus->session_depth++;
+        return DA7281_OK;
+    }
+
+#if DA7281_ENABLE_STATS
+    uint32_t t0 = s_ops->now();
+    da7281_error_t err = s_ops->lock(instance);
+    da7281_stats_lock(instance, NULL, t0, err);
+#else
+    da7281_error_t err = s_ops->lock(instance);
+#endif
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    /* Under the queue lock: da7281_xfer_submit() checks the owner there */
+    uint32_t irq = s_ops->irq_lock();
+    bus->session_owner = s_ops->self();
+    bus->session_depth = 1U;
+    s_ops->irq_unlock(irq);
+
+    DA7281_LOG_DEBUG("TWI%d session opened", instance);
+    return DA7281_OK;
+}
+
+/**
+ * @brief Close a bus session opened by da7281_bus_begin()
+ *
+ * @param instance TWI instance number (0 or 1)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_INVALID_PARAM if instance >= 2 or the calling task
+ *         holds no session on this bus
+ */
+da7281_error_t da7281_bus_end(uint8_t instance)
+{
+    if (instance >= 2) {
+        DA7281_LOG_ERROR("Invalid TWI instance: %d (valid: 0-1)", instance);
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    da7281_bus_t *bus = &s_bus[instance];
+
+    if (!da7281_i2c_in_session(bus)) {
+        DA7281_LOG_ERROR("TWI%d: da7281_bus_end() without matching da7281_bus_begin()", instance);
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t irq = s_ops->irq_lock();
+    bus->session_depth--;
+    bool closed = (bus->session_depth == 0U);
+    if (closed) {
+        bus->session_owner = NULL;
+    }
+    s_ops->irq_unlock(irq);
+
+    if (closed) {
+        s_ops->unlock(instance);
+        DA7281_LOG_DEBUG("TWI%d session closed", instance);
+    }
+
+    return DA7281_OK;
+}
+
+#if DA7281_ENABLE_STATS
+/**
+ * @brief Copy the transfer statistics
+ *
+ * Counters of frames still in flight are updated from completion context,
+ * so the copy is taken with the bus interrupts masked.
+ *
+ * @param stats Snapshot of all counters
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if stats is NULL
+ */
+da7281_error_t da7281_stats_get(da7281_stats_t *stats)
+{
+    DA7281_CHECK_NULL(stats);
+
+    uint32_t irq = s_ops->irq_lock();
+    *stats = s_stats;
+    s_ops->irq_unlock(irq);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Zero all transfer statistics
+ */
+void da7281_stats_reset(void)
+{
+    uint32_t irq = s_ops->irq_lock();
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_ops->irq_unlock(irq);
+}
+#endif /* DA7281_ENABLE_STATS */
+
+/**
+ * @brief Write single byte to DA7281 register
+ *
+ * Performs a thread-safe I2C write operation to a DA7281 register.
+ * Blocking wrapper over the transfer queue: the calling task sleeps
+ * until the TWI completion interrupt.
+ *
+ * I2C Transaction:
+ * - START
+ * - Device Address (Write)
+ * - Register Address
+ * - Data Byte
+ * - STOP
+ *
+ * @param device Pointer to device handle
+ * @param reg_addr Register address (0x00-0xAB)
+ * @param value Value to write (0x00-0xFF)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_TIMEOUT if the transfer did not complete in time
+ * @return DA7281_ERROR_I2C_WRITE if I2C transaction fails
+ */
+da7281_error_t da7281_write_register(da7281_device_t *device,
+                                       uint8_t reg_addr,
+                                       uint8_t value)
+{
+    DA7281_CHECK_NULL(device);
+
+    da7281_xfer_t xfer = {
+        .device = device,
+        .reg = reg_addr,
+        .len = 1U,
+        .value = value
+    };
+
+    /* Queue and wait; the shadow cache is updated on completion */
+    da7281_error_t err = da7281_i2c_transfer(&xfer);
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("I2C write failed: TWI%d, addr=0x%02X, reg=0x%02X, val=0x%02X, err=%d",
+                         device->twi_instance, device->i2c_address, reg_addr, value, err);
+        return err;
+    }
+
+    DA7281_LOG_DEBUG("I2C write OK: TWI%d, addr=0x%02X, reg=0x%02X, val=0x%02X",
+                     device->twi_instance, device->i2c_address, reg_addr, value);
 
     return DA7281_OK;
 }
 
 /**
- * @brief Write single byte to DA7281 register
+ * @brief Write consecutive DA7281 registers in one transaction
  *
- * Performs a thread-safe I2C write operation to a DA7281 register.
- * Automatically initializes mutex and TWI instance on first use.
+ * The DA7281 auto-increments its register pointer after every data byte,
+ * so a block of contiguous registers can be programmed with one frame
+ * instead of one frame per register. The mutex is taken once for the
+ * whole block.
  *
  * I2C Transaction:
  * - START
  * - Device Address (Write)
- * - Register Address
- * - Data Byte
+ * - Start Register Address
+ * - Data Byte 0 .. Data Byte (len - 1)
  * - STOP
  *
  * @param device Pointer to device handle
- * @param reg_addr Register address (0x00-0xAB)
- * @param value Value to write (0x00-0xFF)
+ * @param start_reg First register address
+ * @param buf Values to write, buf[i] goes to start_reg + i
+ * @param len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
  * @return DA7281_OK on success
- * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_NULL_POINTER if device or buf is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if len is 0, too long or runs past 0xFF
  * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_TIMEOUT if the transfer did not complete in time
  * @return DA7281_ERROR_I2C_WRITE if I2C transaction fails
  */
-da7281_error_t da7281_write_register(da7281_device_t *device,
-                                       uint8_t reg_addr,
-                                       uint8_t value)
+da7281_error_t da7281_write_burst(da7281_device_t *device,
+                                    uint8_t start_reg,
+                                    const uint8_t *buf,
+                                    uint8_t len)
 {
     DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(buf);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_I2C_MAX_BURST_LEN);
+#if DA7281_ENABLE_PARAM_CHECK
+    if (((uint16_t)start_reg + len) > 0x100U) {
+        return DA7281_ERROR_INVALID_PARAM;  /* Would wrap past register 0xFF */
+    }
+#endif
+
+    da7281_xfer_t xfer = {
+        .device = device,
+        .tx = buf,
+        .reg = start_reg,
+        .len = len
+    };
 
-    /* Initialize mutex if needed */
-    da7281_error_t err = da7281_i2c_init_mutex(device->twi_instance);
+    da7281_error_t err = da7281_i2c_transfer(&xfer);
     if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Mutex initialization failed for TWI%d", device->twi_instance);
+        DA7281_LOG_ERROR("I2C burst write failed: TWI%d, addr=0x%02X, reg=0x%02X, len=%u, err=%d",
+                         device->twi_instance, device->i2c_address, start_reg, len, err);
         return err;
     }
 
-    /* Initialize TWI if needed */
-    err = da7281_i2c_init_twi(device->twi_instance);
+    DA7281_LOG_DEBUG("I2C burst write OK: TWI%d, addr=0x%02X, reg=0x%02X, len=%u",
+                     device->twi_instance, device->i2c_address, start_reg, len);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Write the bytes of a burst that differ from the shadow cache
+ *
+ * A byte is skipped when its register is cacheable and the shadow copy is
+ * valid and equal to it: the cache doubles as the last-applied image of
+ * the device (it is invalidated on init and on faults, so a reset chip is
+ * rewritten in full). Changed bytes are written with da7281_write_burst(),
+ * one burst per group found by da7281_diff_next(); several bursts share
+ * one bus session.
+ *
+ * @param device Pointer to device handle
+ * @param start_reg First register address
+ * @param buf Values to write, buf[i] goes to start_reg + i
+ * @param len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @param skipped Receives the number of bytes not sent (may be NULL)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device or buf is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if len is 0, too long or runs past 0xFF
+ * @return DA7281_ERROR_I2C_WRITE if a burst fails
+ */
+da7281_error_t da7281_write_burst_diff(da7281_device_t *device,
+                                        uint8_t start_reg,
+                                        const uint8_t *buf,
+                                        uint8_t len,
+                                        uint8_t *skipped)
+{
+    DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(buf);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_I2C_MAX_BURST_LEN);
+#if DA7281_ENABLE_PARAM_CHECK
+    if (((uint16_t)start_reg + len) > 0x100U) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+#endif
+
+    const da7281_reg_cache_t *cache = device->cache;
+    bool changed[DA7281_I2C_MAX_BURST_LEN];
+    for (uint8_t i = 0; i < len; i++) {
+        uint16_t reg = (uint16_t)start_reg + i;
+        changed[i] = (cache == NULL) || (reg >= DA7281_REG_CACHE_SIZE) ||
+                     ((da7281_reg_attr((uint8_t)reg) & DA7281_REG_ATTR_CACHEABLE) == 0U) ||
+                     ((cache->valid[reg / 8U] & (1U << (reg % 8U))) == 0U) ||
+                     (cache->value[reg] != buf[i]);
+    }
+
+    /* Plan the bursts first: more than one shares a bus session */
+    uint8_t bursts = 0U;
+    uint8_t written = 0U;
+    uint8_t pos = 0U;
+    for (uint8_t run = da7281_diff_next(changed, len, &pos); run != 0U;
+         run = da7281_diff_next(changed, len, &pos)) {
+        bursts++;
+        written = (uint8_t)(written + run);
+        pos = (uint8_t)(pos + run);
+    }
+
+    da7281_error_t err = DA7281_OK;
+    if (bursts > 1U) {
+        err = da7281_bus_begin(device->twi_instance);
+        if (err != DA7281_OK) {
+            return err;
+        }
+    }
+
+    pos = 0U;
+    for (uint8_t run = da7281_diff_next(changed, len, &pos); (run != 0U) && (err == DA7281_OK);
+         run = da7281_diff_next(changed, len, &pos)) {
+        err = da7281_write_burst(device, (uint8_t)(start_reg + pos), &buf[pos], run);
+        pos = (uint8_t)(pos + run);
+    }
+
+    if (bursts > 1U) {
+        da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+        if (err == DA7281_OK) {
+            err = end_err;
+        }
+    }
     if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("TWI%d initialization failed", device->twi_instance);
         return err;
     }
 
-    /* Take mutex with timeout (per-bus mutex for parallel access to different buses) */
-    if (xSemaphoreTake(s_i2c_mutex[device->twi_instance], DA7281_MUTEX_TIMEOUT_TICKS) != pdTRUE) {
-        DA7281_LOG_ERROR("Failed to acquire I2C mutex for TWI%d (timeout after %d ms)",
-                         device->twi_instance, DA7281_I2C_TIMEOUT_MS);
-        return DA7281_ERROR_MUTEX_FAILED;
+    if (skipped != NULL) {
+        *skipped = (uint8_t)(len - written);
     }
 
-    /* Prepare data: [register_address, value] */
-    uint8_t data[2] = {reg_addr, value};
+    DA7281_LOG_DEBUG("I2C diff write: addr=0x%02X, reg=0x%02X, len=%u, written=%u in %u bursts",
+                     device->i2c_address, start_reg, len, written, bursts);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Write the same register on several devices with minimal skew
+ *
+ * Devices are grouped by TWI bus. Each bus is locked once and its writes
+ * are queued as one chain: every frame but the last ends without STOP, so
+ * the next device is addressed with a repeated START straight from the
+ * completion interrupt. Both buses are started before waiting on either,
+ * so they run in parallel.
+ *
+ * I2C Transaction (per bus):
+ * - START, Device A (Write), Register, Value A
+ * - REPEATED START, Device B (Write), Register, Value B
+ * - ...
+ * - STOP
+ *
+ * @param devices Device handles (any mix of TWI0 and TWI1)
+ * @param reg_addr Register written on every device
+ * @param values values[i] is written to devices[i]
+ * @param count Number of devices (up to DA7281_I2C_QUEUE_DEPTH per bus)
+ * @return DA7281_OK if every write succeeded
+ * @return DA7281_ERROR_NULL_POINTER if devices, values or an entry is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if count is 0, a bus gets too many
+ *         devices or a device has an invalid TWI instance
+ * @return DA7281_ERROR_NOT_INITIALIZED if a bus was not initialized
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_BUSY if async transfers leave no room for the chain
+ * @return DA7281_ERROR_TIMEOUT / DA7281_ERROR_I2C_WRITE on the first failed bus
+ */
+da7281_error_t da7281_write_register_multi(da7281_device_t *const devices[],
+                                             uint8_t reg_addr,
+                                             const uint8_t values[],
+                                             uint8_t count)
+{
+    DA7281_CHECK_NULL(devices);
+    DA7281_CHECK_NULL(values);
+    DA7281_CHECK_RANGE(count, 1U, 2U * DA7281_I2C_QUEUE_DEPTH);
 
-    /* Perform I2C write transaction */
-    ret_code_t ret = nrf_drv_twi_tx(&s_twi_instances[device->twi_instance],
-                                     device->i2c_address,
-                                     data,
-                                     sizeof(data),
-                                     false);
+    da7281_xfer_t chain[2][DA7281_I2C_QUEUE_DEPTH];
+    uint8_t chain_len[2] = {0U, 0U};
 
-    /* Release mutex */
-    xSemaphoreGive(s_i2c_mutex[device->twi_instance]);
+    /* Group by bus, keeping the caller's order within each bus */
+    for (uint8_t i = 0; i < count; i++) {
+        DA7281_CHECK_NULL(devices[i]);
+        uint8_t instance = devices[i]->twi_instance;
+        if ((instance >= 2U) || (chain_len[instance] >= DA7281_I2C_QUEUE_DEPTH)) {
+            DA7281_LOG_ERROR("Multi-write: device %u rejected (TWI%d)", i, instance);
+            return DA7281_ERROR_INVALID_PARAM;
+        }
+        chain[instance][chain_len[instance]++] = (da7281_xfer_t){
+            .device = devices[i],
+            .reg = reg_addr,
+            .len = 1U,
+            .value = values[i],
+            .no_stop = true,
+            .callback = da7281_xfer_chain_step,
+            .context = &s_bus[instance]
+        };
+    }
 
-    if (ret != NRF_SUCCESS) {
-        DA7281_LOG_ERROR("I2C write failed: TWI%d, addr=0x%02X, reg=0x%02X, val=0x%02X, err=0x%08lX",
-                         device->twi_instance, device->i2c_address, reg_addr, value, (unsigned long)ret);
-        return DA7281_ERROR_I2C_WRITE;
+    da7281_error_t bus_err[2];
+    da7281_error_t err = da7281_xfer_run_multi(chain, chain_len, bus_err);
+    for (uint8_t b = 0; b < 2U; b++) {
+        if ((chain_len[b] != 0U) && (bus_err[b] != DA7281_OK)) {
+            DA7281_LOG_ERROR("Multi-write on TWI%d failed: reg=0x%02X, err=%d", b, reg_addr, bus_err[b]);
+        }
     }
 
-    DA7281_LOG_DEBUG("I2C write OK: TWI%d, addr=0x%02X, reg=0x%02X, val=0x%02X",
-                     device->twi_instance, device->i2c_address, reg_addr, value);
+    DA7281_LOG_DEBUG("Multi-write reg=0x%02X to %u devices (TWI0: %u, TWI1: %u), err=%d",
+                     reg_addr, count, chain_len[0], chain_len[1], err);
 
-    return DA7281_OK;
+    return err;
 }
 
 /**
@@ -296,6 +1458,7 @@ da7281_error_t da7281_write_register(da7281_device_t *device,
  * @return DA7281_OK on success
  * @return DA7281_ERROR_NULL_POINTER if device or value is NULL
  * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_TIMEOUT if the transfer did not complete in time
  * @return DA7281_ERROR_I2C_READ if I2C transaction fails
  */
 da7281_error_t da7281_read_register(da7281_device_t *device,
@@ -305,57 +1468,210 @@ da7281_error_t da7281_read_register(da7281_device_t *device,
     DA7281_CHECK_NULL(device);
     DA7281_CHECK_NULL(value);
 
-    /* Initialize mutex if needed */
-    da7281_error_t err = da7281_i2c_init_mutex(device->twi_instance);
+    da7281_xfer_t xfer = {
+        .device = device,
+        .rx = value,
+        .reg = reg_addr,
+        .len = 1U
+    };
+
+    da7281_error_t err = da7281_i2c_transfer(&xfer);
     if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("Mutex initialization failed for TWI%d", device->twi_instance);
+        DA7281_LOG_ERROR("I2C read failed: TWI%d, addr=0x%02X, reg=0x%02X, err=%d",
+                         device->twi_instance, device->i2c_address, reg_addr, err);
         return err;
     }
 
-    /* Initialize TWI if needed */
-    err = da7281_i2c_init_twi(device->twi_instance);
+    DA7281_LOG_DEBUG("I2C read OK: TWI%d, addr=0x%02X, reg=0x%02X, val=0x%02X",
+                     device->twi_instance, device->i2c_address, reg_addr, *value);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Read consecutive DA7281 registers in one transaction
+ *
+ * Sends the start register once, then clocks in len bytes while the
+ * DA7281 auto-increments its register pointer. A block of N registers
+ * costs one address phase pair and one mutex acquisition instead of N.
+ *
+ * I2C Transaction:
+ * - START
+ * - Device Address (Write)
+ * - Start Register Address
+ * - REPEATED START
+ * - Device Address (Read)
+ * - Data Byte 0 .. Data Byte (len - 1)
+ * - STOP
+ *
+ * @param device Pointer to device handle
+ * @param start_reg First register address
+ * @param buf Buffer to store values, buf[i] comes from start_reg + i
+ * @param len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device or buf is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if len is 0, too long or runs past 0xFF
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_TIMEOUT if the transfer did not complete in time
+ * @return DA7281_ERROR_I2C_READ if I2C transaction fails
+ */
+da7281_error_t da7281_read_burst(da7281_device_t *device,
+                                   uint8_t start_reg,
+                                   uint8_t *buf,
+                                   uint8_t len)
+{
+    DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(buf);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_I2C_MAX_BURST_LEN);
+#if DA7281_ENABLE_PARAM_CHECK
+    if (((uint16_t)start_reg + len) > 0x100U) {
+        return DA7281_ERROR_INVALID_PARAM;  /* Would wrap past register 0xFF */
+    }
+#endif
+
+    da7281_xfer_t xfer = {
+        .device = device,
+        .rx = buf,
+        .reg = start_reg,
+        .len = len
+    };
+
+    da7281_error_t err = da7281_i2c_transfer(&xfer);
     if (err != DA7281_OK) {
-        DA7281_LOG_ERROR("TWI%d initialization failed", device->twi_instance);
+        DA7281_LOG_ERROR("I2C burst read failed: TWI%d, addr=0x%02X, reg=0x%02X, len=%u, err=%d",
+                         device->twi_instance, device->i2c_address, start_reg, len, err);
         return err;
     }
 
-    /* Take mutex with timeout (per-bus mutex for parallel access to different buses) */
-    if (xSemaphoreTake(s_i2c_mutex[device->twi_instance], DA7281_MUTEX_TIMEOUT_TICKS) != pdTRUE) {
-        DA7281_LOG_ERROR("Failed to acquire I2C mutex for TWI%d (timeout after %d ms)",
-                         device->twi_instance, DA7281_I2C_TIMEOUT_MS);
-        return DA7281_ERROR_MUTEX_FAILED;
-    }
+    DA7281_LOG_DEBUG("I2C burst read OK: TWI%d, addr=0x%02X, reg=0x%02X, len=%u",
+                     device->twi_instance, device->i2c_address, start_reg, len);
+
+    return DA7281_OK;
+}
 
-    ret_code_t ret;
+/**
+ * @brief Read the same registers from several devices, both buses in parallel
+ *
+ * Devices are grouped by TWI bus. Each bus is locked once and its reads
+ * are queued back to back, so the next read starts from the completion
+ * interrupt. Both buses are started before waiting on either. Data goes
+ * through the bus bounce buffer, so a timed-out read that completes late
+ * cannot touch the caller's buffers.
+ *
+ * @param devices Device handles (any mix of TWI0 and TWI1)
+ * @param start_reg First register address
+ * @param bufs bufs[i] receives len bytes from devices[i]
+ * @param len Bytes per device (count on one bus * len <= DA7281_I2C_MAX_BURST_LEN)
+ * @param count Number of devices (up to DA7281_I2C_QUEUE_DEPTH per bus)
+ * @return DA7281_OK if every read succeeded
+ * @return DA7281_ERROR_NULL_POINTER if devices, bufs or an entry is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if count or len is 0, a bus gets too
+ *         many devices or bytes, or a device has an invalid TWI instance
+ * @return DA7281_ERROR_NOT_INITIALIZED if a bus was not initialized
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_BUSY if async transfers leave no room for the chain
+ * @return DA7281_ERROR_TIMEOUT / DA7281_ERROR_I2C_READ on the first failed
+ *         bus; buffers of the devices on a bus that succeeded are filled
+ */
+da7281_error_t da7281_read_burst_multi(da7281_device_t *const devices[],
+                                         uint8_t start_reg,
+                                         uint8_t *const bufs[],
+                                         uint8_t len,
+                                         uint8_t count)
+{
+    DA7281_CHECK_NULL(devices);
+    DA7281_CHECK_NULL(bufs);
+    DA7281_CHECK_RANGE(count, 1U, 2U * DA7281_I2C_QUEUE_DEPTH);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_I2C_MAX_BURST_LEN);
+#if DA7281_ENABLE_PARAM_CHECK
+    if (((uint16_t)start_reg + len) > 0x100U) {
+        return DA7281_ERROR_INVALID_PARAM;  /* Would wrap past register 0xFF */
+    }
+#endif
 
-    /* Write register address (with repeated start) */
-    ret = nrf_drv_twi_tx(&s_twi_instances[device->twi_instance],
-                          device->i2c_address,
-                          &reg_addr,
-                          1,
-                          true);  /* No stop condition - repeated start */
+    da7281_xfer_t chain[2][DA7281_I2C_QUEUE_DEPTH];
+    uint8_t chain_len[2] = {0U, 0U};
 
-    if (ret == NRF_SUCCESS) {
-        /* Read data byte */
-        ret = nrf_drv_twi_rx(&s_twi_instances[device->twi_instance],
-                              device->i2c_address,
-                              value,
-                              1);
+    /* Group by bus, each read lands in its own slice of the bounce buffer */
+    for (uint8_t i = 0; i < count; i++) {
+        DA7281_CHECK_NULL(devices[i]);
+        DA7281_CHECK_NULL(bufs[i]);
+        uint8_t instance = devices[i]->twi_instance;
+        if ((instance >= 2U) || (chain_len[instance] >= DA7281_I2C_QUEUE_DEPTH) ||
+            (((uint16_t)chain_len[instance] + 1U) * len > DA7281_I2C_MAX_BURST_LEN)) {
+            DA7281_LOG_ERROR("Multi-read: device %u rejected (TWI%d)", i, instance);
+            return DA7281_ERROR_INVALID_PARAM;
+        }
+        chain[instance][chain_len[instance]] = (da7281_xfer_t){
+            .device = devices[i],
+            .rx = &s_bus[instance].sync_buf[chain_len[instance] * len],
+            .reg = start_reg,
+            .len = len,
+            .callback = da7281_xfer_chain_step,
+            .context = &s_bus[instance]
+        };
+        chain_len[instance]++;
     }
 
-    /* Release mutex */
-    xSemaphoreGive(s_i2c_mutex[device->twi_instance]);
+    da7281_error_t bus_err[2];
+    da7281_error_t err = da7281_xfer_run_multi(chain, chain_len, bus_err);
 
-    if (ret != NRF_SUCCESS) {
-        DA7281_LOG_ERROR("I2C read failed: TWI%d, addr=0x%02X, reg=0x%02X, err=0x%08lX",
-                         device->twi_instance, device->i2c_address, reg_addr, (unsigned long)ret);
-        return DA7281_ERROR_I2C_READ;
+    /* Copy back in the caller's order, per bus */
+    uint8_t pos[2] = {0U, 0U};
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t instance = devices[i]->twi_instance;
+        if (bus_err[instance] == DA7281_OK) {
+            memcpy(bufs[i], &s_bus[instance].sync_buf[pos[instance] * len], len);
+        }
+        pos[instance]++;
+    }
+    for (uint8_t b = 0; b < 2U; b++) {
+        if ((chain_len[b] != 0U) && (bus_err[b] != DA7281_OK)) {
+            DA7281_LOG_ERROR("Multi-read on TWI%d failed: reg=0x%02X, err=%d", b, start_reg, bus_err[b]);
+        }
     }
 
-    DA7281_LOG_DEBUG("I2C read OK: TWI%d, addr=0x%02X, reg=0x%02X, val=0x%02X",
-                     device->twi_instance, device->i2c_address, reg_addr, *value);
+    DA7281_LOG_DEBUG("Multi-read reg=0x%02X, len=%u from %u devices (TWI0: %u, TWI1: %u), err=%d",
+                     start_reg, len, count, chain_len[0], chain_len[1], err);
 
-    return DA7281_OK;
+    return err;
+}
+
+/**
+ * @brief Read DA7281 register through the shadow cache
+ *
+ * Returns the shadow copy when a cache is attached, the register is
+ * DA7281_REG_ATTR_CACHEABLE and the shadow is valid (no bus access).
+ * Otherwise falls back to da7281_read_register(), which refills the shadow.
+ * Volatile registers always go to the bus and are not counted.
+ *
+ * @param device Pointer to device handle
+ * @param reg_addr Register address to read
+ * @param value Pointer to store read value
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if device or value is NULL
+ * @return DA7281_ERROR_MUTEX_FAILED if mutex timeout
+ * @return DA7281_ERROR_I2C_READ if I2C transaction fails
+ */
+da7281_error_t da7281_read_register_cached(da7281_device_t *device,
+                                             uint8_t reg_addr,
+                                             uint8_t *value)
+{
+    DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(value);
+
+    da7281_reg_cache_t *cache = device->cache;
+    if ((cache != NULL) &&
+        ((da7281_reg_attr(reg_addr) & DA7281_REG_ATTR_CACHEABLE) != 0U)) {
+        if ((cache->valid[reg_addr / 8U] & (1U << (reg_addr % 8U))) != 0U) {
+            cache->hits++;
+            *value = cache->value[reg_addr];
+            return DA7281_OK;
+        }
+        cache->misses++;
+    }
+
+    return da7281_read_register(device, reg_addr, value);
 }
 
 /**
@@ -365,7 +1681,7 @@ da7281_error_t da7281_read_register(da7281_device_t *device,
  * Only the bits specified by the mask are modified, other bits remain unchanged.
  *
  * Operation:
- * 1. Read current register value
+ * 1. Read current register value (from the shadow cache when valid)
  * 2. Clear bits specified by mask
  * 3. Set new bits (masked)
  * 4. Write modified value back
@@ -398,13 +1714,14 @@ da7281_error_t da7281_modify_register(da7281_device_t *device,
     da7281_error_t err;
 
     /* Read current register value */
-    err = da7281_read_register(device, reg_addr, &reg_value);
+    err = da7281_read_register_cached(device, reg_addr, &reg_value);
     if (err != DA7281_OK) {
         DA7281_LOG_ERROR("Failed to read register 0x%02X for modify operation", reg_addr);
         return err;
     }
 
     uint8_t old_value = reg_value;
+    (void)old_value;  /* Only referenced by the debug log */
 
     /* Modify bits: clear masked bits, then set new masked bits */
     reg_value = (reg_value & ~mask) | (value & mask);
@@ -421,3 +1738,347 @@ da7281_error_t da7281_modify_register(da7281_device_t *device,
 
     return DA7281_OK;
 }
+
+/**
+ * @brief Empty a write set
+ *
+ * @param set Write set
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if set is NULL
+ */
+da7281_error_t da7281_write_set_init(da7281_write_set_t *set)
+{
+    DA7281_CHECK_NULL(set);
+
+    set->count = 0U;
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Add a masked register write to a write set
+ *
+ * Entries are kept one per register: a write to a register already in the
+ * set fuses into its entry (masks OR'ed, the later value wins on shared
+ * bits), so the order of add calls only matters for overlapping bits.
+ * Bits outside the mask are dropped from value; a zero mask is a no-op.
+ * Volatile registers take whole-register writes only: a read-modify-write
+ * of a write-1-to-clear event register (IRQ_EVENT1,
+ * IRQ_EVENT_ACTUATOR_FAULT) writes back every latched event as a 1 and
+ * clears them all.
+ *
+ * @param set Write set
+ * @param reg_addr Register address
+ * @param mask Bits to change (0xFF = whole register)
+ * @param value New value of the masked bits
+ * @return DA7281_OK on success
+ * @return DA7281_ERROR_NULL_POINTER if set is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if the register is reserved or
+ *         read-only, the mask is partial on a volatile register, or the set
+ *         already holds DA7281_WRITE_SET_MAX registers
+ */
+da7281_error_t da7281_write_set_add(da7281_write_set_t *set,
+                                     uint8_t reg_addr,
+                                     uint8_t mask,
+                                     uint8_t value)
+{
+    DA7281_CHECK_NULL(set);
+
+    uint8_t attr = da7281_reg_attr(reg_addr);
+    if ((attr == 0U) || ((attr & DA7281_REG_ATTR_READ_ONLY) != 0U)) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+    if (mask == 0U) {
+        return DA7281_OK;
+    }
+    if (((attr & DA7281_REG_ATTR_VOLATILE) != 0U) && (mask != 0xFFU)) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    for (uint8_t i = 0; i < set->count; i++) {
+        da7281_write_entry_t *entry = &set->entries[i];
+        if (entry->reg == reg_addr) {
+            entry->value = (uint8_t)((entry->value & ~mask) | (value & mask));
+            entry->mask |= mask;
+            return DA7281_OK;
+        }
+    }
+
+    if (set->count >= DA7281_WRITE_SET_MAX) {
+        return DA7281_ERROR_INVALID_PARAM;
+    }
+
+    set->entries[set->count].reg = reg_addr;
+    set->entries[set->count].mask = mask;
+    set->entries[set->count].value = (uint8_t)(value & mask);
+    set->count++;
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Write a write set with the fewest I2C frames
+ *
+ * 1. Sort the entries by address (insertion sort, sets are small).
+ * 2. Partial masks read the current value, from the shadow cache when
+ *    one is attached, as da7281_modify_register() does. Volatile registers
+ *    only ever hold whole-register entries (see da7281_write_set_add()).
+ * 3. Runs of consecutive registers go out as da7281_write_burst() frames.
+ *    Volatile registers (chip-owned, e.g. write-1-to-clear events) and
+ *    DA7281_REG_ATTR_NO_BURST command registers (TOP_CTL1: operation mode,
+ *    SEQ_START) never join a burst; they are written one frame each after
+ *    the bursts, so a mode change or sequence start acts on the finished
+ *    configuration.
+ *
+ * Everything runs in one bus session (one lock). The actuator setup in
+ * tests/bench_bus_traffic.c (ten scattered writes) drops from 13 frames
+ * and 13 locks to 3 frames and 1 lock.
+ *
+ * @param device Pointer to device handle
+ * @param set Write set, sorted by address on return
+ * @return DA7281_OK on success (also for an empty set)
+ * @return DA7281_ERROR_NULL_POINTER if device or set is NULL
+ * @return DA7281_ERROR_I2C_READ if resolving a partial mask fails
+ * @return DA7281_ERROR_I2C_WRITE if a write fails
+ */
+da7281_error_t da7281_write_set_commit(da7281_device_t *device, da7281_write_set_t *set)
+{
+    DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(set);
+
+    if (set->count == 0U) {
+        return DA7281_OK;
+    }
+
+    for (uint8_t i = 1; i < set->count; i++) {
+        da7281_write_entry_t entry = set->entries[i];
+        uint8_t j = i;
+        while ((j > 0U) && (set->entries[j - 1U].reg > entry.reg)) {
+            set->entries[j] = set->entries[j - 1U];
+            j--;
+        }
+        set->entries[j] = entry;
+    }
+
+    da7281_error_t err = da7281_bus_begin(device->twi_instance);
+    if (err != DA7281_OK) {
+        return err;
+    }
+
+    /* Final register values, values[i] belongs to entries[i] */
+    uint8_t values[DA7281_WRITE_SET_MAX];
+    bool burstable[DA7281_WRITE_SET_MAX];
+    for (uint8_t i = 0; (i < set->count) && (err == DA7281_OK); i++) {
+        const da7281_write_entry_t *entry = &set->entries[i];
+        values[i] = entry->value;
+        if (entry->mask != 0xFFU) {
+            uint8_t current = 0;
+            err = da7281_read_register_cached(device, entry->reg, &current);
+            values[i] = (uint8_t)((current & ~entry->mask) | entry->value);
+        }
+        burstable[i] = (da7281_reg_attr(entry->reg) &
+                        (DA7281_REG_ATTR_VOLATILE | DA7281_REG_ATTR_NO_BURST)) == 0U;
+    }
+
+    uint8_t frames = 0U;
+    uint8_t i = 0;
+    while ((i < set->count) && (err == DA7281_OK)) {
+        if (!burstable[i]) {
+            i++;
+            continue;
+        }
+        uint8_t start = i;
+        uint8_t len = 1U;
+        while (((start + len) < set->count) && (len < DA7281_I2C_MAX_BURST_LEN) &&
+               burstable[start + len] &&
+               (set->entries[start + len].reg == (uint8_t)(set->entries[start].reg + len))) {
+            len++;
+        }
+        err = da7281_write_burst(device, set->entries[start].reg, &values[start], len);
+        frames++;
+        i = (uint8_t)(start + len);
+    }
+
+    for (i = 0; (i < set->count) && (err == DA7281_OK); i++) {
+        if (!burstable[i]) {
+            err = da7281_write_register(device, set->entries[i].reg, values[i]);
+            frames++;
+        }
+    }
+
+    da7281_error_t end_err = da7281_bus_end(device->twi_instance);
+    if (err == DA7281_OK) {
+        err = end_err;
+    }
+
+    if (err != DA7281_OK) {
+        DA7281_LOG_ERROR("Write set commit failed: addr=0x%02X, %u registers, err=%d",
+                         device->i2c_address, set->count, err);
+        return err;
+    }
+
+    DA7281_LOG_DEBUG("Write set committed: addr=0x%02X, %u registers in %u frames",
+                     device->i2c_address, set->count, frames);
+
+    return DA7281_OK;
+}
+
+/**
+ * @brief Queue a single register write and return immediately
+ *
+ * The frame is clocked out by the TWI peripheral while the caller keeps
+ * running; the callback fires from the TWI interrupt once the STOP has
+ * been sent. The shadow cache is updated before the callback runs.
+ *
+ * @param device Pointer to device handle
+ * @param reg_addr Register address
+ * @param value Value to write (copied, no lifetime requirement)
+ * @param callback Completion callback, NULL for fire-and-forget
+ * @param context User pointer passed to the callback
+ * @return DA7281_OK if queued
+ * @return DA7281_ERROR_NULL_POINTER if device is NULL
+ * @return DA7281_ERROR_BUSY if DA7281_I2C_QUEUE_DEPTH transfers are pending
+ *         or another task holds a session on the bus
+ */
+da7281_error_t da7281_write_register_async(da7281_device_t *device,
+                                             uint8_t reg_addr,
+                                             uint8_t value,
+                                             da7281_xfer_cb_t callback,
+                                             void *context)
+{
+    DA7281_CHECK_NULL(device);
+
+    da7281_xfer_t xfer = {
+        .device = device,
+        .reg = reg_addr,
+        .len = 1U,
+        .value = value,
+        .callback = callback,
+        .context = context
+    };
+
+    return da7281_xfer_submit(&xfer);
+}
+
+/**
+ * @brief Queue a single register read and return immediately
+ *
+ * @param device Pointer to device handle
+ * @param reg_addr Register address
+ * @param value Destination, written before the callback runs
+ * @param callback Completion callback (may be NULL)
+ * @param context User pointer passed to the callback
+ * @return DA7281_OK if queued
+ * @return DA7281_ERROR_NULL_POINTER if device or value is NULL
+ * @return DA7281_ERROR_BUSY if DA7281_I2C_QUEUE_DEPTH transfers are pending
+ *         or another task holds a session on the bus
+ */
+da7281_error_t da7281_read_register_async(da7281_device_t *device,
+                                            uint8_t reg_addr,
+                                            uint8_t *value,
+                                            da7281_xfer_cb_t callback,
+                                            void *context)
+{
+    DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(value);
+
+    da7281_xfer_t xfer = {
+        .device = device,
+        .rx = value,
+        .reg = reg_addr,
+        .len = 1U,
+        .callback = callback,
+        .context = context
+    };
+
+    return da7281_xfer_submit(&xfer);
+}
+
+/**
+ * @brief Queue a burst write and return immediately
+ *
+ * buf is copied into the bus frame only when the transfer reaches the
+ * head of the queue, so it must stay valid until the callback.
+ *
+ * @param device Pointer to device handle
+ * @param start_reg First register address
+ * @param buf Values to write, buf[i] goes to start_reg + i
+ * @param len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @param callback Completion callback (may be NULL)
+ * @param context User pointer passed to the callback
+ * @return DA7281_OK if queued
+ * @return DA7281_ERROR_NULL_POINTER if device or buf is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if len is 0, too long or runs past 0xFF
+ * @return DA7281_ERROR_BUSY if DA7281_I2C_QUEUE_DEPTH transfers are pending
+ *         or another task holds a session on the bus
+ */
+da7281_error_t da7281_write_burst_async(da7281_device_t *device,
+                                          uint8_t start_reg,
+                                          const uint8_t *buf,
+                                          uint8_t len,
+                                          da7281_xfer_cb_t callback,
+                                          void *context)
+{
+    DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(buf);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_I2C_MAX_BURST_LEN);
+#if DA7281_ENABLE_PARAM_CHECK
+    if (((uint16_t)start_reg + len) > 0x100U) {
+        return DA7281_ERROR_INVALID_PARAM;  /* Would wrap past register 0xFF */
+    }
+#endif
+
+    da7281_xfer_t xfer = {
+        .device = device,
+        .tx = buf,
+        .reg = start_reg,
+        .len = len,
+        .callback = callback,
+        .context = context
+    };
+
+    return da7281_xfer_submit(&xfer);
+}
+
+/**
+ * @brief Queue a burst read and return immediately
+ *
+ * @param device Pointer to device handle
+ * @param start_reg First register address
+ * @param buf Destination, buf[i] comes from start_reg + i
+ * @param len Number of bytes (1 to DA7281_I2C_MAX_BURST_LEN)
+ * @param callback Completion callback (may be NULL)
+ * @param context User pointer passed to the callback
+ * @return DA7281_OK if queued
+ * @return DA7281_ERROR_NULL_POINTER if device or buf is NULL
+ * @return DA7281_ERROR_INVALID_PARAM if len is 0, too long or runs past 0xFF
+ * @return DA7281_ERROR_BUSY if DA7281_I2C_QUEUE_DEPTH transfers are pending
+ *         or another task holds a session on the bus
+ */
+da7281_error_t da7281_read_burst_async(da7281_device_t *device,
+                                         uint8_t start_reg,
+                                         uint8_t *buf,
+                                         uint8_t len,
+                                         da7281_xfer_cb_t callback,
+                                         void *context)
+{
+    DA7281_CHECK_NULL(device);
+    DA7281_CHECK_NULL(buf);
+    DA7281_CHECK_RANGE(len, 1U, DA7281_I2C_MAX_BURST_LEN);
+#if DA7281_ENABLE_PARAM_CHECK
+    if (((uint16_t)start_reg + len) > 0x100U) {
+        return DA7281_ERROR_INVALID_PARAM;  /* Would wrap past register 0xFF */
+    }
+#endif
+
+    da7281_xfer_t xfer = {
+        .device = device,
+        .rx = buf,
+        .reg = start_reg,
+        .len = len,
+        .callback = callback,
+        .context = context
+    };
+
+    return da7281_xfer_submit(&xfer);
+}
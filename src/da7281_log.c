@@ -0,0 +1,251 @@
+/**
+ * @file da7281_log.c
+ * @brief DA7281 Binary Deferred Logging (DA7281_LOG_BACKEND = 4)
+ * @author A. R. Ansari
+ * @date 2024-11-21
+ *
+ * Multi-producer, single-consumer byte ring. A producer claims space by
+ * advancing s_head with a compare-and-swap, fills in its record and
+ * publishes it by writing the length byte last. The consumer copies
+ * records whose length byte is set, clears them and advances s_tail.
+ * Nothing here waits, so logging from interrupts or during a bus-fault
+ * storm costs a few hundred cycles at most.
+ *
+ * Compiles to nothing for the other log backends.
+ */
+
+#include "da7281.h"
+
+#if (DA7281_LOG_BACKEND == 4)
+
+#include "da7281_bus.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#if (DA7281_LOG_BUFFER_SIZE & (DA7281_LOG_BUFFER_SIZE - 1U)) != 0U
+#error "DA7281_LOG_BUFFER_SIZE must be a power of two"
+#endif
+
+/* ========================================================================
+ * Private Definitions
+ * ======================================================================== */
+
+#define LOG_MASK            (DA7281_LOG_BUFFER_SIZE - 1U)
+#define LOG_HEADER_LEN      (7U)
+#define LOG_MAX_RECORD      (255U)
+#define LOG_LEVELS          (4U)
+
+/* ========================================================================
+ * Private Variables
+ * ======================================================================== */
+
+static uint8_t s_buf[DA7281_LOG_BUFFER_SIZE];
+static _Atomic uint32_t s_head;         /**< Next byte to claim (free-running) */
+static _Atomic uint32_t s_tail;         /**< Next byte to drain (free-running) */
+
+static _Atomic uint32_t s_records;
+static _Atomic uint32_t s_dropped_full;
+static _Atomic uint32_t s_dropped_rate;
+static uint32_t s_dropped_reported;     /**< Consumer only */
+
+/** Rate windows per level (approximate under concurrency by design) */
+static uint32_t s_rate_start[LOG_LEVELS];
+static _Atomic uint32_t s_rate_count[LOG_LEVELS];
+
+/* ========================================================================
+ * Private Functions
+ * ======================================================================== */
+
+static void log_put(uint32_t pos, uint8_t byte)
+{
+    s_buf[pos & LOG_MASK] = byte;
+}
+
+static void log_put32(uint32_t pos, uint32_t value)
+{
+    for (uint8_t i = 0; i < 4U; i++) {
+        log_put(pos + i, (uint8_t)(value >> (8U * i)));
+    }
+}
+
+/**
+ * @brief Check the per-level rate limit
+ *
+ * @return true if the record may be stored
+ */
+static bool log_rate_ok(uint8_t level, uint32_t now_us)
+{
+#if (DA7281_LOG_RATE_LIMIT > 0U)
+    uint8_t slot = (uint8_t)(((level >= 1U) && (level <= LOG_LEVELS)) ? (level - 1U) : (LOG_LEVELS - 1U));
+
+    if ((now_us - s_rate_start[slot]) >= (DA7281_LOG_RATE_WINDOW_MS * 1000UL)) {
+        s_rate_start[slot] = now_us;
+        atomic_store_explicit(&s_rate_count[slot], 0U, memory_order_relaxed);
+    }
+    return atomic_fetch_add_explicit(&s_rate_count[slot], 1U, memory_order_relaxed) < DA7281_LOG_RATE_LIMIT;
+#else
+    (void)level;
+    (void)now_us;
+    return true;
+#endif
+}
+
+/**
+ * @brief Encoded size of a record
+ */
+static uint32_t log_record_len(const da7281_log_arg_t *args, uint8_t count)
+{
+    uint32_t len = LOG_HEADER_LEN;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (args[i].type == (uint8_t)DA7281_LOG_ARG_STR) {
+            size_t n = (args[i].v.s != NULL) ? strlen(args[i].v.s) : 0U;
+            len += 1U + ((n > DA7281_LOG_MAX_STR_LEN) ? DA7281_LOG_MAX_STR_LEN : (uint32_t)n);
+        } else {
+            len += 4U;
+        }
+    }
+
+    return len;
+}
+
+/* ========================================================================
+ * Public Functions
+ * ======================================================================== */
+
+/**
+ * @brief Store one record (any context, never blocks)
+ */
+void da7281_log_write(uint16_t site, uint8_t level, const da7281_log_arg_t *args, uint8_t count)
+{
+    uint32_t now = da7281_bus_get_ops()->now();
+
+    if (!log_rate_ok(level, now)) {
+        atomic_fetch_add_explicit(&s_dropped_rate, 1U, memory_order_relaxed);
+        return;
+    }
+
+    uint32_t len = log_record_len(args, count);
+    if (len > LOG_MAX_RECORD) {
+        atomic_fetch_add_explicit(&s_dropped_full, 1U, memory_order_relaxed);
+        return;
+    }
+
+    /* Claim [head, head + len) */
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_relaxed);
+    do {
+        uint32_t tail = atomic_load_explicit(&s_tail, memory_order_acquire);
+        if (((head - tail) + len) > DA7281_LOG_BUFFER_SIZE) {
+            atomic_fetch_add_explicit(&s_dropped_full, 1U, memory_order_relaxed);
+            return;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&s_head, &head, head + len,
+                                                    memory_order_acq_rel, memory_order_relaxed));
+
+    uint32_t pos = head + 1U;
+    log_put(pos++, (uint8_t)site);
+    log_put(pos++, (uint8_t)(site >> 8));
+    log_put32(pos, now);
+    pos += 4U;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (args[i].type == (uint8_t)DA7281_LOG_ARG_STR) {
+            const char *s = (args[i].v.s != NULL) ? args[i].v.s : "";
+            size_t n = strlen(s);
+            if (n > DA7281_LOG_MAX_STR_LEN) {
+                n = DA7281_LOG_MAX_STR_LEN;
+            }
+            log_put(pos++, (uint8_t)n);
+            for (size_t c = 0; c < n; c++) {
+                log_put(pos++, (uint8_t)s[c]);
+            }
+        } else {
+            log_put32(pos, args[i].v.u);    /* Float bits share the word */
+            pos += 4U;
+        }
+    }
+
+    /* Publish: the length byte goes last */
+    atomic_thread_fence(memory_order_release);
+    *(volatile uint8_t *)&s_buf[head & LOG_MASK] = (uint8_t)len;
+    atomic_fetch_add_explicit(&s_records, 1U, memory_order_relaxed);
+}
+
+/**
+ * @brief Move committed records out of the ring buffer (single consumer)
+ */
+uint32_t da7281_log_read(uint8_t *buf, uint32_t size)
+{
+    uint32_t out = 0U;
+
+    if (buf == NULL) {
+        return 0U;
+    }
+
+    /* Report losses first so the decoder can mark the gap */
+    uint32_t dropped = atomic_load_explicit(&s_dropped_full, memory_order_relaxed) +
+                       atomic_load_explicit(&s_dropped_rate, memory_order_relaxed);
+    if ((dropped != s_dropped_reported) && (size >= (LOG_HEADER_LEN + 4U))) {
+        uint32_t now = da7281_bus_get_ops()->now();
+        uint32_t lost = dropped - s_dropped_reported;
+        buf[0] = (uint8_t)(LOG_HEADER_LEN + 4U);
+        buf[1] = (uint8_t)DA7281_LOG_SITE_DROPPED;
+        buf[2] = (uint8_t)(DA7281_LOG_SITE_DROPPED >> 8);
+        for (uint8_t i = 0; i < 4U; i++) {
+            buf[3U + i] = (uint8_t)(now >> (8U * i));
+            buf[7U + i] = (uint8_t)(lost >> (8U * i));
+        }
+        out = LOG_HEADER_LEN + 4U;
+        s_dropped_reported = dropped;
+    }
+
+    uint32_t tail = atomic_load_explicit(&s_tail, memory_order_relaxed);
+    for (;;) {
+        uint8_t len = *(volatile uint8_t *)&s_buf[tail & LOG_MASK];
+        if ((len == 0U) || ((out + len) > size)) {
+            break;                          /* Not committed yet, or no room */
+        }
+        atomic_thread_fence(memory_order_acquire);
+
+        for (uint32_t i = 0; i < len; i++) {
+            buf[out++] = s_buf[(tail + i) & LOG_MASK];
+            s_buf[(tail + i) & LOG_MASK] = 0U;
+        }
+        tail += len;
+        atomic_store_explicit(&s_tail, tail, memory_order_release);
+    }
+
+    return out;
+}
+
+/**
+ * @brief Logger counters since the last reset
+ */
+void da7281_log_get_stats(da7281_log_stats_t *stats)
+{
+    if (stats != NULL) {
+        stats->records = atomic_load_explicit(&s_records, memory_order_relaxed);
+        stats->dropped_full = atomic_load_explicit(&s_dropped_full, memory_order_relaxed);
+        stats->dropped_rate = atomic_load_explicit(&s_dropped_rate, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Empty the buffer and zero the counters
+ */
+void da7281_log_reset(void)
+{
+    memset(s_buf, 0, sizeof(s_buf));
+    atomic_store(&s_head, 0U);
+    atomic_store(&s_tail, 0U);
+    atomic_store(&s_records, 0U);
+    atomic_store(&s_dropped_full, 0U);
+    atomic_store(&s_dropped_rate, 0U);
+    s_dropped_reported = 0U;
+    for (uint8_t i = 0; i < LOG_LEVELS; i++) {
+        s_rate_start[i] = da7281_bus_get_ops()->now();
+        atomic_store(&s_rate_count[i], 0U);
+    }
+}
+
+#endif /* DA7281_LOG_BACKEND == 4 */
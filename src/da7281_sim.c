@@ -0,0 +1,388 @@
+/**
+ * @file da7281_sim.c
+ * @brief Behavioral DA7281 Model for Host Builds
+ * @author A. R. Ansari
+ * @date 2024-11-21
+ *
+ * Register semantics, TOP_CTL1 mode transitions and nIRQ of the simulated
+ * devices behind the host bus backend. See da7281_sim.h for the rules.
+ */
+
+#include "da7281_sim.h"
+#include "da7281_registers.h"
+#include <string.h>
+
+/* ========================================================================
+ * Private Definitions
+ * ======================================================================== */
+
+#define SIM_FIRST_ADDR      (0x48U)
+
+/** Register access kinds */
+enum {
+    SIM_REG_RESERVED = 0,   /**< Reads 0, writes ignored */
+    SIM_REG_RW,             /**< Plain read/write */
+    SIM_REG_RO,             /**< Read-only, writes ignored */
+    SIM_REG_W1C             /**< Write 1 to clear */
+};
+
+/** One simulated device */
+typedef struct {
+    uint8_t regs[256];
+    uint8_t ptr;            /**< Register pointer (auto-increments) */
+    bool absent;            /**< NACK the address */
+    bool nirq;              /**< nIRQ asserted */
+    bool seq_busy;          /**< Sequence playing */
+    uint64_t seq_end_ns;    /**< End of playback */
+    uint64_t seq_last_end_ns; /**< End of the last segment that stopped */
+    uint32_t seq_us;        /**< Playback time of one pass */
+    uint32_t seq_gap_us;    /**< Idle time before the latest segment */
+    uint32_t seq_segments;  /**< Segments started since reset */
+} sim_device_t;
+
+/* ========================================================================
+ * Private Variables
+ * ======================================================================== */
+
+static sim_device_t s_dev[DA7281_SIM_INSTANCES][DA7281_SIM_DEVICES];
+static da7281_sim_irq_handler_t s_irq_handler;
+
+/** Virtual time of the last da7281_sim_advance() */
+static uint64_t s_now_ns;
+
+/** Register kinds (DA7281 Datasheet v3.1, Table 20); SNP memory is read/write */
+static const uint8_t s_reg_kind[DA7281_REG_SNP_MEM_BASE] = {
+    [DA7281_REG_CHIP_REV]                 = SIM_REG_RO,
+    [DA7281_REG_IRQ_EVENT1]               = SIM_REG_W1C,
+    [DA7281_REG_IRQ_EVENT_WARNING_DIAG]   = SIM_REG_RO,
+    [DA7281_REG_IRQ_EVENT_SEQ_DIAG]       = SIM_REG_RO,
+    [DA7281_REG_IRQ_STATUS1]              = SIM_REG_RO,
+    [DA7281_REG_IRQ_MASK1]                = SIM_REG_RW,
+    [DA7281_REG_CIF_I2C1]                 = SIM_REG_RW,
+    [DA7281_REG_CIF_I2C2]                 = SIM_REG_RW,
+    [DA7281_REG_LRA_PER_H]                = SIM_REG_RW,
+    [DA7281_REG_LRA_PER_L]                = SIM_REG_RW,
+    [DA7281_REG_ACTUATOR_NOMMAX]          = SIM_REG_RW,
+    [DA7281_REG_ACTUATOR_ABSMAX]          = SIM_REG_RW,
+    [DA7281_REG_ACTUATOR_IMAX]            = SIM_REG_RW,
+    [DA7281_REG_V2I_FACTOR_H]             = SIM_REG_RW,
+    [DA7281_REG_V2I_FACTOR_L]             = SIM_REG_RW,
+    [DA7281_REG_CALIB_IMP_H]              = SIM_REG_RW,
+    [DA7281_REG_CALIB_IMP_L]              = SIM_REG_RW,
+    [DA7281_REG_TOP_CFG1]                 = SIM_REG_RW,
+    [DA7281_REG_TOP_CFG2]                 = SIM_REG_RW,
+    [DA7281_REG_TOP_CFG3]                 = SIM_REG_RW,
+    [DA7281_REG_TOP_CFG4]                 = SIM_REG_RW,
+    [DA7281_REG_TOP_INT_CFG1]             = SIM_REG_RW,
+    [DA7281_REG_TOP_INT_CFG6_H]           = SIM_REG_RW,
+    [DA7281_REG_TOP_INT_CFG6_L]           = SIM_REG_RW,
+    [DA7281_REG_TOP_INT_CFG7_H]           = SIM_REG_RW,
+    [DA7281_REG_TOP_INT_CFG7_L]           = SIM_REG_RW,
+    [DA7281_REG_TOP_INT_CFG8]             = SIM_REG_RW,
+    [DA7281_REG_TOP_CTL1]                 = SIM_REG_RW,    /* See sim_write_top_ctl1() */
+    [DA7281_REG_TOP_CTL2]                 = SIM_REG_RW,
+    [DA7281_REG_SEQ_CTL1]                 = SIM_REG_RW,
+    [DA7281_REG_SEQ_CTL2]                 = SIM_REG_RW,
+    [DA7281_REG_GPI_CTL]                  = SIM_REG_RW,
+    [DA7281_REG_MEM_CTL1]                 = SIM_REG_RW,
+    [DA7281_REG_MEM_CTL2]                 = SIM_REG_RW,
+    [DA7281_REG_POLARITY]                 = SIM_REG_RW,
+    [DA7281_REG_TOP_CFG5]                 = SIM_REG_RW,
+    [DA7281_REG_IRQ_EVENT_ACTUATOR_FAULT] = SIM_REG_W1C,
+    [DA7281_REG_IRQ_STATUS2]              = SIM_REG_RO,
+    [DA7281_REG_IRQ_MASK2]                = SIM_REG_RW,
+};
+
+/* ========================================================================
+ * Private Functions
+ * ======================================================================== */
+
+/**
+ * @brief Device model at an address, or NULL
+ */
+static sim_device_t *sim_device(uint8_t instance, uint8_t address)
+{
+    if ((instance >= DA7281_SIM_INSTANCES) ||
+        (address < SIM_FIRST_ADDR) || (address >= (SIM_FIRST_ADDR + DA7281_SIM_DEVICES))) {
+        return NULL;
+    }
+    return &s_dev[instance][address - SIM_FIRST_ADDR];
+}
+
+static uint8_t sim_reg_kind(uint8_t reg)
+{
+    if (reg < DA7281_REG_SNP_MEM_BASE) {
+        return s_reg_kind[reg];
+    }
+    return (reg <= DA7281_REG_SNP_MEM_END) ? (uint8_t)SIM_REG_RW : (uint8_t)SIM_REG_RESERVED;
+}
+
+/**
+ * @brief Recompute nIRQ and report an edge
+ */
+static void sim_update_irq(sim_device_t *dev, uint8_t instance, uint8_t address)
+{
+    bool level = (dev->regs[DA7281_REG_IRQ_EVENT1] & (uint8_t)~dev->regs[DA7281_REG_IRQ_MASK1]) != 0U;
+    if (level != dev->nirq) {
+        dev->nirq = level;
+        if (s_irq_handler != NULL) {
+            s_irq_handler(instance, address, level);
+        }
+    }
+}
+
+static bool sim_mode_active(uint8_t mode)
+{
+    return (mode >= DA7281_OP_MODE_DRO) && (mode <= DA7281_OP_MODE_ETWM);
+}
+
+/**
+ * @brief Leave the current mode for INACTIVE, aborting playback
+ */
+static void sim_force_inactive(sim_device_t *dev)
+{
+    dev->seq_busy = false;
+    dev->regs[DA7281_REG_TOP_CTL1] &= (uint8_t)~(DA7281_TOP_CTL1_OP_MODE_MASK | DA7281_TOP_CTL1_SEQ_START);
+}
+
+/**
+ * @brief Start the segment selected by SEQ_CTL2 at a given time
+ *
+ * The sequencer latches SEQ_CTL2 at the start. With SEQ_CTL1.SEQ_CONTINUE
+ * set it signals E_SEQ_CONTINUE at once: SEQ_CTL2 may now be rewritten
+ * with the segment to chain.
+ */
+static void sim_seq_begin(sim_device_t *dev, uint64_t start_ns)
+{
+    uint8_t loops = (uint8_t)(dev->regs[DA7281_REG_SEQ_CTL2] >> DA7281_SEQ_CTL2_PS_SEQ_LOOP_SHIFT);
+    dev->seq_busy = true;
+    dev->seq_end_ns = start_ns + ((uint64_t)dev->seq_us * 1000U * (loops + 1U));
+    dev->seq_segments++;
+    if ((dev->regs[DA7281_REG_SEQ_CTL1] & DA7281_SEQ_CTL1_SEQ_CONTINUE) != 0U) {
+        dev->regs[DA7281_REG_IRQ_EVENT1] |= DA7281_IRQ_EVENT1_E_SEQ_CONTINUE;
+    }
+}
+
+/**
+ * @brief TOP_CTL1 write: mode transition and sequencer start
+ */
+static void sim_write_top_ctl1(sim_device_t *dev, uint8_t value)
+{
+    uint8_t old_mode = dev->regs[DA7281_REG_TOP_CTL1] & DA7281_TOP_CTL1_OP_MODE_MASK;
+    uint8_t mode = value & DA7281_TOP_CTL1_OP_MODE_MASK;
+
+    if (!sim_mode_active(mode) && (mode != DA7281_OP_MODE_INACTIVE) && (mode != DA7281_OP_MODE_STANDBY)) {
+        mode = old_mode;    /* Reserved code */
+    }
+
+    bool configured = (dev->regs[DA7281_REG_ACTUATOR_NOMMAX] != 0U) &&
+                      ((dev->regs[DA7281_REG_LRA_PER_H] | dev->regs[DA7281_REG_LRA_PER_L]) != 0U);
+    if (sim_mode_active(mode) && !configured) {
+        mode = DA7281_OP_MODE_INACTIVE;
+        dev->regs[DA7281_REG_IRQ_EVENT1] |= DA7281_IRQ_EVENT1_E_ACTUATOR_FAULT;
+    }
+
+    /* Changing mode or clearing SEQ_START stops playback */
+    if ((mode != old_mode) || ((value & DA7281_TOP_CTL1_SEQ_START) == 0U)) {
+        dev->seq_busy = false;
+    }
+
+    uint8_t seq_start = 0U;
+    if ((value & DA7281_TOP_CTL1_SEQ_START) != 0U) {
+        if ((mode == DA7281_OP_MODE_RTWM) || (mode == DA7281_OP_MODE_ETWM)) {
+            if (!dev->seq_busy) {
+                dev->seq_gap_us = (dev->seq_segments == 0U) ? 0U :
+                                  (uint32_t)((s_now_ns - dev->seq_last_end_ns) / 1000U);
+                sim_seq_begin(dev, s_now_ns);
+            }
+            seq_start = DA7281_TOP_CTL1_SEQ_START;
+        } else {
+            dev->regs[DA7281_REG_IRQ_EVENT1] |= DA7281_IRQ_EVENT1_E_SEQ_FAULT;
+        }
+    }
+
+    dev->regs[DA7281_REG_TOP_CTL1] = (uint8_t)((value & (uint8_t)~(DA7281_TOP_CTL1_OP_MODE_MASK |
+                                                                   DA7281_TOP_CTL1_SEQ_START)) |
+                                               mode | seq_start);
+}
+
+/* ========================================================================
+ * Bus Model Interface
+ * ======================================================================== */
+
+bool da7281_sim_select(uint8_t instance, uint8_t address)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    return (dev != NULL) && !dev->absent;
+}
+
+void da7281_sim_write(uint8_t instance, uint8_t address, uint8_t byte, bool first)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    if (dev == NULL) {
+        return;
+    }
+
+    if (first) {
+        dev->ptr = byte;
+        return;
+    }
+
+    uint8_t reg = dev->ptr++;
+    switch (sim_reg_kind(reg)) {
+        case SIM_REG_RW:
+            if (reg == DA7281_REG_TOP_CTL1) {
+                sim_write_top_ctl1(dev, byte);
+            } else if ((reg < DA7281_REG_SNP_MEM_BASE) ||
+                       ((dev->regs[DA7281_REG_MEM_CTL2] & DA7281_MEM_CTL2_WAV_MEM_LOCK) != 0U)) {
+                dev->regs[reg] = byte;  /* Locked waveform memory drops writes */
+            }
+            break;
+        case SIM_REG_W1C:
+            dev->regs[reg] &= (uint8_t)~byte;
+            break;
+        default:
+            break;          /* Read-only or reserved */
+    }
+
+    sim_update_irq(dev, instance, address);
+}
+
+uint8_t da7281_sim_read(uint8_t instance, uint8_t address)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    if (dev == NULL) {
+        return 0xFFU;       /* Released bus */
+    }
+    return dev->regs[dev->ptr++];
+}
+
+void da7281_sim_advance(uint64_t now_ns)
+{
+    s_now_ns = now_ns;
+
+    for (uint8_t i = 0; i < DA7281_SIM_INSTANCES; i++) {
+        for (uint8_t d = 0; d < DA7281_SIM_DEVICES; d++) {
+            sim_device_t *dev = &s_dev[i][d];
+            while (dev->seq_busy && (dev->seq_end_ns <= now_ns)) {
+                if ((dev->regs[DA7281_REG_SEQ_CTL1] & DA7281_SEQ_CTL1_SEQ_CONTINUE) != 0U) {
+                    dev->seq_gap_us = 0U;   /* Chained: next segment starts on the same edge */
+                    sim_seq_begin(dev, dev->seq_end_ns);
+                } else {
+                    dev->seq_busy = false;
+                    dev->seq_last_end_ns = dev->seq_end_ns;
+                    dev->regs[DA7281_REG_TOP_CTL1] &= (uint8_t)~DA7281_TOP_CTL1_SEQ_START;
+                    dev->regs[DA7281_REG_IRQ_EVENT1] |= DA7281_IRQ_EVENT1_E_SEQ_DONE;
+                }
+                sim_update_irq(dev, i, (uint8_t)(SIM_FIRST_ADDR + d));
+            }
+        }
+    }
+}
+
+uint64_t da7281_sim_next_event_ns(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (uint8_t i = 0; i < DA7281_SIM_INSTANCES; i++) {
+        for (uint8_t d = 0; d < DA7281_SIM_DEVICES; d++) {
+            const sim_device_t *dev = &s_dev[i][d];
+            if (dev->seq_busy && (dev->seq_end_ns < next)) {
+                next = dev->seq_end_ns;
+            }
+        }
+    }
+
+    return next;
+}
+
+/* ========================================================================
+ * Test Interface
+ * ======================================================================== */
+
+void da7281_sim_reset(void)
+{
+    memset(s_dev, 0, sizeof(s_dev));
+    s_now_ns = 0U;
+
+    for (uint8_t i = 0; i < DA7281_SIM_INSTANCES; i++) {
+        for (uint8_t d = 0; d < DA7281_SIM_DEVICES; d++) {
+            s_dev[i][d].regs[DA7281_REG_CHIP_REV] = DA7281_CHIP_REV_VALUE;
+            s_dev[i][d].regs[DA7281_REG_MEM_CTL1] = DA7281_MEM_CTL1_WAV_MEM_BASE_ADDR;
+            s_dev[i][d].seq_us = DA7281_SIM_SEQ_DEFAULT_US;
+        }
+    }
+}
+
+uint8_t da7281_sim_peek(uint8_t instance, uint8_t address, uint8_t reg)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    return (dev != NULL) ? dev->regs[reg] : 0U;
+}
+
+void da7281_sim_poke(uint8_t instance, uint8_t address, uint8_t reg, uint8_t value)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    if (dev != NULL) {
+        dev->regs[reg] = value;
+    }
+}
+
+void da7281_sim_set_present(uint8_t instance, uint8_t address, bool present)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    if (dev != NULL) {
+        dev->absent = !present;
+    }
+}
+
+void da7281_sim_set_condition(uint8_t instance, uint8_t address, uint8_t bits, bool active)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    if (dev == NULL) {
+        return;
+    }
+
+    if (active) {
+        dev->regs[DA7281_REG_IRQ_STATUS1] |= bits;
+        dev->regs[DA7281_REG_IRQ_EVENT1] |= bits;
+        if ((bits & DA7281_IRQ_EVENT1_FAULT_MASK) != 0U) {
+            sim_force_inactive(dev);
+        }
+    } else {
+        dev->regs[DA7281_REG_IRQ_STATUS1] &= (uint8_t)~bits;
+    }
+
+    sim_update_irq(dev, instance, address);
+}
+
+void da7281_sim_set_seq_duration(uint8_t instance, uint8_t address, uint32_t duration_us)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    if (dev != NULL) {
+        dev->seq_us = duration_us;
+    }
+}
+
+uint32_t da7281_sim_seq_gap_us(uint8_t instance, uint8_t address)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    return (dev != NULL) ? dev->seq_gap_us : 0U;
+}
+
+uint32_t da7281_sim_seq_segments(uint8_t instance, uint8_t address)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    return (dev != NULL) ? dev->seq_segments : 0U;
+}
+
+bool da7281_sim_nirq(uint8_t instance, uint8_t address)
+{
+    sim_device_t *dev = sim_device(instance, address);
+    return (dev != NULL) && dev->nirq;
+}
+
+void da7281_sim_set_irq_handler(da7281_sim_irq_handler_t handler)
+{
+    s_irq_handler = handler;
+}
@@ -47,7 +47,7 @@ echo ""
 rm -f *.o
 
 # Compile da7281.c
-echo "[1/2] Compiling da7281.c..."
+echo "[1/4] Compiling da7281.c..."
 arm-none-eabi-gcc -c src/da7281.c ${CFLAGS} ${INCLUDES} -o da7281.o
 if [ $? -eq 0 ]; then
     echo "✓ da7281.c compiled successfully"
@@ -60,7 +60,7 @@ fi
 echo ""
 
 # Compile da7281_i2c.c
-echo "[2/2] Compiling da7281_i2c.c..."
+echo "[2/4] Compiling da7281_i2c.c..."
 arm-none-eabi-gcc -c src/da7281_i2c.c ${CFLAGS} ${INCLUDES} -o da7281_i2c.o
 if [ $? -eq 0 ]; then
     echo "✓ da7281_i2c.c compiled successfully"
@@ -70,6 +70,32 @@ else
     exit 1
 fi
 
+echo ""
+
+# Compile da7281_bus_nrf.c
+echo "[3/4] Compiling da7281_bus_nrf.c..."
+arm-none-eabi-gcc -c src/da7281_bus_nrf.c ${CFLAGS} ${INCLUDES} -o da7281_bus_nrf.o
+if [ $? -eq 0 ]; then
+    echo "✓ da7281_bus_nrf.c compiled successfully"
+    ls -lh da7281_bus_nrf.o
+else
+    echo "✗ da7281_bus_nrf.c compilation FAILED"
+    exit 1
+fi
+
+echo ""
+
+# Compile da7281_log.c (empty unless DA7281_LOG_BACKEND is 4)
+echo "[4/4] Compiling da7281_log.c..."
+arm-none-eabi-gcc -c src/da7281_log.c ${CFLAGS} ${INCLUDES} -o da7281_log.o
+if [ $? -eq 0 ]; then
+    echo "✓ da7281_log.c compiled successfully"
+    ls -lh da7281_log.o
+else
+    echo "✗ da7281_log.c compilation FAILED"
+    exit 1
+fi
+
 echo ""
 echo "========================================="
 echo "✓ ALL FILES COMPILED SUCCESSFULLY!"
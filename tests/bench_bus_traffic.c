@@ -0,0 +1,533 @@
+/**
+ * @file bench_bus_traffic.c
+ * @brief Bus-traffic regression benchmark of the public DA7281 API
+ *
+ * Runs every public call once on the host bus backend, with and without a
+ * shadow cache, and records I2C frames, bytes after the address byte, lock
+ * acquisitions and bus time at 400 kHz. Realistic multi-register updates
+ * are measured both as separate calls and as one da7281_write_set_commit().
+ * SNP uploads are measured per image size.
+ * The numbers are compared with a checked-in baseline; any increase fails
+ * the run.
+ *
+ * Usage:
+ *   bench_bus_traffic <baseline>            compare, exit 1 on regression
+ *   bench_bus_traffic <baseline> --update   rewrite the baseline
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include "da7281.h"
+#include "da7281_bus.h"
+#include "da7281_sim.h"
+
+#define BENCH_MAX_ROWS      (96U)
+#define BENCH_NAME_LEN      (64U)
+
+/** Bus time of one SCL clock at 400 kHz */
+#define BENCH_US_PER_BIT    (2.5)
+
+typedef struct {
+    char name[BENCH_NAME_LEN];
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t locks;
+    double bus_us;
+} bench_row_t;
+
+static bench_row_t s_rows[BENCH_MAX_ROWS];
+static unsigned s_row_count;
+
+static const da7281_lra_config_t s_lra_config = {
+    .resonant_freq_hz = 170,
+    .impedance_ohm = 6.75F,
+    .nom_max_v_rms = 2.5F,
+    .abs_max_v_peak = 3.5F,
+    .max_current_ma = 350
+};
+
+/* ========================================================================
+ * Measurement
+ * ======================================================================== */
+
+static void bench_irq_event(da7281_device_t *device, da7281_event_t event,
+                            const da7281_status_block_t *status, void *context)
+{
+    (void)device;
+    (void)event;
+    (void)status;
+    (void)context;
+}
+
+static void bench_begin(void)
+{
+    da7281_bus_host_clear_stats();
+}
+
+static void bench_end(const char *call, const char *variant)
+{
+    da7281_bus_host_stats_t stats;
+    da7281_bus_host_stats(&stats);
+
+    assert(s_row_count < BENCH_MAX_ROWS);
+    bench_row_t *row = &s_rows[s_row_count++];
+    (void)snprintf(row->name, sizeof(row->name), "%s%s", call, variant);
+    row->frames = stats.transactions;
+    row->bytes = stats.bytes;
+    row->locks = stats.lock_takes;
+    row->bus_us = (double)stats.bits * BENCH_US_PER_BIT;
+}
+
+/**
+ * @brief Run every public call on two devices of bus 0
+ *
+ * @param cache Two shadow caches, one per device (NULL = none)
+ * @param variant Suffix of the row names
+ */
+static void bench_api(da7281_reg_cache_t *cache, const char *variant)
+{
+    da7281_bus_host_reset();
+
+    da7281_device_t dev[2] = {
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4A, .cache = cache},
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4B, .cache = (cache != NULL) ? &cache[1] : NULL}
+    };
+    da7281_device_t *pair[2] = {&dev[0], &dev[1]};
+    const uint8_t amps[2] = {0x40, 0x41};
+    da7281_operation_mode_t mode;
+    da7281_status_block_t status;
+    uint8_t chip_rev;
+    da7281_lra_regs_t regs;
+
+    assert(da7281_lra_compute(&s_lra_config, &regs) == DA7281_OK);
+    const da7281_reg_value_t lra_image_regs[] = {
+        {DA7281_REG_LRA_PER_H, (uint8_t)(regs.lra_per >> 8)},
+        {DA7281_REG_LRA_PER_L, (uint8_t)(regs.lra_per & 0xFF)},
+        {DA7281_REG_ACTUATOR_NOMMAX, regs.nommax},
+        {DA7281_REG_ACTUATOR_ABSMAX, regs.absmax},
+        {DA7281_REG_ACTUATOR_IMAX, regs.imax},
+        {DA7281_REG_V2I_FACTOR_H, (uint8_t)(regs.v2i_factor >> 8)},
+        {DA7281_REG_V2I_FACTOR_L, (uint8_t)(regs.v2i_factor & 0xFF)}
+    };
+    const da7281_register_image_t lra_image = {"bench", lra_image_regs, 7U};
+
+    assert(da7281_init(&dev[1]) == DA7281_OK);
+    assert(da7281_configure_lra(&dev[1], &s_lra_config) == DA7281_OK);
+
+    bench_begin();
+    assert(da7281_init(&dev[0]) == DA7281_OK);
+    bench_end("da7281_init", variant);
+
+    bench_begin();
+    assert(da7281_configure_lra(&dev[0], &s_lra_config) == DA7281_OK);
+    bench_end("da7281_configure_lra", variant);
+
+    bench_begin();
+    assert(da7281_apply_register_image(&dev[0], &lra_image) == DA7281_OK);
+    bench_end("da7281_apply_register_image", variant);
+
+    bench_begin();
+    assert(da7281_configure_lra_diff(&dev[0], &s_lra_config, NULL) == DA7281_OK);
+    bench_end("da7281_configure_lra_diff", variant);
+
+    bench_begin();
+    assert(da7281_apply_register_image_diff(&dev[0], &lra_image, NULL) == DA7281_OK);
+    bench_end("da7281_apply_register_image_diff", variant);
+
+    bench_begin();
+    assert(da7281_set_operation_mode(&dev[0], DA7281_MODE_DRO) == DA7281_OK);
+    bench_end("da7281_set_operation_mode", variant);
+
+    bench_begin();
+    assert(da7281_set_operation_mode_policy(&dev[0], DA7281_MODE_DRO, DA7281_VERIFY_NEVER) == DA7281_OK);
+    bench_end("da7281_set_operation_mode_policy", variant);
+
+    assert(da7281_set_operation_mode_policy(&dev[0], DA7281_MODE_DRO, DA7281_VERIFY_DEFERRED) == DA7281_OK);
+    bench_begin();
+    assert(da7281_verify_flush(&dev[0]) == DA7281_OK);
+    bench_end("da7281_verify_flush", variant);
+
+    bench_begin();
+    assert(da7281_get_operation_mode(&dev[0], &mode) == DA7281_OK);
+    bench_end("da7281_get_operation_mode", variant);
+
+    bench_begin();
+    assert(da7281_set_amplifier_enable(&dev[0], true) == DA7281_OK);
+    bench_end("da7281_set_amplifier_enable", variant);
+
+    bench_begin();
+    assert(da7281_set_override_amplitude(&dev[0], 0x7F) == DA7281_OK);
+    bench_end("da7281_set_override_amplitude", variant);
+
+    bench_begin();
+    assert(da7281_set_override_amplitude_multi(pair, amps, 2U) == DA7281_OK);
+    bench_end("da7281_set_override_amplitude_multi", variant);
+
+    bench_begin();
+    assert(da7281_stop(&dev[0]) == DA7281_OK);
+    bench_end("da7281_stop", variant);
+
+    bench_begin();
+    assert(da7281_play_dro(&dev[0], 0x40U) == DA7281_OK);
+    bench_end("da7281_play_dro", variant);
+
+    bench_begin();
+    assert(da7281_play_sequence(&dev[0], 1U, 0U, NULL, NULL) == DA7281_OK);
+    bench_end("da7281_play_sequence", variant);
+
+    da7281_bus_get_ops()->delay((DA7281_SIM_SEQ_DEFAULT_US / 1000U) + 1U);
+    bench_begin();
+    assert(da7281_handle_events(&dev[0], NULL) == DA7281_OK);
+    bench_end("da7281_handle_events", variant);
+
+    bench_begin();
+    assert(da7281_queue_sequence(&dev[0], 2U, 0U) == DA7281_OK);
+    bench_end("da7281_queue_sequence", variant);
+
+    bench_begin();
+    assert(da7281_play_sequence(&dev[0], 1U, 0U, NULL, NULL) == DA7281_OK);
+    bench_end("da7281_play_sequence/chained", variant);
+
+    bench_begin();
+    assert(da7281_handle_events(&dev[0], NULL) == DA7281_OK);   /* E_SEQ_CONTINUE: arm 2 */
+    bench_end("da7281_handle_events/seq_continue", variant);
+    assert(da7281_stop(&dev[0]) == DA7281_OK);
+
+    da7281_bus_host_wire_irq(0, dev[0].i2c_address, 0U);
+    bench_begin();
+    assert(da7281_irq_configure(&dev[0], 0U, bench_irq_event, NULL) == DA7281_OK);
+    bench_end("da7281_irq_configure", variant);
+
+    assert(da7281_play_sequence(&dev[0], 1U, 0U, NULL, NULL) == DA7281_OK);
+    bench_begin();
+    da7281_bus_get_ops()->delay((DA7281_SIM_SEQ_DEFAULT_US / 1000U) + 1U);  /* SEQ_DONE from nIRQ */
+    bench_end("da7281_irq_service", variant);
+    assert(!dev[0].seq_pending);
+    assert(da7281_irq_configure(&dev[0], 0U, NULL, NULL) == DA7281_OK);
+
+    bench_begin();
+    assert(da7281_read_status_block(&dev[0], &status) == DA7281_OK);
+    bench_end("da7281_read_status_block", variant);
+
+    bench_begin();
+    assert(da7281_read_chip_revision(&dev[0], &chip_rev) == DA7281_OK);
+    bench_end("da7281_read_chip_revision", variant);
+
+    bench_begin();
+    assert(da7281_deinit(&dev[0]) == DA7281_OK);
+    bench_end("da7281_deinit", variant);
+
+    (void)da7281_deinit(&dev[1]);
+}
+
+/* ========================================================================
+ * Write Sets
+ * ======================================================================== */
+
+/** A multi-register update, entries in the order driver code issues them */
+typedef struct {
+    const char *name;
+    const da7281_write_entry_t *entries;
+    uint8_t count;
+} bench_write_set_t;
+
+static const da7281_write_entry_t s_set_actuator[] = {
+    {DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_ACTUATOR_TYPE, DA7281_TOP_CFG1_ACTUATOR_TYPE},
+    {DA7281_REG_ACTUATOR_IMAX, 0xFFU, 0x2FU},
+    {DA7281_REG_ACTUATOR_NOMMAX, 0xFFU, 0x6AU},
+    {DA7281_REG_ACTUATOR_ABSMAX, 0xFFU, 0x95U},
+    {DA7281_REG_V2I_FACTOR_H, 0xFFU, 0x00U},
+    {DA7281_REG_V2I_FACTOR_L, 0xFFU, 0xCCU},
+    {DA7281_REG_LRA_PER_H, 0xFFU, 0x11U},
+    {DA7281_REG_LRA_PER_L, 0xFFU, 0x3CU},
+    {DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_ACCEL_EN, DA7281_TOP_CFG1_ACCEL_EN},
+    {DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_RAPID_STOP_EN, DA7281_TOP_CFG1_RAPID_STOP_EN}
+};
+
+static const da7281_write_entry_t s_set_dro_start[] = {
+    {DA7281_REG_TOP_CTL2, 0xFFU, 0x60U},
+    {DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_AMP_EN, DA7281_TOP_CFG1_AMP_EN},
+    {DA7281_REG_TOP_CTL1, DA7281_TOP_CTL1_OP_MODE_MASK, DA7281_OP_MODE_DRO}
+};
+
+static const da7281_write_entry_t s_set_dro_stop[] = {
+    {DA7281_REG_TOP_CTL1, DA7281_TOP_CTL1_OP_MODE_MASK, DA7281_OP_MODE_INACTIVE},
+    {DA7281_REG_TOP_CTL2, 0xFFU, 0x00U},
+    {DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_AMP_EN, 0x00U}
+};
+
+static const da7281_write_entry_t s_set_interrupts[] = {
+    {DA7281_REG_IRQ_MASK1, 0xFFU, 0x0FU},
+    {DA7281_REG_IRQ_MASK2, 0xFFU, 0x3FU},
+    {DA7281_REG_TOP_INT_CFG1, 0x03U, 0x01U},
+    {DA7281_REG_TOP_INT_CFG8, 0xFFU, 0x23U},
+    {DA7281_REG_TOP_INT_CFG6_H, 0xFFU, 0x05U},
+    {DA7281_REG_TOP_INT_CFG6_L, 0xFFU, 0x14U},
+    {DA7281_REG_TOP_INT_CFG7_H, 0xFFU, 0x05U},
+    {DA7281_REG_TOP_INT_CFG7_L, 0xFFU, 0x14U}
+};
+
+static const da7281_write_entry_t s_set_sequence[] = {
+    {DA7281_REG_SEQ_CTL2, 0xFFU, 0x01U},
+    {DA7281_REG_MEM_CTL1, 0xFFU, DA7281_REG_SNP_MEM_BASE},
+    {DA7281_REG_GPI_CTL, 0xFFU, 0x00U},
+    {DA7281_REG_SEQ_CTL1, 0x01U, 0x01U},
+    {DA7281_REG_TOP_CTL1, DA7281_TOP_CTL1_OP_MODE_MASK, DA7281_OP_MODE_RTWM}
+};
+
+#define BENCH_SET(name, entries) {name, entries, (uint8_t)(sizeof(entries) / sizeof(entries[0]))}
+
+static const bench_write_set_t s_write_sets[] = {
+    BENCH_SET("actuator_setup", s_set_actuator),
+    BENCH_SET("dro_start", s_set_dro_start),
+    BENCH_SET("dro_stop", s_set_dro_stop),
+    BENCH_SET("interrupt_setup", s_set_interrupts),
+    BENCH_SET("sequence_setup", s_set_sequence)
+};
+
+/**
+ * @brief Apply each write set as separate calls and as one commit
+ *
+ * Separate calls use da7281_write_register() for whole registers and
+ * da7281_modify_register() for masked ones, in table order. The device
+ * returns to INACTIVE between runs so both see the same starting state.
+ *
+ * @param cache Shadow cache for the device (NULL = none)
+ * @param variant Suffix of the row names
+ */
+static void bench_write_sets(da7281_reg_cache_t *cache, const char *variant)
+{
+    da7281_bus_host_reset();
+
+    da7281_device_t dev = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4A, .cache = cache};
+    char name[BENCH_NAME_LEN];
+    assert(da7281_init(&dev) == DA7281_OK);
+    assert(da7281_configure_lra(&dev, &s_lra_config) == DA7281_OK);
+
+    printf("\nWrite sets%s: frames (locks)\n", variant);
+    printf("  %-18s %10s %10s %8s\n", "set", "separate", "commit", "saved");
+    for (uint8_t n = 0; n < (sizeof(s_write_sets) / sizeof(s_write_sets[0])); n++) {
+        const bench_write_set_t *ws = &s_write_sets[n];
+
+        bench_begin();
+        for (uint8_t i = 0; i < ws->count; i++) {
+            const da7281_write_entry_t *e = &ws->entries[i];
+            if (e->mask == 0xFFU) {
+                assert(da7281_write_register(&dev, e->reg, e->value) == DA7281_OK);
+            } else {
+                assert(da7281_modify_register(&dev, e->reg, e->mask, e->value) == DA7281_OK);
+            }
+        }
+        (void)snprintf(name, sizeof(name), "separate/%s", ws->name);
+        bench_end(name, variant);
+        const bench_row_t *separate = &s_rows[s_row_count - 1U];
+
+        assert(da7281_set_operation_mode(&dev, DA7281_MODE_INACTIVE) == DA7281_OK);
+
+        da7281_write_set_t set;
+        bench_begin();
+        assert(da7281_write_set_init(&set) == DA7281_OK);
+        for (uint8_t i = 0; i < ws->count; i++) {
+            const da7281_write_entry_t *e = &ws->entries[i];
+            assert(da7281_write_set_add(&set, e->reg, e->mask, e->value) == DA7281_OK);
+        }
+        assert(da7281_write_set_commit(&dev, &set) == DA7281_OK);
+        (void)snprintf(name, sizeof(name), "write_set/%s", ws->name);
+        bench_end(name, variant);
+        const bench_row_t *commit = &s_rows[s_row_count - 1U];
+
+        assert(da7281_set_operation_mode(&dev, DA7281_MODE_INACTIVE) == DA7281_OK);
+
+        printf("  %-18s %5u (%2u) %5u (%2u) %8d\n", ws->name,
+               (unsigned)separate->frames, (unsigned)separate->locks,
+               (unsigned)commit->frames, (unsigned)commit->locks,
+               (int)separate->frames - (int)commit->frames);
+    }
+
+    (void)da7281_deinit(&dev);
+}
+
+/* ========================================================================
+ * Waveform Memory
+ * ======================================================================== */
+
+/**
+ * @brief Upload and verify SNP images of growing size
+ *
+ * Each upload starts from INACTIVE with the memory locked, as after
+ * da7281_init(); the table shows bus time per image size.
+ *
+ * @param cache Shadow cache for the device (NULL = none)
+ * @param variant Suffix of the row names
+ */
+static void bench_snp(da7281_reg_cache_t *cache, const char *variant)
+{
+    static const uint8_t sizes[] = {8U, 25U, 50U, DA7281_SNP_MEM_SIZE};
+    da7281_bus_host_reset();
+
+    da7281_device_t dev = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4A, .cache = cache};
+    char name[BENCH_NAME_LEN];
+    uint8_t image[DA7281_SNP_MEM_SIZE];
+    for (uint8_t i = 0; i < DA7281_SNP_MEM_SIZE; i++) {
+        image[i] = (uint8_t)(0xA5U ^ i);
+    }
+    assert(da7281_init(&dev) == DA7281_OK);
+
+    printf("\nSNP upload%s: image size -> bus time at 400 kHz\n", variant);
+    for (uint8_t n = 0; n < (sizeof(sizes) / sizeof(sizes[0])); n++) {
+        bench_begin();
+        assert(da7281_snp_upload(&dev, image, sizes[n]) == DA7281_OK);
+        (void)snprintf(name, sizeof(name), "da7281_snp_upload/%u", (unsigned)sizes[n]);
+        bench_end(name, variant);
+        const bench_row_t *row = &s_rows[s_row_count - 1U];
+        printf("  %3u bytes: %u frames, %7.1f us (%.1f us/byte)\n", (unsigned)sizes[n],
+               (unsigned)row->frames, row->bus_us, row->bus_us / sizes[n]);
+    }
+
+    bench_begin();
+    assert(da7281_snp_verify(&dev, DA7281_SNP_MEM_SIZE, da7281_snp_crc(image, DA7281_SNP_MEM_SIZE)) == DA7281_OK);
+    (void)snprintf(name, sizeof(name), "da7281_snp_verify/%u", (unsigned)DA7281_SNP_MEM_SIZE);
+    bench_end(name, variant);
+
+    (void)da7281_deinit(&dev);
+}
+
+/* ========================================================================
+ * Baseline
+ * ======================================================================== */
+
+static bool baseline_write(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        return false;
+    }
+
+    fprintf(f, "# DA7281 bus-traffic baseline (tests/bench_bus_traffic.c)\n");
+    fprintf(f, "# Regenerate with: make -C tests bench-update\n");
+    fprintf(f, "# %-42s %6s %6s %6s %9s\n", "call", "frames", "bytes", "locks", "bus_us");
+    for (unsigned i = 0; i < s_row_count; i++) {
+        fprintf(f, "%-44s %6u %6u %6u %9.1f\n", s_rows[i].name,
+                (unsigned)s_rows[i].frames, (unsigned)s_rows[i].bytes,
+                (unsigned)s_rows[i].locks, s_rows[i].bus_us);
+    }
+
+    return fclose(f) == 0;
+}
+
+/**
+ * @brief Compare the measured rows with the baseline file
+ *
+ * @return Number of regressions (missing rows count as regressions)
+ */
+static unsigned baseline_compare(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        printf("❌ Cannot open baseline %s\n", path);
+        return 1U;
+    }
+
+    bench_row_t base[BENCH_MAX_ROWS];
+    unsigned base_count = 0;
+    char line[160];
+    while ((fgets(line, sizeof(line), f) != NULL) && (base_count < BENCH_MAX_ROWS)) {
+        bench_row_t *b = &base[base_count];
+        unsigned frames, bytes, locks;
+        if ((line[0] == '#') ||
+            (sscanf(line, "%63s %u %u %u %lf", b->name, &frames, &bytes, &locks, &b->bus_us) != 5)) {
+            continue;
+        }
+        b->frames = frames;
+        b->bytes = bytes;
+        b->locks = locks;
+        base_count++;
+    }
+    (void)fclose(f);
+
+    unsigned regressions = 0;
+    printf("\n  %-44s %9s %9s %9s %15s\n", "call", "frames", "bytes", "locks", "bus_us");
+    for (unsigned i = 0; i < s_row_count; i++) {
+        const bench_row_t *r = &s_rows[i];
+        const bench_row_t *b = NULL;
+        for (unsigned j = 0; j < base_count; j++) {
+            if (strcmp(base[j].name, r->name) == 0) {
+                b = &base[j];
+                break;
+            }
+        }
+
+        if (b == NULL) {
+            printf("  %-44s %9u %9u %9u %15.1f  ❌ not in baseline\n", r->name,
+                   (unsigned)r->frames, (unsigned)r->bytes, (unsigned)r->locks, r->bus_us);
+            regressions++;
+            continue;
+        }
+
+        bool worse = (r->frames > b->frames) || (r->bytes > b->bytes) ||
+                     (r->locks > b->locks) || (r->bus_us > (b->bus_us + 0.05));
+        bool better = (r->frames < b->frames) || (r->bytes < b->bytes) ||
+                      (r->locks < b->locks) || (r->bus_us < (b->bus_us - 0.05));
+        printf("  %-44s %4u/%-4u %4u/%-4u %4u/%-4u %7.1f/%-7.1f %s\n", r->name,
+               (unsigned)r->frames, (unsigned)b->frames, (unsigned)r->bytes, (unsigned)b->bytes,
+               (unsigned)r->locks, (unsigned)b->locks, r->bus_us, b->bus_us,
+               worse ? "❌ REGRESSION" : (better ? "improved" : ""));
+        if (worse) {
+            regressions++;
+        }
+    }
+
+    return regressions;
+}
+
+int main(int argc, char *argv[])
+{
+    printf("╔════════════════════════════════════════════╗\n");
+    printf("║  DA7281 HAL Bus-Traffic Benchmark          ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    if (argc < 2) {
+        printf("usage: %s <baseline> [--update]\n", argv[0]);
+        return 2;
+    }
+
+    static da7281_reg_cache_t cache[2];
+    assert(da7281_i2c_configure_pins(0, 4, 5) == DA7281_OK);
+    assert(da7281_bus_init(0) == DA7281_OK);
+
+    bench_api(NULL, "");
+    memset(cache, 0, sizeof(cache));
+    bench_api(cache, ":cached");
+    bench_write_sets(NULL, "");
+    memset(cache, 0, sizeof(cache));
+    bench_write_sets(cache, ":cached");
+    bench_snp(NULL, "");
+    memset(cache, 0, sizeof(cache));
+    bench_snp(cache, ":cached");
+
+    if ((argc > 2) && (strcmp(argv[2], "--update") == 0)) {
+        if (!baseline_write(argv[1])) {
+            printf("❌ Cannot write baseline %s\n", argv[1]);
+            return 1;
+        }
+        printf("Baseline written: %s (%u calls)\n", argv[1], s_row_count);
+        return 0;
+    }
+
+    printf("\nMeasured / baseline (bus time at 400 kHz):");
+    unsigned regressions = baseline_compare(argv[1]);
+    if (regressions != 0U) {
+        printf("\n❌ FAIL: %u call(s) regressed against %s\n", regressions, argv[1]);
+        return 1;
+    }
+
+    printf("\n╔════════════════════════════════════════════╗\n");
+    printf("║  ✅ NO BUS-TRAFFIC REGRESSIONS             ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    return 0;
+}
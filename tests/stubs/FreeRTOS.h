@@ -0,0 +1,33 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host stand-in for the FreeRTOS kernel header
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t StackType_t;
+
+/** Storage for a statically allocated semaphore (layout-compatible with mock_bus.c) */
+typedef struct {
+    void *opaque[4];
+} StaticSemaphore_t;
+
+#define configSUPPORT_STATIC_ALLOCATION     1
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configTICK_RATE_HZ                  1000
+#define configMAX_PRIORITIES                7
+
+#define pdTRUE                  (1)
+#define pdFALSE                 (0)
+#define pdPASS                  (pdTRUE)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+
+#endif /* FREERTOS_H */
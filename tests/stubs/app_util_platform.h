@@ -0,0 +1,36 @@
+/**
+ * @file app_util_platform.h
+ * @brief Host stand-in for the nRF5 SDK platform utilities
+ *
+ * The host harness is single-threaded, so critical regions only track
+ * nesting for assertions.
+ */
+
+#ifndef APP_UTIL_PLATFORM_H
+#define APP_UTIL_PLATFORM_H
+
+#include <stdint.h>
+
+#define APP_IRQ_PRIORITY_HIGH       (2U)
+
+extern volatile uint32_t mock_critical_nesting;
+
+/* CMSIS (via nrf.h): active exception number, non-zero inside TWI event handlers */
+uint32_t __get_IPSR(void);
+
+#define CRITICAL_REGION_ENTER()     do { mock_critical_nesting++; } while (0)
+#define CRITICAL_REGION_EXIT()      do { mock_critical_nesting--; } while (0)
+
+static inline void app_util_critical_region_enter(uint8_t *p_nested)
+{
+    *p_nested = 0U;
+    mock_critical_nesting++;
+}
+
+static inline void app_util_critical_region_exit(uint8_t nested)
+{
+    (void)nested;
+    mock_critical_nesting--;
+}
+
+#endif /* APP_UTIL_PLATFORM_H */
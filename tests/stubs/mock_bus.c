@@ -0,0 +1,764 @@
+/**
+ * @file mock_bus.c
+ * @brief Recording I2C bus used by the host tests
+ */
+
+#include "mock_bus.h"
+#include "nrf_drv_twi.h"
+#include "nrfx_twim.h"
+#include "nrf_drv_gpiote.h"
+#include "nrf_timer.h"
+#include "app_util_platform.h"
+#include "semphr.h"
+#include "task.h"
+#include <string.h>
+
+#define MOCK_BUS_INSTANCES      (2U)
+#define MOCK_BUS_FIRST_ADDR     (0x48U)
+#define MOCK_BUS_DEVICES        (4U)
+#define MOCK_BUS_TWI_IRQN       (19U)   /* IPSR of SPIM0_..._TWI0_IRQn (16 + 3) */
+
+struct mock_semaphore {
+    int is_mutex;
+    int count;
+    uint64_t given_bits;        /* Bus time of the last give from an interrupt */
+};
+
+struct mock_task {
+    uint32_t notifications;
+    uint64_t notified_bits;     /* Bus time of the last notification */
+};
+
+volatile uint32_t mock_critical_nesting;
+
+static uint8_t s_regs[MOCK_BUS_INSTANCES][MOCK_BUS_DEVICES][256];
+static uint8_t s_reg_ptr[MOCK_BUS_INSTANCES][MOCK_BUS_DEVICES];
+static int s_present[MOCK_BUS_INSTANCES][MOCK_BUS_DEVICES];
+static int s_frame_open[MOCK_BUS_INSTANCES];
+static mock_bus_stats_t s_stats;
+static struct mock_semaphore s_semaphores[16];
+static unsigned s_semaphore_count;
+static uint32_t s_heap_allocs;
+static struct mock_task s_task;
+static struct mock_task s_other_task;
+static int s_current_task;
+static struct mock_task s_created_tasks[4];
+static unsigned s_created_task_count;
+static int s_gpiote_init;
+
+/* Event-driven (non-blocking) TWI state */
+static nrf_drv_twi_evt_handler_t s_handler[MOCK_BUS_INSTANCES];
+static nrfx_twim_evt_handler_t s_twim_handler[MOCK_BUS_INSTANCES];
+static void *s_handler_context[MOCK_BUS_INSTANCES];
+static int s_deferred;
+static int s_fire_on_wait;
+static int s_pending[MOCK_BUS_INSTANCES];
+static nrf_drv_twi_xfer_desc_t s_pending_desc[MOCK_BUS_INSTANCES];
+static uint32_t s_pending_flags[MOCK_BUS_INSTANCES];
+
+/*
+ * Virtual time in bit periods since reset. Each bus has its own clock so
+ * the two buses run in parallel; a frame cannot start before the CPU
+ * issued it (s_cpu_bits), and the CPU catches up with a bus when a task
+ * wakes on a completion given from that bus's interrupt. Spin waits
+ * (DA7281_BUS_LOCK_CRITICAL) are not observed.
+ */
+static uint64_t s_clock_bits[MOCK_BUS_INSTANCES];
+static uint64_t s_cpu_bits;
+static uint64_t s_irq_bits;
+static unsigned s_in_irq;      /* Nesting of TWI event handlers (they may start the next frame) */
+static uint64_t s_write_bits[MOCK_BUS_INSTANCES][MOCK_BUS_DEVICES][256];
+
+/* Foreign traffic injected after each lock acquisition */
+static int s_contender_len[MOCK_BUS_INSTANCES];
+static int s_contender_armed[MOCK_BUS_INSTANCES];
+
+static void mock_bus_clock(uint8_t instance, uint32_t bits)
+{
+    s_stats.bits += bits;
+    s_clock_bits[instance] += bits;
+}
+
+static void mock_bus_cpu_wake(uint64_t bits)
+{
+    if (bits > s_cpu_bits) {
+        s_cpu_bits = bits;
+    }
+}
+
+static void mock_bus_arm_contenders(void)
+{
+    for (unsigned i = 0; i < MOCK_BUS_INSTANCES; i++) {
+        s_contender_armed[i] = (s_contender_len[i] > 0);
+    }
+}
+
+/* Another bus user got in first: one write frame that only costs bus time */
+static void mock_bus_run_contender(uint8_t instance)
+{
+    if (s_contender_armed[instance]) {
+        s_contender_armed[instance] = 0;
+        s_clock_bits[instance] += 1U + 9U + (9U * (uint32_t)s_contender_len[instance]) + 1U;
+    }
+}
+
+static uint8_t *mock_bus_regs(uint8_t instance, uint8_t address, uint8_t **ptr)
+{
+    if ((instance >= MOCK_BUS_INSTANCES) ||
+        (address < MOCK_BUS_FIRST_ADDR) ||
+        (address >= (MOCK_BUS_FIRST_ADDR + MOCK_BUS_DEVICES)) ||
+        !s_present[instance][address - MOCK_BUS_FIRST_ADDR]) {
+        return NULL;
+    }
+    *ptr = &s_reg_ptr[instance][address - MOCK_BUS_FIRST_ADDR];
+    return s_regs[instance][address - MOCK_BUS_FIRST_ADDR];
+}
+
+/* One START (or repeated START) plus the address byte and its ACK */
+static void mock_bus_address_phase(uint8_t instance)
+{
+    s_stats.address_phases++;
+    mock_bus_clock(instance, 1U + 9U);
+    s_frame_open[instance] = 1;
+}
+
+static void mock_bus_stop(uint8_t instance)
+{
+    s_stats.transactions++;
+    mock_bus_clock(instance, 1U);
+    s_frame_open[instance] = 0;
+}
+
+/* Clock one write frame: first byte sets the register pointer, the rest auto-increment */
+static ret_code_t mock_bus_write(uint8_t instance, uint8_t address,
+                                 uint8_t const *p_data, uint32_t length, bool no_stop)
+{
+    uint8_t *ptr;
+    uint8_t *regs = mock_bus_regs(instance, address, &ptr);
+
+    mock_bus_address_phase(instance);
+    if (regs == NULL) {
+        mock_bus_stop(instance);
+        return NRF_ERROR_DRV_TWI_ERR_ANACK;
+    }
+
+    for (uint32_t i = 0; i < length; i++) {
+        if (i == 0U) {
+            *ptr = p_data[0];
+        } else {
+            regs[*ptr] = p_data[i];
+            s_write_bits[instance][address - MOCK_BUS_FIRST_ADDR][*ptr] = s_clock_bits[instance] + 9U;
+            (*ptr)++;
+        }
+        s_stats.bytes++;
+        mock_bus_clock(instance, 9U);
+    }
+
+    if (!no_stop) {
+        mock_bus_stop(instance);
+    }
+    return NRF_SUCCESS;
+}
+
+/* Clock one read frame from the current register pointer */
+static ret_code_t mock_bus_read(uint8_t instance, uint8_t address,
+                                uint8_t *p_data, uint32_t length)
+{
+    uint8_t *ptr;
+    uint8_t *regs = mock_bus_regs(instance, address, &ptr);
+
+    mock_bus_address_phase(instance);
+    if (regs == NULL) {
+        mock_bus_stop(instance);
+        return NRF_ERROR_DRV_TWI_ERR_ANACK;
+    }
+
+    for (uint32_t i = 0; i < length; i++) {
+        p_data[i] = regs[*ptr];
+        (*ptr)++;
+        s_stats.bytes++;
+        mock_bus_clock(instance, 9U);
+    }
+
+    mock_bus_stop(instance);
+    return NRF_SUCCESS;
+}
+
+static ret_code_t mock_bus_run_desc(uint8_t instance, nrf_drv_twi_xfer_desc_t const *desc,
+                                    uint32_t flags)
+{
+    /* The bus cannot start a frame before the CPU issued it */
+    if (s_clock_bits[instance] < s_cpu_bits) {
+        s_clock_bits[instance] = s_cpu_bits;
+    }
+    mock_bus_run_contender(instance);
+
+    bool no_stop = (flags & NRF_DRV_TWI_FLAG_TX_NO_STOP) != 0U;
+
+    switch (desc->type) {
+    case NRF_DRV_TWI_XFER_TX:
+        return mock_bus_write(instance, desc->address, desc->p_primary_buf,
+                              desc->primary_length, no_stop);
+    case NRF_DRV_TWI_XFER_RX:
+        return mock_bus_read(instance, desc->address, desc->p_primary_buf,
+                             desc->primary_length);
+    case NRF_DRV_TWI_XFER_TXRX: {
+        ret_code_t ret = mock_bus_write(instance, desc->address, desc->p_primary_buf,
+                                        desc->primary_length, true);
+        if (ret != NRF_SUCCESS) {
+            return ret;
+        }
+        return mock_bus_read(instance, desc->address, desc->p_secondary_buf,
+                             desc->secondary_length);
+    }
+    default:
+        return NRF_ERROR_INTERNAL;
+    }
+}
+
+/*
+ * Run a pending transfer and deliver its event. The legacy TWI peripheral
+ * interrupts once per byte plus once for STOPPED; TWIM moves the whole job
+ * by EasyDMA and interrupts once at the end.
+ */
+static void mock_bus_complete(uint8_t instance, nrf_drv_twi_xfer_desc_t const *desc,
+                              uint32_t flags)
+{
+    uint32_t bytes_before = s_stats.bytes;
+    int ok = (mock_bus_run_desc(instance, desc, flags) == NRF_SUCCESS);
+
+    s_irq_bits = s_clock_bits[instance];
+
+    if (s_twim_handler[instance] != NULL) {
+        nrfx_twim_evt_t evt = {
+            .type = ok ? NRFX_TWIM_EVT_DONE : NRFX_TWIM_EVT_ADDRESS_NACK,
+            .xfer_desc = {
+                .type = (nrfx_twim_xfer_type_t)desc->type,
+                .address = desc->address,
+                .primary_length = desc->primary_length,
+                .secondary_length = desc->secondary_length,
+                .p_primary_buf = desc->p_primary_buf,
+                .p_secondary_buf = desc->p_secondary_buf
+            }
+        };
+        s_stats.cpu_irqs++;
+        s_in_irq++;
+        s_twim_handler[instance](&evt, s_handler_context[instance]);
+        s_in_irq--;
+    } else {
+        nrf_drv_twi_evt_t evt = {
+            .type = ok ? NRF_DRV_TWI_EVT_DONE : NRF_DRV_TWI_EVT_ADDRESS_NACK,
+            .xfer_desc = *desc
+        };
+        s_stats.cpu_irqs += (s_stats.bytes - bytes_before) + 1U;
+        s_in_irq++;
+        s_handler[instance](&evt, s_handler_context[instance]);
+        s_in_irq--;
+    }
+}
+
+/* Start an event-driven transfer: complete now, or park it until mock_bus_fire_irq() */
+static int mock_bus_start(uint8_t instance, nrf_drv_twi_xfer_desc_t const *desc, uint32_t flags)
+{
+    if (s_pending[instance]) {
+        return 0;
+    }
+
+    if (s_deferred) {
+        s_pending[instance] = 1;
+        s_pending_desc[instance] = *desc;
+        s_pending_flags[instance] = flags;
+        return 1;
+    }
+
+    mock_bus_complete(instance, desc, flags);
+    return 1;
+}
+
+void mock_bus_reset(void)
+{
+    memset(s_regs, 0, sizeof(s_regs));
+    memset(s_reg_ptr, 0, sizeof(s_reg_ptr));
+    memset(s_frame_open, 0, sizeof(s_frame_open));
+    memset(s_pending, 0, sizeof(s_pending));
+    memset(s_write_bits, 0, sizeof(s_write_bits));
+    memset(s_contender_len, 0, sizeof(s_contender_len));
+    memset(s_contender_armed, 0, sizeof(s_contender_armed));
+    memset(s_clock_bits, 0, sizeof(s_clock_bits));
+    s_cpu_bits = 0;
+    s_irq_bits = 0;
+    s_in_irq = 0;
+    s_deferred = 0;
+    s_fire_on_wait = 0;
+    s_current_task = 0;
+    for (unsigned i = 0; i < MOCK_BUS_INSTANCES; i++) {
+        for (unsigned d = 0; d < MOCK_BUS_DEVICES; d++) {
+            s_regs[i][d][0x00] = 0xCAU;  /* CHIP_REV */
+            s_present[i][d] = 1;
+        }
+    }
+    mock_bus_clear_stats();
+}
+
+void mock_bus_set_present(uint8_t instance, uint8_t address, int present)
+{
+    if ((instance < MOCK_BUS_INSTANCES) &&
+        (address >= MOCK_BUS_FIRST_ADDR) &&
+        (address < (MOCK_BUS_FIRST_ADDR + MOCK_BUS_DEVICES))) {
+        s_present[instance][address - MOCK_BUS_FIRST_ADDR] = present;
+    }
+}
+
+void mock_bus_set_contender(uint8_t instance, int len)
+{
+    if (instance < MOCK_BUS_INSTANCES) {
+        s_contender_len[instance] = len;
+        s_contender_armed[instance] = 0;
+    }
+}
+
+void mock_bus_settle(void)
+{
+    for (unsigned i = 0; i < MOCK_BUS_INSTANCES; i++) {
+        mock_bus_cpu_wake(s_clock_bits[i]);
+    }
+    for (unsigned i = 0; i < MOCK_BUS_INSTANCES; i++) {
+        s_clock_bits[i] = s_cpu_bits;
+    }
+}
+
+double mock_bus_now_us(void)
+{
+    return ((double)s_cpu_bits * MOCK_BUS_NS_PER_BIT) / 1000.0;
+}
+
+/* ========================================================================
+ * nRF TIMER HAL (follows the mock clock)
+ * ======================================================================== */
+
+NRF_TIMER_Type mock_timer4;
+
+void nrf_timer_mode_set(NRF_TIMER_Type *p_reg, nrf_timer_mode_t mode)
+{
+    p_reg->mode = (uint32_t)mode;
+}
+
+void nrf_timer_bit_width_set(NRF_TIMER_Type *p_reg, nrf_timer_bit_width_t bit_width)
+{
+    p_reg->bit_width = (uint32_t)bit_width;
+}
+
+void nrf_timer_frequency_set(NRF_TIMER_Type *p_reg, nrf_timer_frequency_t frequency)
+{
+    p_reg->frequency = (uint32_t)frequency;
+}
+
+void nrf_timer_task_trigger(NRF_TIMER_Type *p_reg, nrf_timer_task_t task)
+{
+    /* An event handler runs when its frame ends, ahead of the task's clock */
+    double now = ((double)(s_in_irq ? s_irq_bits : s_cpu_bits) * MOCK_BUS_NS_PER_BIT) / 1000.0;
+
+    if (task == NRF_TIMER_TASK_START) {
+        p_reg->running = true;
+    } else if (task == NRF_TIMER_TASK_STOP) {
+        p_reg->running = false;
+    } else if (task == NRF_TIMER_TASK_CLEAR) {
+        p_reg->start_us = now;
+    } else if (task >= NRF_TIMER_TASK_CAPTURE0) {
+        uint32_t channel = ((uint32_t)task - NRF_TIMER_TASK_CAPTURE0) / 4U;
+        p_reg->cc[channel] = p_reg->running ? (uint32_t)(now - p_reg->start_us) : 0U;
+    }
+}
+
+uint32_t nrf_timer_cc_read(NRF_TIMER_Type *p_reg, nrf_timer_cc_channel_t cc_channel)
+{
+    return p_reg->cc[cc_channel];
+}
+
+double mock_bus_write_time_us(uint8_t instance, uint8_t address, uint8_t reg)
+{
+    uint8_t *ptr;
+    if (mock_bus_regs(instance, address, &ptr) == NULL) {
+        return 0.0;
+    }
+    return ((double)s_write_bits[instance][address - MOCK_BUS_FIRST_ADDR][reg] *
+            MOCK_BUS_NS_PER_BIT) / 1000.0;
+}
+
+void mock_bus_set_deferred(int deferred)
+{
+    s_deferred = deferred;
+}
+
+void mock_bus_set_fire_on_wait(int fire)
+{
+    s_fire_on_wait = fire;
+}
+
+void mock_bus_set_task(int task)
+{
+    s_current_task = task;
+}
+
+int mock_bus_frame_open(uint8_t instance)
+{
+    return (instance < MOCK_BUS_INSTANCES) ? s_frame_open[instance] : 0;
+}
+
+int mock_bus_fire_irq(uint8_t instance)
+{
+    if ((instance >= MOCK_BUS_INSTANCES) || !s_pending[instance]) {
+        return 0;
+    }
+    s_pending[instance] = 0;
+    mock_bus_complete(instance, &s_pending_desc[instance], s_pending_flags[instance]);
+    return 1;
+}
+
+void mock_bus_clear_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+mock_bus_stats_t mock_bus_stats(void)
+{
+    return s_stats;
+}
+
+double mock_bus_time_us(const mock_bus_stats_t *stats)
+{
+    return ((double)stats->bits * MOCK_BUS_NS_PER_BIT) / 1000.0;
+}
+
+uint8_t mock_bus_reg(uint8_t instance, uint8_t address, uint8_t reg)
+{
+    uint8_t *ptr;
+    uint8_t *regs = mock_bus_regs(instance, address, &ptr);
+    return (regs != NULL) ? regs[reg] : 0U;
+}
+
+void mock_bus_set_reg(uint8_t instance, uint8_t address, uint8_t reg, uint8_t value)
+{
+    uint8_t *ptr;
+    uint8_t *regs = mock_bus_regs(instance, address, &ptr);
+    if (regs != NULL) {
+        regs[reg] = value;
+    }
+}
+
+/* ========================================================================
+ * nrf_drv_twi stand-in
+ * ======================================================================== */
+
+ret_code_t nrf_drv_twi_init(nrf_drv_twi_t const *p_instance,
+                            nrf_drv_twi_config_t const *p_config,
+                            nrf_drv_twi_evt_handler_t event_handler,
+                            void *p_context)
+{
+    (void)p_config;
+    s_handler[p_instance->inst_idx] = event_handler;
+    s_twim_handler[p_instance->inst_idx] = NULL;
+    s_handler_context[p_instance->inst_idx] = p_context;
+    return NRF_SUCCESS;
+}
+
+void nrf_drv_twi_enable(nrf_drv_twi_t const *p_instance)
+{
+    (void)p_instance;
+}
+
+ret_code_t nrf_drv_twi_xfer(nrf_drv_twi_t const *p_instance,
+                            nrf_drv_twi_xfer_desc_t const *p_xfer_desc,
+                            uint32_t flags)
+{
+    uint8_t instance = p_instance->inst_idx;
+
+    if (s_handler[instance] == NULL) {
+        return mock_bus_run_desc(instance, p_xfer_desc, flags);
+    }
+
+    return mock_bus_start(instance, p_xfer_desc, flags) ? NRF_SUCCESS : NRF_ERROR_BUSY;
+}
+
+ret_code_t nrf_drv_twi_tx(nrf_drv_twi_t const *p_instance,
+                          uint8_t address,
+                          uint8_t const *p_data,
+                          uint8_t length,
+                          bool no_stop)
+{
+    return mock_bus_write(p_instance->inst_idx, address, p_data, length, no_stop);
+}
+
+ret_code_t nrf_drv_twi_rx(nrf_drv_twi_t const *p_instance,
+                          uint8_t address,
+                          uint8_t *p_data,
+                          uint8_t length)
+{
+    return mock_bus_read(p_instance->inst_idx, address, p_data, length);
+}
+
+/* ========================================================================
+ * nrfx_twim stand-in
+ * ======================================================================== */
+
+nrfx_err_t nrfx_twim_init(nrfx_twim_t const *p_instance,
+                          nrfx_twim_config_t const *p_config,
+                          nrfx_twim_evt_handler_t event_handler,
+                          void *p_context)
+{
+    (void)p_config;
+    s_twim_handler[p_instance->drv_inst_idx] = event_handler;
+    s_handler[p_instance->drv_inst_idx] = NULL;
+    s_handler_context[p_instance->drv_inst_idx] = p_context;
+    return NRFX_SUCCESS;
+}
+
+void nrfx_twim_enable(nrfx_twim_t const *p_instance)
+{
+    (void)p_instance;
+}
+
+nrfx_err_t nrfx_twim_xfer(nrfx_twim_t const *p_instance,
+                          nrfx_twim_xfer_desc_t const *p_xfer_desc,
+                          uint32_t flags)
+{
+    nrf_drv_twi_xfer_desc_t desc = {
+        .type = (nrf_drv_twi_xfer_type_t)p_xfer_desc->type,
+        .address = p_xfer_desc->address,
+        .primary_length = (uint32_t)p_xfer_desc->primary_length,
+        .secondary_length = (uint32_t)p_xfer_desc->secondary_length,
+        .p_primary_buf = p_xfer_desc->p_primary_buf,
+        .p_secondary_buf = p_xfer_desc->p_secondary_buf
+    };
+
+    return mock_bus_start(p_instance->drv_inst_idx, &desc,
+                          (flags & NRFX_TWIM_FLAG_TX_NO_STOP) ? NRF_DRV_TWI_FLAG_TX_NO_STOP : 0U)
+           ? NRFX_SUCCESS : NRFX_ERROR_BUSY;
+}
+
+/* ========================================================================
+ * FreeRTOS stand-in
+ * ======================================================================== */
+
+static SemaphoreHandle_t mock_semaphore_create(int is_mutex, int count)
+{
+    if (s_semaphore_count >= (sizeof(s_semaphores) / sizeof(s_semaphores[0]))) {
+        return NULL;
+    }
+    s_semaphores[s_semaphore_count].is_mutex = is_mutex;
+    s_semaphores[s_semaphore_count].count = count;
+    return &s_semaphores[s_semaphore_count++];
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    s_heap_allocs++;
+    return mock_semaphore_create(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    s_heap_allocs++;
+    return mock_semaphore_create(0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer)
+{
+    struct mock_semaphore *sem = (struct mock_semaphore *)buffer;
+    sem->is_mutex = 1;
+    sem->count = 1;
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer)
+{
+    struct mock_semaphore *sem = (struct mock_semaphore *)buffer;
+    sem->is_mutex = 0;
+    sem->count = 0;
+    return sem;
+}
+
+uint32_t mock_bus_heap_allocs(void)
+{
+    return s_heap_allocs;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    for (uint8_t i = 0; s_fire_on_wait && (ticks != 0U) && !sem->is_mutex && (sem->count == 0) && (i < MOCK_BUS_INSTANCES); ) {
+        if (!mock_bus_fire_irq(i)) {
+            i++;
+        }
+    }
+    if (sem->count == 0) {
+        return pdFALSE;
+    }
+    sem->count--;
+    if (sem->is_mutex) {
+        s_stats.lock_takes++;
+        mock_bus_arm_contenders();
+    } else {
+        mock_bus_cpu_wake(sem->given_bits);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (sem->count != 0) {
+        return pdFALSE;
+    }
+    sem->count = 1;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken)
+{
+    if (woken != NULL) {
+        *woken = pdTRUE;
+    }
+    sem->given_bits = s_irq_bits;
+    return xSemaphoreGive(sem);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    (void)ticks;
+}
+
+static uint32_t s_scheduler_suspended;
+
+void vTaskSuspendAll(void)
+{
+    if (s_scheduler_suspended++ == 0U) {
+        s_stats.lock_takes++;
+        mock_bus_arm_contenders();
+    }
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    s_scheduler_suspended--;
+    return pdFALSE;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)((s_cpu_bits * MOCK_BUS_NS_PER_BIT) / 1000000U);
+}
+
+uint32_t __get_IPSR(void)
+{
+    return (s_in_irq != 0U) ? MOCK_BUS_TWI_IRQN : 0U;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return (s_current_task != 0) ? &s_other_task : &s_task;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken)
+{
+    task->notifications++;
+    task->notified_bits = s_irq_bits;
+    if (woken != NULL) {
+        *woken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    (void)ticks;
+    uint32_t value = s_task.notifications;
+    if (value > 0U) {
+        mock_bus_cpu_wake(s_task.notified_bits);
+    }
+    if (clear_on_exit) {
+        s_task.notifications = 0;
+    } else if (value > 0U) {
+        s_task.notifications--;
+    }
+    return value;
+}
+
+static TaskHandle_t mock_task_create(void)
+{
+    if (s_created_task_count >= (sizeof(s_created_tasks) / sizeof(s_created_tasks[0]))) {
+        return NULL;
+    }
+    return &s_created_tasks[s_created_task_count++];
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint16_t stack_words,
+                       void *param, UBaseType_t priority, TaskHandle_t *created)
+{
+    (void)code;
+    (void)name;
+    (void)stack_words;
+    (void)param;
+    (void)priority;
+    s_heap_allocs++;
+    *created = mock_task_create();
+    return (*created != NULL) ? pdPASS : pdFALSE;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t code, const char *name, uint32_t stack_words,
+                               void *param, UBaseType_t priority, StackType_t *stack,
+                               StaticTask_t *buffer)
+{
+    (void)code;
+    (void)name;
+    (void)stack_words;
+    (void)param;
+    (void)priority;
+    (void)stack;
+    (void)buffer;
+    return mock_task_create();
+}
+
+/* ========================================================================
+ * nrf_drv_gpiote stand-in
+ * ======================================================================== */
+
+ret_code_t nrf_drv_gpiote_init(void)
+{
+    s_gpiote_init = 1;
+    return NRF_SUCCESS;
+}
+
+bool nrf_drv_gpiote_is_init(void)
+{
+    return s_gpiote_init != 0;
+}
+
+ret_code_t nrf_drv_gpiote_in_init(nrf_drv_gpiote_pin_t pin,
+                                  nrf_drv_gpiote_in_config_t const *p_config,
+                                  nrf_drv_gpiote_evt_handler_t evt_handler)
+{
+    (void)pin;
+    (void)p_config;
+    (void)evt_handler;
+    return NRF_SUCCESS;
+}
+
+void nrf_drv_gpiote_in_uninit(nrf_drv_gpiote_pin_t pin)
+{
+    (void)pin;
+}
+
+void nrf_drv_gpiote_in_event_enable(nrf_drv_gpiote_pin_t pin, bool int_enable)
+{
+    (void)pin;
+    (void)int_enable;
+}
+
+void nrf_drv_gpiote_in_event_disable(nrf_drv_gpiote_pin_t pin)
+{
+    (void)pin;
+}
+
+bool nrf_drv_gpiote_in_is_set(nrf_drv_gpiote_pin_t pin)
+{
+    (void)pin;
+    return true;    /* Pulled up, nothing asserts */
+}
@@ -0,0 +1,104 @@
+/**
+ * @file mock_bus.h
+ * @brief Recording I2C bus used by the host tests
+ *
+ * Backs the stand-in nrf_drv_twi and semphr APIs with four simulated
+ * DA7281 register files per TWI instance (addresses 0x48..0x4B) and
+ * counts what every driver call puts on the bus.
+ */
+
+#ifndef MOCK_BUS_H
+#define MOCK_BUS_H
+
+#include <stdint.h>
+
+/** Bus time per bit at 400 kHz, in nanoseconds */
+#define MOCK_BUS_NS_PER_BIT     (2500U)
+
+/**
+ * @brief Bus traffic counters
+ */
+typedef struct {
+    uint32_t transactions;      /**< STOP-terminated frames */
+    uint32_t address_phases;    /**< START and repeated START conditions */
+    uint32_t bytes;             /**< Bytes after the address byte (reg + data) */
+    uint32_t bits;              /**< SCL clocks incl. START/STOP and ACK bits */
+    uint32_t lock_takes;        /**< Mutex takes and scheduler suspends */
+    uint32_t cpu_irqs;          /**< Driver interrupts: per byte on TWI, per DMA job on TWIM */
+} mock_bus_stats_t;
+
+/** Reset register files and counters (CHIP_REV reads 0xCA) */
+void mock_bus_reset(void);
+
+/** Clear counters only */
+void mock_bus_clear_stats(void);
+
+/** Snapshot of the counters since the last reset */
+mock_bus_stats_t mock_bus_stats(void);
+
+/** Estimated bus time of the given counters in microseconds */
+double mock_bus_time_us(const mock_bus_stats_t *stats);
+
+/** Kernel objects created from the FreeRTOS heap since start-up */
+uint32_t mock_bus_heap_allocs(void);
+
+/** Read a simulated register without touching the counters */
+uint8_t mock_bus_reg(uint8_t instance, uint8_t address, uint8_t reg);
+
+/** Preload a simulated register without touching the counters */
+void mock_bus_set_reg(uint8_t instance, uint8_t address, uint8_t reg, uint8_t value);
+
+/** Make a simulated device ACK (1) or NACK (0) its address */
+void mock_bus_set_present(uint8_t instance, uint8_t address, int present);
+
+/**
+ * @brief Simulate another task that uses the bus whenever it can
+ *
+ * After every lock acquisition (mutex take or scheduler suspend) the next
+ * transfer on this instance is preceded by a foreign write frame of len
+ * bytes. It only advances the virtual clock, not the counters. 0 disables.
+ */
+void mock_bus_set_contender(uint8_t instance, int len);
+
+/** Let both buses go idle and align their clocks with the CPU (common time origin) */
+void mock_bus_settle(void);
+
+/** Virtual CPU time since the last reset in microseconds */
+double mock_bus_now_us(void);
+
+/** Virtual bus time at which a register was last written, in microseconds */
+double mock_bus_write_time_us(uint8_t instance, uint8_t address, uint8_t reg);
+
+/**
+ * @brief Hold event-driven transfers until mock_bus_fire_irq()
+ *
+ * By default a transfer started with an event handler completes inside
+ * nrf_drv_twi_xfer(). When deferred, it stays pending so tests can queue
+ * more work while the bus is busy.
+ */
+void mock_bus_set_deferred(int deferred);
+
+/** Complete the pending transfer on an instance; returns 0 if none */
+int mock_bus_fire_irq(uint8_t instance);
+
+/**
+ * @brief Let deferred transfers complete while a task sleeps
+ *
+ * While set, a task blocking on a completion semaphore fires pending
+ * interrupts until it is signalled or the bus is idle, so a completion
+ * can arrive during a later call's wait.
+ */
+void mock_bus_set_fire_on_wait(int fire);
+
+/**
+ * @brief Run the following calls as another task (0 = the test task)
+ *
+ * Changes what xTaskGetCurrentTaskHandle() returns; task notifications
+ * still go to the test task.
+ */
+void mock_bus_set_task(int task);
+
+/** 1 while a frame has been started and not ended with a STOP */
+int mock_bus_frame_open(uint8_t instance);
+
+#endif /* MOCK_BUS_H */
@@ -0,0 +1,14 @@
+/**
+ * @file nrf_delay.h
+ * @brief Host stand-in for the nRF delay library
+ */
+
+#ifndef NRF_DELAY_H
+#define NRF_DELAY_H
+
+#include <stdint.h>
+
+static inline void nrf_delay_us(uint32_t us) { (void)us; }
+static inline void nrf_delay_ms(uint32_t ms) { (void)ms; }
+
+#endif /* NRF_DELAY_H */
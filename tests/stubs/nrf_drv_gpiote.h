@@ -0,0 +1,50 @@
+/**
+ * @file nrf_drv_gpiote.h
+ * @brief Host stand-in for the nRF5 SDK legacy GPIOTE driver
+ *
+ * Only the input subset used by src/da7281_bus_nrf.c (nIRQ) is declared.
+ * mock_bus.c records the armed pins; every input reads high and no edge
+ * is ever reported.
+ */
+
+#ifndef NRF_DRV_GPIOTE_H
+#define NRF_DRV_GPIOTE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_gpio.h"
+#include "sdk_errors.h"
+
+typedef uint32_t nrf_drv_gpiote_pin_t;
+
+typedef enum {
+    NRF_GPIOTE_POLARITY_LOTOHI = 1,
+    NRF_GPIOTE_POLARITY_HITOLO = 2,
+    NRF_GPIOTE_POLARITY_TOGGLE = 3
+} nrf_gpiote_polarity_t;
+
+typedef struct {
+    nrf_gpiote_polarity_t sense;
+    nrf_gpio_pin_pull_t pull;
+    bool is_watcher;
+    bool hi_accuracy;
+    bool skip_gpio_setup;
+} nrf_drv_gpiote_in_config_t;
+
+#define GPIOTE_CONFIG_IN_SENSE_HITOLO(hi_accu) \
+    { .sense = NRF_GPIOTE_POLARITY_HITOLO, .pull = NRF_GPIO_PIN_NOPULL, \
+      .is_watcher = false, .hi_accuracy = (hi_accu), .skip_gpio_setup = false }
+
+typedef void (*nrf_drv_gpiote_evt_handler_t)(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
+
+ret_code_t nrf_drv_gpiote_init(void);
+bool nrf_drv_gpiote_is_init(void);
+ret_code_t nrf_drv_gpiote_in_init(nrf_drv_gpiote_pin_t pin,
+                                  nrf_drv_gpiote_in_config_t const *p_config,
+                                  nrf_drv_gpiote_evt_handler_t evt_handler);
+void nrf_drv_gpiote_in_uninit(nrf_drv_gpiote_pin_t pin);
+void nrf_drv_gpiote_in_event_enable(nrf_drv_gpiote_pin_t pin, bool int_enable);
+void nrf_drv_gpiote_in_event_disable(nrf_drv_gpiote_pin_t pin);
+bool nrf_drv_gpiote_in_is_set(nrf_drv_gpiote_pin_t pin);
+
+#endif /* NRF_DRV_GPIOTE_H */
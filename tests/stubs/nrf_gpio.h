@@ -0,0 +1,23 @@
+/**
+ * @file nrf_gpio.h
+ * @brief Host stand-in for the nRF GPIO HAL (types only)
+ */
+
+#ifndef NRF_GPIO_H
+#define NRF_GPIO_H
+
+#include <stdint.h>
+
+typedef enum {
+    NRF_GPIO_PIN_NOPULL   = 0,
+    NRF_GPIO_PIN_PULLDOWN = 1,
+    NRF_GPIO_PIN_PULLUP   = 3
+} nrf_gpio_pin_pull_t;
+
+typedef enum {
+    NRF_GPIO_PIN_NOSENSE    = 0,
+    NRF_GPIO_PIN_SENSE_HIGH = 2,
+    NRF_GPIO_PIN_SENSE_LOW  = 3
+} nrf_gpio_pin_sense_t;
+
+#endif /* NRF_GPIO_H */
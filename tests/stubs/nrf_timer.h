@@ -0,0 +1,62 @@
+/**
+ * @file nrf_timer.h
+ * @brief Host stand-in for the nRF TIMER HAL
+ *
+ * The counter follows the mock bus clock: the CPU's in tasks, the end of
+ * the frame in TWI event handlers. Like the peripheral it keeps running
+ * while the scheduler is suspended.
+ */
+
+#ifndef NRF_TIMER_H
+#define NRF_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    bool running;               /**< START triggered, not stopped */
+    uint32_t mode;
+    uint32_t bit_width;
+    uint32_t frequency;
+    double start_us;            /**< Mock clock at START/CLEAR */
+    uint32_t cc[6];
+} NRF_TIMER_Type;
+
+typedef enum {
+    NRF_TIMER_MODE_TIMER = 0
+} nrf_timer_mode_t;
+
+typedef enum {
+    NRF_TIMER_BIT_WIDTH_32 = 3
+} nrf_timer_bit_width_t;
+
+typedef enum {
+    NRF_TIMER_FREQ_1MHz = 4
+} nrf_timer_frequency_t;
+
+typedef enum {
+    NRF_TIMER_CC_CHANNEL0 = 0
+} nrf_timer_cc_channel_t;
+
+typedef enum {
+    NRF_TIMER_TASK_START    = 0x000,
+    NRF_TIMER_TASK_STOP     = 0x004,
+    NRF_TIMER_TASK_CLEAR    = 0x00C,
+    NRF_TIMER_TASK_CAPTURE0 = 0x040
+} nrf_timer_task_t;
+
+extern NRF_TIMER_Type mock_timer4;
+#define NRF_TIMER4                  (&mock_timer4)
+
+void nrf_timer_mode_set(NRF_TIMER_Type *p_reg, nrf_timer_mode_t mode);
+void nrf_timer_bit_width_set(NRF_TIMER_Type *p_reg, nrf_timer_bit_width_t bit_width);
+void nrf_timer_frequency_set(NRF_TIMER_Type *p_reg, nrf_timer_frequency_t frequency);
+void nrf_timer_task_trigger(NRF_TIMER_Type *p_reg, nrf_timer_task_t task);
+uint32_t nrf_timer_cc_read(NRF_TIMER_Type *p_reg, nrf_timer_cc_channel_t cc_channel);
+
+static inline nrf_timer_task_t nrf_timer_capture_task_get(uint32_t channel)
+{
+    return (nrf_timer_task_t)(NRF_TIMER_TASK_CAPTURE0 + (channel * 4U));
+}
+
+#endif /* NRF_TIMER_H */
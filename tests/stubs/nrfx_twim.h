@@ -0,0 +1,101 @@
+/**
+ * @file nrfx_twim.h
+ * @brief Host stand-in for the nrfx TWIM (EasyDMA) driver
+ *
+ * Only the subset used by the DA7281_I2C_BACKEND_TWIM path of
+ * src/da7281_i2c.c is declared. Transfers are routed to the recording
+ * bus in mock_bus.c, which charges one CPU interrupt per DMA job.
+ */
+
+#ifndef NRFX_TWIM_H
+#define NRFX_TWIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "app_util_platform.h"
+
+typedef uint32_t nrfx_err_t;
+
+#define NRFX_TWIM0_ENABLED          1
+#define NRFX_TWIM1_ENABLED          1
+
+#define NRFX_SUCCESS                (0x0BAD0000U)
+#define NRFX_ERROR_BUSY             (0x0BAD000BU)
+#define NRFX_ERROR_INVALID_ADDR     (0x0BAD0010U)
+#define NRFX_ERROR_DRV_TWI_ERR_ANACK (0x0BAE0001U)
+
+typedef struct {
+    void *p_twim;
+    uint8_t drv_inst_idx;
+} nrfx_twim_t;
+
+#define NRFX_TWIM_INSTANCE(id)      { .p_twim = NULL, .drv_inst_idx = (id) }
+
+typedef enum {
+    NRF_TWIM_FREQ_100K,
+    NRF_TWIM_FREQ_250K,
+    NRF_TWIM_FREQ_400K
+} nrf_twim_frequency_t;
+
+typedef struct {
+    uint32_t scl;
+    uint32_t sda;
+    nrf_twim_frequency_t frequency;
+    uint8_t interrupt_priority;
+    bool hold_bus_uninit;
+} nrfx_twim_config_t;
+
+typedef enum {
+    NRFX_TWIM_EVT_DONE,
+    NRFX_TWIM_EVT_ADDRESS_NACK,
+    NRFX_TWIM_EVT_DATA_NACK,
+    NRFX_TWIM_EVT_OVERRUN,
+    NRFX_TWIM_EVT_BUS_ERROR
+} nrfx_twim_evt_type_t;
+
+typedef enum {
+    NRFX_TWIM_XFER_TX,
+    NRFX_TWIM_XFER_RX,
+    NRFX_TWIM_XFER_TXRX,
+    NRFX_TWIM_XFER_TXTX
+} nrfx_twim_xfer_type_t;
+
+typedef struct {
+    nrfx_twim_xfer_type_t type;
+    uint8_t address;
+    size_t primary_length;
+    size_t secondary_length;
+    uint8_t *p_primary_buf;
+    uint8_t *p_secondary_buf;
+} nrfx_twim_xfer_desc_t;
+
+#define NRFX_TWIM_XFER_DESC_TX(addr, p_data, length) \
+    { .type = NRFX_TWIM_XFER_TX, .address = (addr), .primary_length = (length), \
+      .secondary_length = 0, .p_primary_buf = (p_data), .p_secondary_buf = NULL }
+
+#define NRFX_TWIM_XFER_DESC_TXRX(addr, p_tx, tx_len, p_rx, rx_len) \
+    { .type = NRFX_TWIM_XFER_TXRX, .address = (addr), .primary_length = (tx_len), \
+      .secondary_length = (rx_len), .p_primary_buf = (p_tx), .p_secondary_buf = (p_rx) }
+
+#define NRFX_TWIM_FLAG_TX_NO_STOP   (1UL << 5)
+
+typedef struct {
+    nrfx_twim_evt_type_t type;
+    nrfx_twim_xfer_desc_t xfer_desc;
+} nrfx_twim_evt_t;
+
+typedef void (*nrfx_twim_evt_handler_t)(nrfx_twim_evt_t const *p_event, void *p_context);
+
+nrfx_err_t nrfx_twim_init(nrfx_twim_t const *p_instance,
+                          nrfx_twim_config_t const *p_config,
+                          nrfx_twim_evt_handler_t event_handler,
+                          void *p_context);
+
+void nrfx_twim_enable(nrfx_twim_t const *p_instance);
+
+nrfx_err_t nrfx_twim_xfer(nrfx_twim_t const *p_instance,
+                          nrfx_twim_xfer_desc_t const *p_xfer_desc,
+                          uint32_t flags);
+
+#endif /* NRFX_TWIM_H */
@@ -0,0 +1,19 @@
+/**
+ * @file sdk_errors.h
+ * @brief Host stand-in for the nRF5 SDK error codes
+ */
+
+#ifndef SDK_ERRORS_H
+#define SDK_ERRORS_H
+
+#include <stdint.h>
+
+typedef uint32_t ret_code_t;
+
+#define NRF_SUCCESS                 (0U)
+#define NRF_ERROR_INTERNAL          (3U)
+#define NRF_ERROR_INVALID_STATE     (8U)
+#define NRF_ERROR_NO_MEM            (4U)
+#define NRF_ERROR_BUSY              (17U)
+
+#endif /* SDK_ERRORS_H */
@@ -0,0 +1,25 @@
+/**
+ * @file semphr.h
+ * @brief Host stand-in for the FreeRTOS semaphore API
+ *
+ * Nothing blocks on the host: a take on an unavailable semaphore fails
+ * immediately. Mutex takes are counted by mock_bus.c so tests can assert
+ * how many lock acquisitions an API call costs.
+ */
+
+#ifndef SEMPHR_H
+#define SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef struct mock_semaphore *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer);
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken);
+
+#endif /* SEMPHR_H */
@@ -0,0 +1,34 @@
+/**
+ * @file task.h
+ * @brief Host stand-in for the FreeRTOS task API
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "FreeRTOS.h"
+
+typedef struct mock_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+/** Storage for a statically allocated task */
+typedef struct {
+    void *opaque[4];
+} StaticTask_t;
+
+/** Tasks are recorded, never run */
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint16_t stack_words,
+                       void *param, UBaseType_t priority, TaskHandle_t *created);
+TaskHandle_t xTaskCreateStatic(TaskFunction_t code, const char *name, uint32_t stack_words,
+                               void *param, UBaseType_t priority, StackType_t *stack,
+                               StaticTask_t *buffer);
+
+void vTaskDelay(TickType_t ticks);
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TickType_t xTaskGetTickCount(void);
+
+#endif /* TASK_H */
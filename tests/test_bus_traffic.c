@@ -0,0 +1,1159 @@
+/**
+ * @file test_bus_traffic.c
+ * @brief Bus traffic tests for the DA7281 driver on a recording host bus
+ *
+ * Links the real src/da7281.c and src/da7281_i2c.c against the stand-in
+ * SDK headers in tests/stubs/ and counts the I2C frames and bytes each
+ * API call puts on the bus.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include "da7281.h"
+#include "mock_bus.h"
+#include "task.h"
+
+#define TEST_ACTUATORS  (4U)
+
+/* Expected lock acquisitions for n locked sections (none in single-owner mode) */
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_NONE)
+#define TEST_LOCKS(n)   (0U)
+#else
+#define TEST_LOCKS(n)   (n)
+#endif
+
+static da7281_device_t s_devices[TEST_ACTUATORS];
+
+static const da7281_lra_config_t s_lra_config = {
+    .resonant_freq_hz = 170,
+    .impedance_ohm = 6.75F,
+    .nom_max_v_rms = 2.5F,
+    .abs_max_v_peak = 3.5F,
+    .max_current_ma = 350
+};
+
+static void print_stats(const char *label, const mock_bus_stats_t *stats)
+{
+    printf("  %-28s frames=%-3u starts=%-3u bytes=%-4u locks=%-3u bus=%.1f us\n",
+           label, stats->transactions, stats->address_phases, stats->bytes,
+           stats->lock_takes, mock_bus_time_us(stats));
+}
+
+/* Two actuators per TWI bus, 0x48/0x49 on each */
+static void setup_devices(void)
+{
+    mock_bus_reset();
+    (void)da7281_i2c_configure_pins(0, 4, 5);
+    (void)da7281_i2c_configure_pins(1, 6, 7);
+
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        memset(&s_devices[i], 0, sizeof(s_devices[i]));
+        s_devices[i].twi_instance = i / 2U;
+        s_devices[i].i2c_address = (uint8_t)(DA7281_I2C_ADDR_0x48 + (i % 2U));
+        assert(da7281_init(&s_devices[i]) == DA7281_OK);
+    }
+}
+
+/* Test 1: buses are brought up once by da7281_bus_init(), not per transfer */
+static void test_bus_init(void)
+{
+    printf("\n=== Test 1: Explicit bus initialization ===\n");
+    mock_bus_reset();
+
+    da7281_device_t device = {
+        .twi_instance = 1,
+        .i2c_address = DA7281_I2C_ADDR_0x48
+    };
+    uint8_t value;
+
+    /* Register access no longer initializes the bus behind the caller's back */
+    assert(da7281_read_register(&device, DA7281_REG_CHIP_REV, &value) == DA7281_ERROR_NOT_INITIALIZED);
+    assert(da7281_write_register_async(&device, DA7281_REG_TOP_CTL2, 0U, NULL, NULL) ==
+           DA7281_ERROR_NOT_INITIALIZED);
+    assert(da7281_bus_init(2) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_bus_init(1) == DA7281_ERROR_INVALID_PARAM);  /* Pins not configured */
+
+    assert(da7281_i2c_configure_pins(1, 6, 7) == DA7281_OK);
+    assert(da7281_bus_init(1) == DA7281_OK);
+    assert(da7281_bus_init(1) == DA7281_OK);                    /* Idempotent */
+
+    /* Fast path: one lock, one frame */
+    mock_bus_clear_stats();
+    assert(da7281_read_register(&device, DA7281_REG_CHIP_REV, &value) == DA7281_OK);
+    assert(value == 0xCAU);
+    assert(mock_bus_stats().lock_takes == TEST_LOCKS(1U));
+    assert(mock_bus_stats().transactions == 1U);
+
+#if DA7281_STATIC_ALLOCATION || (DA7281_BUS_LOCK == DA7281_BUS_LOCK_CRITICAL)
+    assert(mock_bus_heap_allocs() == 0U);
+#elif (DA7281_BUS_LOCK == DA7281_BUS_LOCK_MUTEX)
+    assert(mock_bus_heap_allocs() == 2U);   /* Mutex + completion semaphore */
+#else
+    assert(mock_bus_heap_allocs() == 1U);   /* Completion semaphore only */
+#endif
+    printf("  bus lock mode %u, kernel objects from heap: %u\n",
+           (unsigned)DA7281_BUS_LOCK, mock_bus_heap_allocs());
+
+    printf("✅ PASS: Bus set up once; register access is lock/transfer/unlock\n");
+}
+
+/* Test 2: configure_lra is a single auto-increment frame */
+static void test_configure_lra_single_burst(void)
+{
+    printf("\n=== Test 2: LRA configuration burst ===\n");
+    setup_devices();
+
+    /* Reference: the former one-frame-per-register sequence (0x0A..0x10) */
+    mock_bus_clear_stats();
+    for (uint8_t reg = DA7281_REG_LRA_PER_H; reg <= DA7281_REG_V2I_FACTOR_L; reg++) {
+        assert(da7281_write_register(&s_devices[0], reg, 0x00) == DA7281_OK);
+    }
+    mock_bus_stats_t before = mock_bus_stats();
+    print_stats("7x write_register:", &before);
+
+    mock_bus_clear_stats();
+    assert(da7281_configure_lra(&s_devices[0], &s_lra_config) == DA7281_OK);
+    mock_bus_stats_t after = mock_bus_stats();
+    print_stats("configure_lra (burst):", &after);
+
+    assert(before.transactions == 7U);
+    assert(before.bytes == 14U);
+    assert(after.transactions == 1U);
+    assert(after.bytes == 8U);
+    assert(after.lock_takes == TEST_LOCKS(1U));
+
+    /* Registers land at consecutive addresses */
+    const uint8_t addr = s_devices[0].i2c_address;
+    uint16_t lra_per = (uint16_t)((mock_bus_reg(0, addr, DA7281_REG_LRA_PER_H) << 8) |
+                                  mock_bus_reg(0, addr, DA7281_REG_LRA_PER_L));
+    uint16_t v2i = (uint16_t)((mock_bus_reg(0, addr, DA7281_REG_V2I_FACTOR_H) << 8) |
+                              mock_bus_reg(0, addr, DA7281_REG_V2I_FACTOR_L));
+    printf("  LRA_PER=0x%04X NOMMAX=0x%02X ABSMAX=0x%02X IMAX=0x%02X V2I=0x%04X\n",
+           lra_per,
+           mock_bus_reg(0, addr, DA7281_REG_ACTUATOR_NOMMAX),
+           mock_bus_reg(0, addr, DA7281_REG_ACTUATOR_ABSMAX),
+           mock_bus_reg(0, addr, DA7281_REG_ACTUATOR_IMAX),
+           v2i);
+    assert(lra_per == 4412U);   /* 1 / (170 Hz * 1.33332 us) = 4411.8 */
+    assert(mock_bus_reg(0, addr, DA7281_REG_ACTUATOR_IMAX) == 45U);
+    assert(v2i != 0U);
+
+    printf("✅ PASS: configure_lra uses 1 frame instead of 7 (%.1f us -> %.1f us)\n",
+           mock_bus_time_us(&before), mock_bus_time_us(&after));
+}
+
+/* Test 3: reconfiguring every actuator on the board */
+static void test_configure_lra_board(void)
+{
+    printf("\n=== Test 3: Reconfigure %u actuators ===\n", TEST_ACTUATORS);
+    setup_devices();
+
+    mock_bus_clear_stats();
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        assert(da7281_configure_lra(&s_devices[i], &s_lra_config) == DA7281_OK);
+    }
+    mock_bus_stats_t stats = mock_bus_stats();
+    print_stats("4x configure_lra:", &stats);
+
+    assert(stats.transactions == TEST_ACTUATORS);
+    assert(stats.bytes == (8U * TEST_ACTUATORS));
+
+    printf("✅ PASS: Board reconfiguration costs %u frames\n", stats.transactions);
+}
+
+/* Test 4: burst parameter validation */
+static void test_write_burst_params(void)
+{
+    printf("\n=== Test 4: Burst parameter validation ===\n");
+    setup_devices();
+
+    uint8_t buf[DA7281_I2C_MAX_BURST_LEN + 1U] = {0};
+
+    assert(da7281_write_burst(NULL, 0x0A, buf, 1) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_write_burst(&s_devices[0], 0x0A, NULL, 1) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_write_burst(&s_devices[0], 0x0A, buf, 0) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_write_burst(&s_devices[0], 0x0A, buf,
+                              (uint8_t)(DA7281_I2C_MAX_BURST_LEN + 1U)) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_write_burst(&s_devices[0], 0xFF, buf, 2) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_write_burst(&s_devices[0], DA7281_REG_SNP_MEM_BASE, buf,
+                              DA7281_REG_SNP_MEM_END - DA7281_REG_SNP_MEM_BASE + 1U) == DA7281_OK);
+
+    printf("✅ PASS: Invalid bursts rejected, full SNP window accepted\n");
+}
+
+/* Test 5: status block is one burst read */
+static void test_status_block(void)
+{
+    printf("\n=== Test 5: IRQ/status block read ===\n");
+    setup_devices();
+
+    const uint8_t addr = s_devices[1].i2c_address;
+    mock_bus_set_reg(0, addr, DA7281_REG_IRQ_EVENT1, DA7281_IRQ_EVENT1_E_SEQ_DONE);
+    mock_bus_set_reg(0, addr, DA7281_REG_IRQ_EVENT_WARNING_DIAG, 0x11);
+    mock_bus_set_reg(0, addr, DA7281_REG_IRQ_EVENT_SEQ_DIAG, 0x22);
+    mock_bus_set_reg(0, addr, DA7281_REG_IRQ_STATUS1, 0x33);
+
+    /* Reference: one read per register */
+    mock_bus_clear_stats();
+    for (uint8_t reg = DA7281_REG_IRQ_EVENT1; reg <= DA7281_REG_IRQ_STATUS1; reg++) {
+        uint8_t value;
+        assert(da7281_read_register(&s_devices[1], reg, &value) == DA7281_OK);
+    }
+    mock_bus_stats_t before = mock_bus_stats();
+    print_stats("4x read_register:", &before);
+
+    da7281_status_block_t status;
+    mock_bus_clear_stats();
+    assert(da7281_read_status_block(&s_devices[1], &status) == DA7281_OK);
+    mock_bus_stats_t after = mock_bus_stats();
+    print_stats("read_status_block:", &after);
+
+    assert(status.irq_event1 == DA7281_IRQ_EVENT1_E_SEQ_DONE);
+    assert(status.irq_event_warning_diag == 0x11);
+    assert(status.irq_event_seq_diag == 0x22);
+    assert(status.irq_status1 == 0x33);
+    assert(before.transactions == 4U);
+    assert(before.address_phases == 8U);
+    assert(before.lock_takes == TEST_LOCKS(4U));
+    assert(after.transactions == 1U);
+    assert(after.address_phases == 2U);
+    assert(after.bytes == 5U);
+    assert(after.lock_takes == TEST_LOCKS(1U));
+
+    uint8_t buf[2];
+    assert(da7281_read_burst(&s_devices[1], 0xFF, buf, 2) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_read_burst(&s_devices[1], 0x03, buf, 0) == DA7281_ERROR_INVALID_PARAM);
+
+    printf("✅ PASS: Fault check costs 1 transaction instead of 4 (%.1f us -> %.1f us)\n",
+           mock_bus_time_us(&before), mock_bus_time_us(&after));
+}
+
+/* Test 6: shadow cache removes RMW reads and getter traffic */
+static void test_register_cache(void)
+{
+    printf("\n=== Test 6: Shadow register cache ===\n");
+    setup_devices();
+
+    /* Reference: no cache attached */
+    mock_bus_clear_stats();
+    assert(da7281_set_amplifier_enable(&s_devices[0], true) == DA7281_OK);
+    mock_bus_stats_t uncached_amp = mock_bus_stats();
+    mock_bus_clear_stats();
+    da7281_operation_mode_t mode;
+    assert(da7281_get_operation_mode(&s_devices[0], &mode) == DA7281_OK);
+    mock_bus_stats_t uncached_get = mock_bus_stats();
+    print_stats("amp_enable (no cache):", &uncached_amp);
+    print_stats("get_mode (no cache):", &uncached_get);
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    s_devices[1].cache = &cache;
+    (void)da7281_cache_invalidate(&s_devices[1]);
+
+    /* First access misses and fills, later ones hit */
+    assert(da7281_set_amplifier_enable(&s_devices[1], true) == DA7281_OK);
+    assert(cache.misses == 1U);
+
+    mock_bus_clear_stats();
+    assert(da7281_set_amplifier_enable(&s_devices[1], false) == DA7281_OK);
+    mock_bus_stats_t cached_amp = mock_bus_stats();
+    print_stats("amp_enable (cached):", &cached_amp);
+    assert(cached_amp.transactions == 1U);
+    assert(cached_amp.address_phases == 1U);
+    assert(cache.hits == 1U);
+
+    assert(da7281_set_operation_mode(&s_devices[1], DA7281_MODE_DRO) == DA7281_OK);
+    mock_bus_clear_stats();
+    assert(da7281_get_operation_mode(&s_devices[1], &mode) == DA7281_OK);
+    mock_bus_stats_t cached_get = mock_bus_stats();
+    print_stats("get_mode (cached):", &cached_get);
+    assert(mode == DA7281_MODE_DRO);
+    assert(cached_get.transactions == 0U);
+
+    /* Shadow tracks the chip */
+    const uint8_t addr = s_devices[1].i2c_address;
+    assert(cache.value[DA7281_REG_TOP_CFG1] == mock_bus_reg(0, addr, DA7281_REG_TOP_CFG1));
+    assert((cache.value[DA7281_REG_TOP_CFG1] & DA7281_TOP_CFG1_AMP_EN) == 0U);
+
+    /* Volatile registers are never served from the shadow */
+    uint8_t value;
+    mock_bus_clear_stats();
+    assert(da7281_read_register_cached(&s_devices[1], DA7281_REG_IRQ_STATUS1, &value) == DA7281_OK);
+    assert(mock_bus_stats().transactions == 1U);
+
+    /* A fault reported in the status block drops every shadow copy */
+    da7281_status_block_t status;
+    mock_bus_set_reg(0, addr, DA7281_REG_IRQ_EVENT1, DA7281_IRQ_EVENT1_E_UVLO);
+    assert(da7281_read_status_block(&s_devices[1], &status) == DA7281_OK);
+    mock_bus_clear_stats();
+    assert(da7281_get_operation_mode(&s_devices[1], &mode) == DA7281_OK);
+    assert(mock_bus_stats().transactions == 1U);
+
+    printf("  cache: hits=%u misses=%u\n", cache.hits, cache.misses);
+    s_devices[1].cache = NULL;
+
+    printf("✅ PASS: RMW %u -> %u transactions, cached getter %u -> %u\n",
+           uncached_amp.transactions, cached_amp.transactions,
+           uncached_get.transactions, cached_get.transactions);
+}
+
+/* Completion log for the async tests */
+static struct {
+    unsigned calls;
+    da7281_error_t results[16];
+    uintptr_t order[16];
+} s_async;
+
+static void async_record(da7281_device_t *device, da7281_error_t result, void *context)
+{
+    (void)device;
+    s_async.results[s_async.calls] = result;
+    s_async.order[s_async.calls] = (uintptr_t)context;
+    s_async.calls++;
+}
+
+/* Test 7: async calls return before the transfer and complete from the TWI event */
+static void test_async_queue(void)
+{
+    printf("\n=== Test 7: Asynchronous transfer queue ===\n");
+    setup_devices();
+    memset(&s_async, 0, sizeof(s_async));
+
+    const uint8_t addr = s_devices[0].i2c_address;
+    const uint8_t lra[3] = {0x11, 0x3C, 0x6A};
+    uint8_t readback[3] = {0};
+    uint8_t chip_rev = 0;
+
+    /* Hold the bus: nothing completes until the interrupt fires */
+    mock_bus_set_deferred(1);
+    mock_bus_clear_stats();
+    assert(da7281_write_burst_async(&s_devices[0], DA7281_REG_LRA_PER_H, lra, 3U,
+                                    async_record, (void *)1) == DA7281_OK);
+    assert(da7281_write_register_async(&s_devices[0], DA7281_REG_TOP_CTL2, 0x80U,
+                                       async_record, (void *)2) == DA7281_OK);
+    assert(da7281_read_burst_async(&s_devices[0], DA7281_REG_LRA_PER_H, readback, 3U,
+                                   async_record, (void *)3) == DA7281_OK);
+    assert(da7281_read_register_async(&s_devices[0], DA7281_REG_CHIP_REV, &chip_rev,
+                                      async_record, (void *)4) == DA7281_OK);
+
+    /* Calls returned with only the first frame handed to the peripheral */
+    assert(s_async.calls == 0U);
+    assert(mock_bus_stats().transactions == 0U);
+    assert(mock_bus_stats().lock_takes == 0U);
+
+    /* Queue fills up at DA7281_I2C_QUEUE_DEPTH */
+    for (unsigned i = 4U; i < DA7281_I2C_QUEUE_DEPTH; i++) {
+        assert(da7281_write_register_async(&s_devices[0], DA7281_REG_TOP_CTL2, 0x80U,
+                                           NULL, NULL) == DA7281_OK);
+    }
+    assert(da7281_write_register_async(&s_devices[0], DA7281_REG_TOP_CTL2, 0x80U,
+                                       NULL, NULL) == DA7281_ERROR_BUSY);
+
+    /* Every interrupt completes one transfer and starts the next */
+    unsigned irqs = 0;
+    while (mock_bus_fire_irq(0)) {
+        irqs++;
+    }
+    mock_bus_stats_t stats = mock_bus_stats();
+    print_stats("8 queued transfers:", &stats);
+    assert(irqs == DA7281_I2C_QUEUE_DEPTH);
+    assert(stats.transactions == DA7281_I2C_QUEUE_DEPTH);
+
+    /* Callbacks in submission order with data in place */
+    assert(s_async.calls == 4U);
+    for (unsigned i = 0; i < 4U; i++) {
+        assert(s_async.order[i] == (uintptr_t)(i + 1U));
+        assert(s_async.results[i] == DA7281_OK);
+    }
+    assert(memcmp(readback, lra, sizeof(lra)) == 0);
+    assert(chip_rev == 0xCAU);
+    assert(mock_bus_reg(0, addr, DA7281_REG_TOP_CTL2) == 0x80U);
+
+    /* NACK is reported through the callback */
+    mock_bus_set_present(0, addr, 0);
+    assert(da7281_read_register_async(&s_devices[0], DA7281_REG_CHIP_REV, &chip_rev,
+                                      async_record, (void *)5) == DA7281_OK);
+    assert(mock_bus_fire_irq(0) == 1);
+    assert(s_async.results[4] == DA7281_ERROR_I2C_READ);
+    mock_bus_set_present(0, addr, 1);
+    mock_bus_set_deferred(0);
+
+    /* Task notification helper */
+    assert(da7281_write_register_async(&s_devices[0], DA7281_REG_TOP_CTL2, 0x00U,
+                                       da7281_xfer_notify_task,
+                                       xTaskGetCurrentTaskHandle()) == DA7281_OK);
+    assert(ulTaskNotifyTake(pdTRUE, 0) == 1U);
+
+    /* Blocking calls still work on top of the queue */
+    uint8_t value = 0;
+    assert(da7281_read_register(&s_devices[0], DA7281_REG_TOP_CTL2, &value) == DA7281_OK);
+    assert(value == 0x00U);
+
+    printf("✅ PASS: %u transfers queued without blocking, completed in order\n", irqs);
+}
+
+/* Test 8: CPU interrupts per transferred byte for the selected backend */
+static void test_backend_cpu_load(void)
+{
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+    printf("\n=== Test 8: CPU load per byte (TWIM EasyDMA backend) ===\n");
+#else
+    printf("\n=== Test 8: CPU load per byte (legacy TWI backend) ===\n");
+#endif
+    setup_devices();
+
+    static uint8_t image[DA7281_I2C_MAX_BURST_LEN];
+    for (unsigned i = 0; i < sizeof(image); i++) {
+        image[i] = (uint8_t)i;
+    }
+    static const struct {
+        const char *label;
+        uint8_t reg;
+        uint8_t len;
+        bool read;
+    } cases[] = {
+        {"write 1 reg:",         DA7281_REG_TOP_CTL2,      1U,                       false},
+        {"write LRA block (7):", DA7281_REG_LRA_PER_H,     7U,                       false},
+        {"read status (4):",     DA7281_REG_IRQ_EVENT1,    4U,                       true},
+        {"write SNP (100):",     DA7281_REG_SNP_MEM_BASE,  DA7281_I2C_MAX_BURST_LEN, false},
+        {"read SNP (100):",      DA7281_REG_SNP_MEM_BASE,  DA7281_I2C_MAX_BURST_LEN, true},
+    };
+
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        mock_bus_clear_stats();
+        if (cases[c].read) {
+            assert(da7281_read_burst(&s_devices[0], cases[c].reg, image, cases[c].len) == DA7281_OK);
+        } else {
+            assert(da7281_write_burst(&s_devices[0], cases[c].reg, image, cases[c].len) == DA7281_OK);
+        }
+        mock_bus_stats_t stats = mock_bus_stats();
+        printf("  %-22s bytes=%-4u irqs=%-4u irqs/byte=%.2f\n", cases[c].label,
+               stats.bytes, stats.cpu_irqs, (double)stats.cpu_irqs / stats.bytes);
+
+#if (DA7281_I2C_BACKEND == DA7281_I2C_BACKEND_TWIM)
+        /* One DMA job per frame regardless of length */
+        assert(stats.cpu_irqs == 1U);
+#else
+        /* One interrupt per byte plus STOPPED */
+        assert(stats.cpu_irqs == stats.bytes + 1U);
+#endif
+    }
+
+    printf("✅ PASS: Interrupt count matches the backend model\n");
+}
+
+/* Start one override amplitude on four actuators sharing TWI0; returns skew in us */
+static double session_fire(da7281_device_t *group, uint8_t amplitude, bool session)
+{
+    if (session) {
+        assert(da7281_bus_begin(0) == DA7281_OK);
+    }
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        assert(da7281_set_override_amplitude(&group[i], amplitude) == DA7281_OK);
+    }
+    if (session) {
+        assert(da7281_bus_end(0) == DA7281_OK);
+    }
+
+    double first = mock_bus_write_time_us(0, group[0].i2c_address, DA7281_REG_TOP_CTL2);
+    double last = mock_bus_write_time_us(0, group[TEST_ACTUATORS - 1U].i2c_address,
+                                         DA7281_REG_TOP_CTL2);
+    return last - first;
+}
+
+/* Test 9: one lock for many operations across devices */
+static void test_bus_session(void)
+{
+    printf("\n=== Test 9: Bus session (one lock, %u devices) ===\n", TEST_ACTUATORS);
+    mock_bus_reset();
+    (void)da7281_i2c_configure_pins(0, 4, 5);
+
+    da7281_device_t group[TEST_ACTUATORS];
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        memset(&group[i], 0, sizeof(group[i]));
+        group[i].twi_instance = 0;
+        group[i].i2c_address = (uint8_t)(DA7281_I2C_ADDR_0x48 + i);
+        assert(da7281_init(&group[i]) == DA7281_OK);
+    }
+
+    /* Another task writes a 4-byte frame whenever it wins the bus */
+    mock_bus_set_contender(0, 4);
+
+    mock_bus_clear_stats();
+    double skew_plain = session_fire(group, 0x40, false);
+    mock_bus_stats_t plain = mock_bus_stats();
+    print_stats("4x amplitude, per-call lock:", &plain);
+
+    mock_bus_clear_stats();
+    double skew_session = session_fire(group, 0x60, true);
+    mock_bus_stats_t session = mock_bus_stats();
+    print_stats("4x amplitude, one session:", &session);
+
+    printf("  Inter-device skew: %.1f us per-call lock, %.1f us in session\n",
+           skew_plain, skew_session);
+
+    assert(plain.lock_takes == TEST_LOCKS(TEST_ACTUATORS));
+    assert(session.lock_takes == TEST_LOCKS(1U));
+    assert(session.transactions == plain.transactions);
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_NONE)
+    /* Single owner: nobody else can take the bus in between */
+    assert(skew_session == skew_plain);
+#else
+    assert(skew_session < skew_plain);
+#endif
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        assert(mock_bus_reg(0, group[i].i2c_address, DA7281_REG_TOP_CTL2) == 0x60);
+    }
+    mock_bus_set_contender(0, 0);
+
+    /* Nested sessions and read-modify-write share the outer lock */
+    mock_bus_clear_stats();
+    assert(da7281_bus_begin(0) == DA7281_OK);
+    assert(da7281_bus_begin(0) == DA7281_OK);
+    assert(da7281_modify_register(&group[1], DA7281_REG_TOP_CTL2, 0x0F, 0x05) == DA7281_OK);
+    assert(da7281_bus_end(0) == DA7281_OK);
+    assert(da7281_write_register(&group[2], DA7281_REG_TOP_CTL2, 0x11) == DA7281_OK);
+    assert(da7281_bus_end(0) == DA7281_OK);
+    assert(mock_bus_stats().lock_takes == TEST_LOCKS(1U));
+    assert(mock_bus_reg(0, group[1].i2c_address, DA7281_REG_TOP_CTL2) == 0x65);
+
+    /* Unbalanced end and bad instance are rejected */
+    assert(da7281_bus_end(0) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_bus_begin(2) == DA7281_ERROR_INVALID_PARAM);
+
+    /* Outside a session every call locks again */
+    mock_bus_clear_stats();
+    assert(da7281_write_register(&group[0], DA7281_REG_TOP_CTL2, 0x00) == DA7281_OK);
+    assert(mock_bus_stats().lock_takes == TEST_LOCKS(1U));
+
+    printf("✅ PASS: Session holds one lock across %u devices\n", TEST_ACTUATORS);
+}
+
+/* Spread of TOP_CTL2 write times over the board, in us */
+static double fanout_skew(void)
+{
+    double first = 0.0;
+    double last = 0.0;
+
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        double t = mock_bus_write_time_us(s_devices[i].twi_instance, s_devices[i].i2c_address,
+                                          DA7281_REG_TOP_CTL2);
+        if ((i == 0U) || (t < first)) {
+            first = t;
+        }
+        if ((i == 0U) || (t > last)) {
+            last = t;
+        }
+    }
+    return last - first;
+}
+
+/* Test 10: amplitude fan-out to a 2x2 grid on both buses */
+static void test_amplitude_fanout(void)
+{
+    printf("\n=== Test 10: Synchronized amplitude fan-out (2 buses x 2) ===\n");
+    setup_devices();
+
+    da7281_device_t *grid[TEST_ACTUATORS];
+    uint8_t amps[TEST_ACTUATORS];
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        grid[i] = &s_devices[i];
+        amps[i] = (uint8_t)(0x20U * (i + 1U));
+    }
+
+    /* Another task writes a 4-byte frame on each bus whenever it wins a lock */
+    mock_bus_set_contender(0, 4);
+    mock_bus_set_contender(1, 4);
+
+    mock_bus_settle();
+    mock_bus_clear_stats();
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        assert(da7281_set_override_amplitude(grid[i], amps[i]) == DA7281_OK);
+    }
+    mock_bus_stats_t loop = mock_bus_stats();
+    double skew_loop = fanout_skew();
+    print_stats("loop of 4 single writes:", &loop);
+
+    mock_bus_settle();
+    mock_bus_clear_stats();
+    assert(da7281_set_override_amplitude_multi(grid, amps, TEST_ACTUATORS) == DA7281_OK);
+    mock_bus_stats_t multi = mock_bus_stats();
+    double skew_multi = fanout_skew();
+    print_stats("set_override_amplitude_multi:", &multi);
+
+    printf("  Worst-case skew: %.1f us loop, %.1f us multi\n", skew_loop, skew_multi);
+
+    /* One STOP per bus, the second device on each bus is reached by repeated START */
+    assert(multi.transactions == 2U);
+    assert(multi.address_phases == TEST_ACTUATORS);
+    assert(multi.lock_takes <= TEST_LOCKS(2U));
+    assert(loop.lock_takes == TEST_LOCKS(TEST_ACTUATORS));
+    assert(skew_multi < skew_loop);
+    for (uint8_t i = 0; i < TEST_ACTUATORS; i++) {
+        assert(mock_bus_reg(s_devices[i].twi_instance, s_devices[i].i2c_address,
+                            DA7281_REG_TOP_CTL2) == amps[i]);
+        assert(s_devices[i].cache == NULL);
+    }
+    mock_bus_set_contender(0, 0);
+    mock_bus_set_contender(1, 0);
+
+    /* A missing device fails the call but does not stop the others */
+    mock_bus_set_present(0, s_devices[0].i2c_address, 0);
+    memset(amps, 0x7F, sizeof(amps));
+    assert(da7281_set_override_amplitude_multi(grid, amps, TEST_ACTUATORS) == DA7281_ERROR_I2C_WRITE);
+    for (uint8_t i = 1; i < TEST_ACTUATORS; i++) {
+        assert(mock_bus_reg(s_devices[i].twi_instance, s_devices[i].i2c_address,
+                            DA7281_REG_TOP_CTL2) == 0x7F);
+    }
+    mock_bus_set_present(0, s_devices[0].i2c_address, 1);
+
+    assert(da7281_set_override_amplitude_multi(NULL, amps, 1) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_set_override_amplitude_multi(grid, amps, 0) == DA7281_ERROR_INVALID_PARAM);
+
+    printf("✅ PASS: Fan-out skew %.1f us -> %.1f us\n", skew_loop, skew_multi);
+}
+
+/* Test 11: diff writes send only the bytes that differ from the shadow cache */
+static void test_diff_reconfigure(void)
+{
+    printf("\n=== Test 11: Differential reconfiguration ===\n");
+    setup_devices();
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    s_devices[0].cache = &cache;
+    (void)da7281_cache_invalidate(&s_devices[0]);
+    uint8_t skipped = 0xFF;
+
+    /* Nothing known yet: everything is written */
+    mock_bus_clear_stats();
+    assert(da7281_configure_lra_diff(&s_devices[0], &s_lra_config, &skipped) == DA7281_OK);
+    mock_bus_stats_t first = mock_bus_stats();
+    print_stats("configure_lra_diff (cold):", &first);
+    assert((first.transactions == 1U) && (first.bytes == 8U) && (skipped == 0U));
+
+    /* Same configuration again: no traffic at all */
+    mock_bus_clear_stats();
+    assert(da7281_configure_lra_diff(&s_devices[0], &s_lra_config, &skipped) == DA7281_OK);
+    mock_bus_stats_t again = mock_bus_stats();
+    print_stats("configure_lra_diff (same):", &again);
+    assert((again.transactions == 0U) && (again.lock_takes == 0U) && (skipped == 7U));
+
+    /* Another current limit: only IMAX and V2I_FACTOR change */
+    da7281_lra_config_t other = s_lra_config;
+    other.max_current_ma = 300;
+    da7281_lra_regs_t a;
+    da7281_lra_regs_t b;
+    assert(da7281_lra_compute(&s_lra_config, &a) == DA7281_OK);
+    assert(da7281_lra_compute(&other, &b) == DA7281_OK);
+    uint8_t differing = (uint8_t)(((a.lra_per >> 8) != (b.lra_per >> 8)) +
+                                  ((a.lra_per & 0xFF) != (b.lra_per & 0xFF)) +
+                                  (a.imax != b.imax) +
+                                  ((a.v2i_factor >> 8) != (b.v2i_factor >> 8)) +
+                                  ((a.v2i_factor & 0xFF) != (b.v2i_factor & 0xFF)));
+    mock_bus_clear_stats();
+    assert(da7281_configure_lra_diff(&s_devices[0], &other, &skipped) == DA7281_OK);
+    mock_bus_stats_t change = mock_bus_stats();
+    print_stats("configure_lra_diff (switch):", &change);
+    assert((change.transactions == 1U) && (change.bytes < first.bytes));
+    assert((skipped == (uint8_t)(8U - change.bytes)) && (skipped <= (uint8_t)(7U - differing)));
+    for (uint8_t reg = DA7281_REG_LRA_PER_H; reg <= DA7281_REG_V2I_FACTOR_L; reg++) {
+        assert(cache.value[reg] == mock_bus_reg(0, s_devices[0].i2c_address, reg));
+    }
+    assert(mock_bus_reg(0, s_devices[0].i2c_address, DA7281_REG_ACTUATOR_IMAX) == b.imax);
+
+    /* Gaps of up to DA7281_DIFF_MERGE_GAP unchanged bytes are bridged */
+    uint8_t image[7];
+    memcpy(image, &cache.value[DA7281_REG_LRA_PER_H], sizeof(image));
+    image[0] ^= 0x01U;
+    image[3] ^= 0x01U;
+    mock_bus_clear_stats();
+    assert(da7281_write_burst_diff(&s_devices[0], DA7281_REG_LRA_PER_H, image, 7U, &skipped) == DA7281_OK);
+    mock_bus_stats_t bridged = mock_bus_stats();
+    print_stats("diff, 2-byte gap:", &bridged);
+    assert((bridged.transactions == 1U) && (bridged.bytes == 5U) && (skipped == 3U));
+
+    /* Wider gaps split into bursts under one lock */
+    image[0] ^= 0x01U;
+    image[4] ^= 0x01U;
+    image[6] ^= 0x01U;
+    mock_bus_clear_stats();
+    assert(da7281_write_burst_diff(&s_devices[0], DA7281_REG_LRA_PER_H, image, 7U, &skipped) == DA7281_OK);
+    mock_bus_stats_t split = mock_bus_stats();
+    print_stats("diff, 3 changes, 2 bursts:", &split);
+    assert((split.transactions == 2U) && (split.lock_takes == TEST_LOCKS(1U)));
+
+    /* Without a cache there is nothing to compare against */
+    s_devices[0].cache = NULL;
+    mock_bus_clear_stats();
+    assert(da7281_configure_lra_diff(&s_devices[0], &s_lra_config, &skipped) == DA7281_OK);
+    assert((mock_bus_stats().transactions == 1U) && (skipped == 0U));
+
+    printf("✅ PASS: Re-apply %u -> %u frames, switch %u -> %u bytes\n",
+           first.transactions, again.transactions, first.bytes, change.bytes);
+}
+
+/* Test 12: a write set sorts, fuses and bursts scattered writes under one lock */
+static void test_write_set(void)
+{
+    printf("\n=== Test 12: Write-set optimizer ===\n");
+    setup_devices();
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    s_devices[0].cache = &cache;
+    (void)da7281_cache_invalidate(&s_devices[0]);
+    const uint8_t addr = s_devices[0].i2c_address;
+    mock_bus_set_reg(0, addr, DA7281_REG_TOP_CFG1, 0x01U);
+
+    uint8_t value;
+    assert(da7281_read_register_cached(&s_devices[0], DA7281_REG_TOP_CFG1, &value) == DA7281_OK);
+    assert(da7281_read_register_cached(&s_devices[0], DA7281_REG_TOP_CTL1, &value) == DA7281_OK);
+
+    /* Scattered, in the order driver code tends to issue them */
+    da7281_write_set_t set;
+    assert(da7281_write_set_init(&set) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_TOP_CTL1, DA7281_TOP_CTL1_OP_MODE_MASK, DA7281_MODE_DRO) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_AMP_EN, 0xFFU) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_V2I_FACTOR_L, 0xFFU, 0x17U) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_LRA_PER_H, 0xFFU, 0x11U) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_LRA_PER_L, 0xFFU, 0x12U) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_ACTUATOR_TYPE, 0xFFU) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_IRQ_EVENT1, 0xFFU, 0x01U) == DA7281_OK);
+    for (uint8_t reg = DA7281_REG_ACTUATOR_NOMMAX; reg <= DA7281_REG_V2I_FACTOR_H; reg++) {
+        assert(da7281_write_set_add(&set, reg, 0xFFU, (uint8_t)(0x10U + reg)) == DA7281_OK);
+    }
+    assert(da7281_write_set_add(&set, DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_AMP_EN, 0U) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_TOP_CFG1, DA7281_TOP_CFG1_AMP_EN, 0xFFU) == DA7281_OK);
+    assert(set.count == 10U);
+
+    mock_bus_clear_stats();
+    assert(da7281_write_set_commit(&s_devices[0], &set) == DA7281_OK);
+    mock_bus_stats_t stats = mock_bus_stats();
+    print_stats("write set (10 registers):", &stats);
+
+    /* 0x0A-0x10 and 0x13 as bursts, then IRQ_EVENT1 and TOP_CTL1 alone */
+    assert(stats.transactions == 4U);
+    assert(stats.bytes == (8U + 2U + 2U + 2U));
+    assert(stats.lock_takes == TEST_LOCKS(1U));
+    for (uint8_t i = 1; i < set.count; i++) {
+        assert(set.entries[i - 1U].reg < set.entries[i].reg);
+    }
+    assert(mock_bus_reg(0, addr, DA7281_REG_TOP_CFG1) ==
+           (0x01U | DA7281_TOP_CFG1_AMP_EN | DA7281_TOP_CFG1_ACTUATOR_TYPE));
+    assert(mock_bus_reg(0, addr, DA7281_REG_ACTUATOR_IMAX) == (0x10U + DA7281_REG_ACTUATOR_IMAX));
+    assert(mock_bus_reg(0, addr, DA7281_REG_V2I_FACTOR_L) == 0x17U);
+    assert((mock_bus_reg(0, addr, DA7281_REG_TOP_CTL1) & DA7281_TOP_CTL1_OP_MODE_MASK) == DA7281_MODE_DRO);
+    assert(mock_bus_write_time_us(0, addr, DA7281_REG_TOP_CTL1) >
+           mock_bus_write_time_us(0, addr, DA7281_REG_TOP_CFG1));
+
+    /* The same writes issued one by one */
+    mock_bus_clear_stats();
+    for (uint8_t i = 0; i < set.count; i++) {
+        if (set.entries[i].mask == 0xFFU) {
+            assert(da7281_write_register(&s_devices[0], set.entries[i].reg, set.entries[i].value) == DA7281_OK);
+        } else {
+            assert(da7281_modify_register(&s_devices[0], set.entries[i].reg,
+                                          set.entries[i].mask, set.entries[i].value) == DA7281_OK);
+        }
+    }
+    mock_bus_stats_t separate = mock_bus_stats();
+    print_stats("same writes one by one:", &separate);
+    assert(separate.transactions == 10U);
+
+    /* Reserved and read-only registers are refused; fusing does not use capacity */
+    assert(da7281_write_set_add(&set, 0x01U, 0xFFU, 0U) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_write_set_add(&set, DA7281_REG_IRQ_STATUS1, 0xFFU, 0U) == DA7281_ERROR_INVALID_PARAM);
+
+    /* Partial masks on write-1-to-clear event registers would clear every latched event */
+    uint8_t held = set.count;
+    assert(da7281_write_set_add(&set, DA7281_REG_IRQ_EVENT1, 0x01U, 0x01U) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_write_set_add(&set, DA7281_REG_IRQ_EVENT_ACTUATOR_FAULT, 0x7FU, 0U) == DA7281_ERROR_INVALID_PARAM);
+    assert(set.count == held);
+    assert(da7281_write_set_init(&set) == DA7281_OK);
+    for (uint8_t i = 0; i < DA7281_WRITE_SET_MAX; i++) {
+        assert(da7281_write_set_add(&set, (uint8_t)(DA7281_REG_SNP_MEM_BASE + i), 0xFFU, i) == DA7281_OK);
+    }
+    assert(da7281_write_set_add(&set, DA7281_REG_SNP_MEM_BASE, 0x0FU, 0U) == DA7281_OK);
+    assert(da7281_write_set_add(&set, DA7281_REG_SNP_MEM_END, 0xFFU, 0U) == DA7281_ERROR_INVALID_PARAM);
+    mock_bus_clear_stats();
+    assert(da7281_write_set_commit(&s_devices[0], &set) == DA7281_OK);
+    assert(mock_bus_stats().transactions == 1U);
+
+    assert(da7281_write_set_init(&set) == DA7281_OK);
+    mock_bus_clear_stats();
+    assert(da7281_write_set_commit(&s_devices[0], &set) == DA7281_OK);
+    assert(mock_bus_stats().transactions == 0U);
+    s_devices[0].cache = NULL;
+
+    printf("✅ PASS: %u frames / %u locks instead of %u / %u\n", stats.transactions,
+           stats.lock_takes, separate.transactions, separate.lock_takes);
+}
+
+/* Test 13: verify policy sets the readback cost of a mode change */
+static void test_verify_policy(void)
+{
+    printf("\n=== Test 13: Verify-readback policy ===\n");
+    setup_devices();
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    da7281_device_t *dev = &s_devices[0];
+    const uint8_t addr = dev->i2c_address;
+    dev->cache = &cache;
+    (void)da7281_cache_invalidate(dev);
+    assert(da7281_set_operation_mode(dev, DA7281_MODE_INACTIVE) == DA7281_OK);
+
+    /* Zero-initialized handles verify every write */
+    assert(dev->verify == DA7281_VERIFY_ALWAYS);
+    mock_bus_clear_stats();
+    assert(da7281_set_operation_mode(dev, DA7281_MODE_DRO) == DA7281_OK);
+    mock_bus_stats_t always = mock_bus_stats();
+    print_stats("mode change, ALWAYS:", &always);
+    assert(always.transactions == 2U);
+
+    mock_bus_clear_stats();
+    assert(da7281_set_operation_mode_policy(dev, DA7281_MODE_INACTIVE, DA7281_VERIFY_NEVER) == DA7281_OK);
+    mock_bus_stats_t never = mock_bus_stats();
+    print_stats("mode change, NEVER:", &never);
+    assert(never.transactions == 1U);
+    assert(dev->verify == DA7281_VERIFY_ALWAYS);
+
+    /* DEFERRED: writes only, then one burst read for all of them */
+    dev->verify = DA7281_VERIFY_DEFERRED;
+    mock_bus_clear_stats();
+    for (unsigned n = 0; n < 8U; n++) {
+        da7281_operation_mode_t mode = ((n % 2U) == 0U) ? DA7281_MODE_DRO : DA7281_MODE_INACTIVE;
+        assert(da7281_set_operation_mode(dev, mode) == DA7281_OK);
+    }
+    mock_bus_stats_t deferred = mock_bus_stats();
+    assert(deferred.transactions == 8U);
+    assert(dev->verify_count == 1U);
+
+    mock_bus_clear_stats();
+    assert(da7281_verify_flush(dev) == DA7281_OK);
+    mock_bus_stats_t flush = mock_bus_stats();
+    print_stats("8 mode changes, DEFERRED:", &deferred);
+    print_stats("da7281_verify_flush:", &flush);
+    assert((flush.transactions == 1U) && (dev->verify_count == 0U));
+    assert(da7281_verify_flush(dev) == DA7281_OK);
+
+    /* A register that did not take the write is reported by the flush */
+    assert(da7281_set_operation_mode(dev, DA7281_MODE_DRO) == DA7281_OK);
+    mock_bus_set_reg(0, addr, DA7281_REG_TOP_CTL1, DA7281_MODE_INACTIVE);
+    assert(da7281_verify_flush(dev) == DA7281_ERROR_VERIFY_FAILED);
+    assert(dev->verify_count == 0U);
+
+    /* init queues TOP_CFG1 and TOP_CTL1; one 16-byte burst checks both */
+    dev->initialized = false;
+    assert(da7281_init(dev) == DA7281_OK);
+    assert(dev->verify_count == 2U);
+    mock_bus_clear_stats();
+    assert(da7281_verify_flush(dev) == DA7281_OK);
+    assert((mock_bus_stats().transactions == 1U) &&
+           (mock_bus_stats().bytes == (1U + DA7281_REG_TOP_CTL1 - DA7281_REG_TOP_CFG1 + 1U)));
+
+    assert(da7281_set_operation_mode_policy(dev, DA7281_MODE_DRO, (da7281_verify_t)7) ==
+           DA7281_ERROR_INVALID_PARAM);
+    dev->verify = DA7281_VERIFY_ALWAYS;
+    dev->cache = NULL;
+
+    printf("✅ PASS: Mode change %u frames (ALWAYS) / %u (NEVER); 8 deferred checks in %u read\n",
+           always.transactions, never.transactions, flush.transactions);
+}
+
+/* Time from call to the last of the given registers being written, in us */
+static double drive_latency(const da7281_device_t *dev, double start)
+{
+    const uint8_t regs[3] = {DA7281_REG_TOP_CFG1, DA7281_REG_TOP_CTL1, DA7281_REG_TOP_CTL2};
+    double last = 0.0;
+    for (uint8_t i = 0; i < 3U; i++) {
+        double t = mock_bus_write_time_us(dev->twi_instance, dev->i2c_address, regs[i]);
+        last = (t > last) ? t : last;
+    }
+    return last - start;
+}
+
+/* Test 14: play_dro/stop reach the target state with the fewest frames */
+static void test_play_stop(void)
+{
+    printf("\n=== Test 14: DRO play/stop fast path ===\n");
+
+    static da7281_reg_cache_t cache;
+    for (unsigned cached = 0; cached < 2U; cached++) {
+        setup_devices();
+        da7281_device_t *dev = &s_devices[0];
+        const uint8_t addr = dev->i2c_address;
+        memset(&cache, 0, sizeof(cache));
+        dev->cache = (cached != 0U) ? &cache : NULL;
+        dev->verify = DA7281_VERIFY_ALWAYS;
+        (void)da7281_cache_invalidate(dev);
+        assert(da7281_set_operation_mode(dev, DA7281_MODE_INACTIVE) == DA7281_OK);
+
+        /* Reference: the three separate calls */
+        mock_bus_settle();
+        double start = mock_bus_now_us();
+        mock_bus_clear_stats();
+        assert(da7281_set_operation_mode(dev, DA7281_MODE_DRO) == DA7281_OK);
+        assert(da7281_set_amplifier_enable(dev, true) == DA7281_OK);
+        assert(da7281_set_override_amplitude(dev, 0x40U) == DA7281_OK);
+        mock_bus_stats_t separate = mock_bus_stats();
+        double separate_us = drive_latency(dev, start);
+        print_stats(cached ? "mode+amp+amplitude (cache):" : "mode+amp+amplitude:", &separate);
+
+        /* Stop, then play; streaming policy */
+        dev->verify = DA7281_VERIFY_NEVER;
+        mock_bus_clear_stats();
+        assert(da7281_stop(dev) == DA7281_OK);
+        mock_bus_stats_t stop = mock_bus_stats();
+        assert((mock_bus_reg(0, addr, DA7281_REG_TOP_CTL1) & DA7281_TOP_CTL1_OP_MODE_MASK) == DA7281_OP_MODE_INACTIVE);
+        assert(mock_bus_reg(0, addr, DA7281_REG_TOP_CTL2) == 0U);
+        assert(dev->mode == DA7281_MODE_INACTIVE);
+        print_stats("da7281_stop:", &stop);
+
+        mock_bus_settle();
+        start = mock_bus_now_us();
+        mock_bus_clear_stats();
+        assert(da7281_play_dro(dev, 0x40U) == DA7281_OK);
+        mock_bus_stats_t play = mock_bus_stats();
+        double play_us = drive_latency(dev, start);
+        print_stats("da7281_play_dro:", &play);
+        assert((mock_bus_reg(0, addr, DA7281_REG_TOP_CTL1) & DA7281_TOP_CTL1_OP_MODE_MASK) == DA7281_OP_MODE_DRO);
+        assert((mock_bus_reg(0, addr, DA7281_REG_TOP_CFG1) & DA7281_TOP_CFG1_AMP_EN) != 0U);
+        assert(mock_bus_reg(0, addr, DA7281_REG_TOP_CTL2) == 0x40U);
+        assert(play.lock_takes == TEST_LOCKS(1U));
+        printf("  amplitude reached after %.1f us (separate calls %.1f us)\n", play_us, separate_us);
+        assert(play_us < separate_us);
+
+        if (cached != 0U) {
+            assert((play.transactions == 1U) && (play.bytes == 3U) && (stop.transactions == 1U));
+
+            /* Retune while playing: TOP_CTL2 only; same amplitude: nothing */
+            mock_bus_clear_stats();
+            assert(da7281_play_dro(dev, 0x50U) == DA7281_OK);
+            assert(da7281_play_dro(dev, 0x50U) == DA7281_OK);
+            assert((mock_bus_stats().transactions == 1U) && (mock_bus_stats().bytes == 2U));
+
+            /* Stopping twice costs nothing the second time */
+            assert(da7281_stop(dev) == DA7281_OK);
+            mock_bus_clear_stats();
+            assert(da7281_stop(dev) == DA7281_OK);
+            assert(mock_bus_stats().transactions == 0U);
+
+            /* From RTWM with a stale amplitude: INACTIVE, then amplitude before the mode */
+            mock_bus_set_reg(0, addr, DA7281_REG_TOP_CTL1, DA7281_OP_MODE_RTWM);
+            cache.value[DA7281_REG_TOP_CTL1] = DA7281_OP_MODE_RTWM;
+            cache.value[DA7281_REG_TOP_CTL2] = 0x10U;
+            mock_bus_clear_stats();
+            assert(da7281_play_dro(dev, 0x60U) == DA7281_OK);
+            assert(mock_bus_stats().transactions == 3U);
+            assert(mock_bus_write_time_us(0, addr, DA7281_REG_TOP_CTL2) <
+                   mock_bus_write_time_us(0, addr, DA7281_REG_TOP_CTL1));
+            assert((mock_bus_reg(0, addr, DA7281_REG_TOP_CTL1) & DA7281_TOP_CTL1_OP_MODE_MASK) == DA7281_OP_MODE_DRO);
+
+            /* ALWAYS adds the TOP_CTL1 readback after the drive started */
+            dev->verify = DA7281_VERIFY_ALWAYS;
+            assert(da7281_stop(dev) == DA7281_OK);
+            mock_bus_clear_stats();
+            assert(da7281_play_dro(dev, 0x40U) == DA7281_OK);
+            assert(mock_bus_stats().transactions == 2U);
+        }
+
+        dev->verify = DA7281_VERIFY_ALWAYS;
+        dev->cache = NULL;
+    }
+
+    assert(da7281_play_dro(NULL, 0U) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_stop(NULL) == DA7281_ERROR_NULL_POINTER);
+
+    printf("✅ PASS: Play and stop in one frame each from a warm cache\n");
+}
+
+/* Test 15: a completion arriving after its call timed out stays with that call */
+static void test_late_completion(void)
+{
+    printf("\n=== Test 15: Late completion after a timeout ===\n");
+#if (DA7281_BUS_LOCK == DA7281_BUS_LOCK_CRITICAL)
+    /* The spin-wait never yields to the mock interrupt */
+    printf("  skipped: completions cannot arrive during a spin-wait on the host\n");
+#else
+    setup_devices();
+
+    const uint8_t addr = s_devices[0].i2c_address;
+    const uint8_t lra[3] = {0x11, 0x3C, 0x6A};
+    const uint8_t cfg[3] = {0xA5, 0x5A, 0xC3};
+    uint8_t stale[3] = {0};
+    uint8_t value = 0;
+
+    for (unsigned i = 0; i < 3U; i++) {
+        mock_bus_set_reg(0, addr, (uint8_t)(DA7281_REG_LRA_PER_H + i), lra[i]);
+    }
+    mock_bus_set_reg(0, addr, DA7281_REG_TOP_CTL2, 0x42U);
+
+    /* Held transfer: the blocking read gives up and leaves its frame on the bus */
+    mock_bus_set_deferred(1);
+    assert(da7281_read_burst(&s_devices[0], DA7281_REG_LRA_PER_H, stale, 3U) == DA7281_ERROR_TIMEOUT);
+
+    /* Its completion lands while the next call waits: that call still gets its own byte */
+    mock_bus_set_fire_on_wait(1);
+    assert(da7281_read_register(&s_devices[0], DA7281_REG_TOP_CTL2, &value) == DA7281_OK);
+    assert(value == 0x42U);
+
+    /* A late read DMA does not overwrite the payload of the next blocking write */
+    mock_bus_set_fire_on_wait(0);
+    assert(da7281_read_burst(&s_devices[0], DA7281_REG_LRA_PER_H, stale, 3U) == DA7281_ERROR_TIMEOUT);
+    mock_bus_set_fire_on_wait(1);
+    assert(da7281_write_burst(&s_devices[0], DA7281_REG_TOP_INT_CFG6_H, cfg, 3U) == DA7281_OK);
+    for (unsigned i = 0; i < 3U; i++) {
+        assert(mock_bus_reg(0, addr, (uint8_t)(DA7281_REG_TOP_INT_CFG6_H + i)) == cfg[i]);
+    }
+
+    /* Timed out in the middle of a repeated-START chain: the rest still ends with a STOP */
+    mock_bus_set_fire_on_wait(0);
+    da7281_device_t *const chain[2] = {&s_devices[0], &s_devices[1]};
+    const uint8_t amplitude[2] = {0x21U, 0x22U};
+    assert(da7281_write_register_multi(chain, DA7281_REG_TOP_CTL2, amplitude, 2U) == DA7281_ERROR_TIMEOUT);
+    assert(mock_bus_fire_irq(0) == 1);
+    assert(mock_bus_frame_open(0));
+    while (mock_bus_fire_irq(0)) {
+    }
+    assert(!mock_bus_frame_open(0));
+    assert(mock_bus_reg(0, s_devices[1].i2c_address, DA7281_REG_TOP_CTL2) == 0x22U);
+
+    mock_bus_set_deferred(0);
+    assert(da7281_read_register(&s_devices[0], DA7281_REG_TOP_CTL2, &value) == DA7281_OK);
+    assert(value == 0x21U);
+
+    printf("✅ PASS: Timed-out transfers complete without touching later calls\n");
+#endif
+}
+
+/* Completion callback that queues a follow-up write from the TWI handler */
+static da7281_error_t s_chained_result;
+
+static void async_chain(da7281_device_t *device, da7281_error_t result, void *context)
+{
+    (void)result;
+    (void)context;
+    s_chained_result = da7281_write_register_async(device, DA7281_REG_TOP_CTL2, 0xC3U,
+                                                   NULL, NULL);
+}
+
+/* Test 16: asynchronous calls cannot slip into another task's bus session */
+static void test_async_session(void)
+{
+    printf("\n=== Test 16: Asynchronous calls during a bus session ===\n");
+    setup_devices();
+
+    const uint8_t addr = s_devices[0].i2c_address;
+    uint8_t value = 0;
+
+    /* Task 0 opens a session for a read-modify-write */
+    assert(da7281_bus_begin(0) == DA7281_OK);
+    assert(da7281_modify_register(&s_devices[0], DA7281_REG_TOP_CTL2, 0x0FU, 0x05U) == DA7281_OK);
+
+    /* Another task's frames would land inside it: refused on that bus only */
+    mock_bus_set_task(1);
+    assert(da7281_write_register_async(&s_devices[0], DA7281_REG_TOP_CTL2, 0xF0U,
+                                       NULL, NULL) == DA7281_ERROR_BUSY);
+    assert(da7281_read_register_async(&s_devices[1], DA7281_REG_TOP_CTL2, &value,
+                                      NULL, NULL) == DA7281_ERROR_BUSY);
+    assert(da7281_write_register_async(&s_devices[2], DA7281_REG_TOP_CTL2, 0x33U,
+                                       NULL, NULL) == DA7281_OK);
+
+    /* The owner still queues on its own bus */
+    mock_bus_set_task(0);
+    assert(da7281_write_register_async(&s_devices[1], DA7281_REG_TOP_CTL2, 0x22U,
+                                       NULL, NULL) == DA7281_OK);
+
+    /* A completion callback interrupts the owner but is not the owner */
+    s_chained_result = DA7281_OK;
+    assert(da7281_write_register_async(&s_devices[0], DA7281_REG_TOP_CTL2, 0x05U,
+                                       async_chain, NULL) == DA7281_OK);
+    assert(da7281_read_register(&s_devices[0], DA7281_REG_TOP_CTL2, &value) == DA7281_OK);
+    assert(s_chained_result == DA7281_ERROR_BUSY);
+    assert(value == 0x05U);
+
+    assert(da7281_bus_end(0) == DA7281_OK);
+    assert(mock_bus_reg(0, addr, DA7281_REG_TOP_CTL2) == 0x05U);
+
+    /* Accepted again once the session has ended */
+    mock_bus_set_task(1);
+    assert(da7281_write_register_async(&s_devices[0], DA7281_REG_TOP_CTL2, 0xF0U,
+                                       NULL, NULL) == DA7281_OK);
+    mock_bus_set_task(0);
+    assert(mock_bus_reg(0, addr, DA7281_REG_TOP_CTL2) == 0xF0U);
+
+    printf("✅ PASS: Other tasks' and callbacks' asynchronous calls refused for the length of a session\n");
+}
+
+/* Test 17: frame times in the statistics resolve microseconds on the nRF backend */
+static void test_stats_clock(void)
+{
+    printf("\n=== Test 17: Statistics clock resolution ===\n");
+#if DA7281_ENABLE_STATS
+    setup_devices();
+    da7281_stats_reset();
+
+    /* One 2-byte write: ~72 us at 400 kHz, well under one RTOS tick */
+    mock_bus_settle();
+    mock_bus_clear_stats();
+    assert(da7281_write_register(&s_devices[0], DA7281_REG_TOP_CTL2, 0x10U) == DA7281_OK);
+    mock_bus_stats_t traffic = mock_bus_stats();
+    double frame_us = mock_bus_time_us(&traffic);
+
+    da7281_stats_t stats;
+    assert(da7281_stats_get(&stats) == DA7281_OK);
+    const da7281_stats_counters_t *bus = &stats.bus[0];
+    printf("  2-byte write: xfer_us=%u (bus model %.1f us)\n", (unsigned)bus->xfer_us, frame_us);
+    assert(bus->transactions == 1U);
+    assert(((double)bus->xfer_us > (frame_us - 1.0)) && ((double)bus->xfer_us < (frame_us + 1.0)));
+
+    /* Lands in the 64-127 us bin, not in bin 0 or 1000 us */
+    unsigned bin = 0U;
+    for (uint32_t t = bus->xfer_us; t != 0U; t >>= 1) {
+        bin++;
+    }
+    assert(bin == 7U);
+    assert(bus->xfer_hist[bin] == 1U);
+
+    printf("✅ PASS: Frame time recorded as %u us\n", (unsigned)bus->xfer_us);
+#else
+    printf("  skipped: statistics compiled out (DA7281_ENABLE_STATS=0)\n");
+#endif
+}
+
+int main(void)
+{
+    printf("╔════════════════════════════════════════════╗\n");
+    printf("║  DA7281 HAL Bus Traffic Tests (Host)       ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    test_bus_init();
+    test_configure_lra_single_burst();
+    test_configure_lra_board();
+    test_write_burst_params();
+    test_status_block();
+    test_register_cache();
+    test_async_queue();
+    test_backend_cpu_load();
+    test_bus_session();
+    test_amplitude_fanout();
+    test_diff_reconfigure();
+    test_write_set();
+    test_verify_policy();
+    test_play_stop();
+    test_late_completion();
+    test_async_session();
+    test_stats_clock();
+
+    printf("\n╔════════════════════════════════════════════╗\n");
+    printf("║  ✅ ALL BUS TRAFFIC TESTS PASSED           ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    return 0;
+}
@@ -0,0 +1,1149 @@
+/**
+ * @file test_host_backend.c
+ * @brief Native build of the DA7281 driver on the host bus backend
+ *
+ * Built with DA7281_PLATFORM = DA7281_PLATFORM_HOST and without the SDK
+ * stand-in headers: src/da7281.c and src/da7281_i2c.c reach the bus only
+ * through da7281_bus_ops_host, which drives the DA7281 models in
+ * src/da7281_sim.c.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include "da7281.h"
+#include "da7281_bus.h"
+#include "da7281_sim.h"
+
+static const da7281_lra_config_t s_lra_config = {
+    .resonant_freq_hz = 170,
+    .impedance_ohm = 6.75F,
+    .nom_max_v_rms = 2.5F,
+    .abs_max_v_peak = 3.5F,
+    .max_current_ma = 350
+};
+
+static double bus_time_us(const da7281_bus_host_stats_t *stats)
+{
+    return (double)stats->bits * 2.5;
+}
+
+static void print_stats(const char *label, const da7281_bus_host_stats_t *stats)
+{
+    printf("  %-26s frames=%-3u starts=%-3u bytes=%-4u locks=%-3u bus=%.1f us\n",
+           label, stats->transactions, stats->address_phases, stats->bytes,
+           stats->lock_takes, bus_time_us(stats));
+}
+
+static struct {
+    unsigned calls;
+    da7281_error_t result;
+} s_async;
+
+static void async_done(da7281_device_t *device, da7281_error_t result, void *context)
+{
+    (void)device;
+    (void)context;
+    s_async.calls++;
+    s_async.result = result;
+}
+
+/* Test 1: the default backend is the host one and stays fixed once a bus is up */
+static void test_backend_selection(void)
+{
+    printf("\n=== Test 1: Backend selection ===\n");
+    da7281_bus_host_reset();
+
+    assert(da7281_bus_get_ops() == &da7281_bus_ops_host);
+    assert(da7281_bus_set_ops(NULL) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_bus_set_ops(&da7281_bus_ops_host) == DA7281_OK);
+
+    assert(da7281_i2c_configure_pins(0, 4, 5) == DA7281_OK);
+    assert(da7281_bus_init(0) == DA7281_OK);
+    assert(da7281_bus_set_ops(&da7281_bus_ops_host) == DA7281_ERROR_ALREADY_INITIALIZED);
+
+    printf("✅ PASS: Host backend active; locked in by da7281_bus_init()\n");
+}
+
+/* Test 2: the public API runs natively and is charged in virtual time */
+static void test_api_traffic(void)
+{
+    printf("\n=== Test 2: API traffic on the host bus ===\n");
+    da7281_bus_host_reset();
+
+    da7281_device_t device = {
+        .twi_instance = 0,
+        .i2c_address = DA7281_I2C_ADDR_0x4A
+    };
+    da7281_bus_host_stats_t stats;
+
+    assert(da7281_init(&device) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    print_stats("da7281_init:", &stats);
+    assert(stats.lock_takes == stats.transactions);
+
+    da7281_bus_host_clear_stats();
+    uint32_t t0 = da7281_bus_get_ops()->now();
+    assert(da7281_configure_lra(&device, &s_lra_config) == DA7281_OK);
+    uint32_t t1 = da7281_bus_get_ops()->now();
+    da7281_bus_host_stats(&stats);
+    print_stats("da7281_configure_lra:", &stats);
+    assert(stats.transactions == 1U);
+    assert(stats.bytes == 8U);
+    assert(stats.lock_takes == 1U);
+    double elapsed = (double)(t1 - t0);
+    assert((elapsed > bus_time_us(&stats) - 1.0) && (elapsed < bus_time_us(&stats) + 1.0));
+
+    uint16_t lra_per = (uint16_t)((da7281_sim_peek(0, device.i2c_address, DA7281_REG_LRA_PER_H) << 8) |
+                                  da7281_sim_peek(0, device.i2c_address, DA7281_REG_LRA_PER_L));
+    assert(lra_per == 4412U);
+
+    da7281_bus_host_clear_stats();
+    assert(da7281_set_override_amplitude(&device, 0x80) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    print_stats("da7281_set_override_amplitude:", &stats);
+    assert(stats.transactions == 1U);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_TOP_CTL2) == 0x80U);
+
+    printf("✅ PASS: Driver runs natively; now() tracks bus time\n");
+}
+
+/* Test 3: NACK, async completion and repeated STARTs go through the ops table */
+static void test_events(void)
+{
+    printf("\n=== Test 3: Completion events ===\n");
+    da7281_bus_host_reset();
+
+    da7281_device_t dev[2] = {
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x48},
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x49}
+    };
+    for (uint8_t i = 0; i < 2U; i++) {
+        assert(da7281_init(&dev[i]) == DA7281_OK);
+    }
+
+    memset(&s_async, 0, sizeof(s_async));
+    assert(da7281_write_register_async(&dev[0], DA7281_REG_TOP_CTL2, 0x11, async_done, NULL) == DA7281_OK);
+    assert((s_async.calls == 1U) && (s_async.result == DA7281_OK));
+
+    da7281_device_t *pair[2] = {&dev[0], &dev[1]};
+    const uint8_t amps[2] = {0x40, 0x41};
+    da7281_bus_host_stats_t stats;
+    da7281_bus_host_clear_stats();
+    assert(da7281_set_override_amplitude_multi(pair, amps, 2U) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    assert((stats.transactions == 1U) && (stats.address_phases == 2U));
+
+    uint8_t value;
+    da7281_sim_set_present(0, dev[1].i2c_address, false);
+    assert(da7281_read_register(&dev[1], DA7281_REG_CHIP_REV, &value) == DA7281_ERROR_I2C_READ);
+    da7281_bus_host_stats(&stats);
+    assert(stats.nacks == 1U);
+    da7281_sim_set_present(0, dev[1].i2c_address, true);
+
+    printf("✅ PASS: Events, chained writes and NACKs reported by the backend\n");
+}
+
+static struct {
+    unsigned edges;
+    bool asserted;
+} s_nirq;
+
+static void nirq_edge(uint8_t instance, uint8_t address, bool asserted)
+{
+    (void)instance;
+    (void)address;
+    s_nirq.edges++;
+    s_nirq.asserted = asserted;
+}
+
+static uint8_t sim_mode(const da7281_device_t *device)
+{
+    return da7281_sim_peek(device->twi_instance, device->i2c_address, DA7281_REG_TOP_CTL1) &
+           DA7281_TOP_CTL1_OP_MODE_MASK;
+}
+
+/* Test 4: read-only, write-1-to-clear and reserved registers */
+static void test_register_semantics(void)
+{
+    printf("\n=== Test 4: Register semantics ===\n");
+    da7281_bus_host_reset();
+
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x48};
+    uint8_t value;
+    assert(da7281_init(&device) == DA7281_OK);
+
+    /* Read-only: acknowledged, dropped */
+    assert(da7281_write_register(&device, DA7281_REG_CHIP_REV, 0x00) == DA7281_OK);
+    assert(da7281_read_register(&device, DA7281_REG_CHIP_REV, &value) == DA7281_OK);
+    assert(value == DA7281_CHIP_REV_VALUE);
+
+    /* A live condition shows in IRQ_STATUS1 and latches IRQ_EVENT1 */
+    da7281_sim_set_condition(0, device.i2c_address, DA7281_IRQ_EVENT1_E_WARNING, true);
+    da7281_status_block_t status;
+    assert(da7281_read_status_block(&device, &status) == DA7281_OK);
+    assert(status.irq_event1 == DA7281_IRQ_EVENT1_E_WARNING);
+    assert(status.irq_status1 == DA7281_IRQ_EVENT1_E_WARNING);
+
+    /* Write 1 to clear: only the written bits, the status stays */
+    da7281_sim_set_condition(0, device.i2c_address, DA7281_IRQ_EVENT1_E_UVLO, true);
+    assert(da7281_write_register(&device, DA7281_REG_IRQ_EVENT1, DA7281_IRQ_EVENT1_E_WARNING) == DA7281_OK);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_IRQ_EVENT1) == DA7281_IRQ_EVENT1_E_UVLO);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_IRQ_STATUS1) ==
+           (DA7281_IRQ_EVENT1_E_WARNING | DA7281_IRQ_EVENT1_E_UVLO));
+    da7281_sim_set_condition(0, device.i2c_address, DA7281_IRQ_EVENT1_E_WARNING | DA7281_IRQ_EVENT1_E_UVLO, false);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_IRQ_STATUS1) == 0U);
+
+    /* Reserved address */
+    assert(da7281_write_register(&device, 0x01U, 0x55) == DA7281_OK);
+    assert(da7281_read_register(&device, 0x01U, &value) == DA7281_OK);
+    assert(value == 0U);
+
+    printf("✅ PASS: Read-only, W1C and reserved registers behave like the chip\n");
+}
+
+/* Test 5: TOP_CTL1 transitions, sequencer timing and nIRQ */
+static void test_modes_and_irq(void)
+{
+    printf("\n=== Test 5: Mode transitions and nIRQ ===\n");
+    da7281_bus_host_reset();
+    memset(&s_nirq, 0, sizeof(s_nirq));
+    da7281_sim_set_irq_handler(nirq_edge);
+
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x49};
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    assert(da7281_init(&device) == DA7281_OK);
+
+    /* Active mode without actuator settings: refused, fault raised */
+    assert(da7281_set_operation_mode(&device, DA7281_MODE_DRO) == DA7281_OK);
+    assert(sim_mode(&device) == DA7281_OP_MODE_INACTIVE);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_IRQ_EVENT1) == DA7281_IRQ_EVENT1_E_ACTUATOR_FAULT);
+    assert(s_nirq.asserted && (s_nirq.edges == 1U));
+    assert(da7281_write_register(&device, DA7281_REG_IRQ_EVENT1, 0xFF) == DA7281_OK);
+    assert(!s_nirq.asserted && (s_nirq.edges == 2U));
+
+    /* Reserved OP_MODE code: ignored */
+    assert(da7281_configure_lra(&device, &s_lra_config) == DA7281_OK);
+    assert(da7281_set_operation_mode(&device, DA7281_MODE_ETWM) == DA7281_OK);
+    assert(da7281_modify_register(&device, DA7281_REG_TOP_CTL1, DA7281_TOP_CTL1_OP_MODE_MASK, 0x05) == DA7281_OK);
+    assert(sim_mode(&device) == DA7281_OP_MODE_ETWM);
+
+    /* SEQ_START plays for the sequence duration, then self-clears */
+    da7281_sim_set_seq_duration(0, device.i2c_address, 5000U);
+    assert(da7281_modify_register(&device, DA7281_REG_TOP_CTL1, DA7281_TOP_CTL1_SEQ_START,
+                                  DA7281_TOP_CTL1_SEQ_START) == DA7281_OK);
+    ops->delay(4);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_TOP_CTL1) & DA7281_TOP_CTL1_SEQ_START);
+    assert(!s_nirq.asserted);
+    ops->delay(2);
+    assert((da7281_sim_peek(0, device.i2c_address, DA7281_REG_TOP_CTL1) & DA7281_TOP_CTL1_SEQ_START) == 0U);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_IRQ_EVENT1) == DA7281_IRQ_EVENT1_E_SEQ_DONE);
+    assert(s_nirq.asserted && (s_nirq.edges == 3U));
+
+    /* IRQ_MASK1 releases nIRQ, the event stays latched */
+    assert(da7281_write_register(&device, DA7281_REG_IRQ_MASK1, DA7281_IRQ_EVENT1_E_SEQ_DONE) == DA7281_OK);
+    assert(!s_nirq.asserted && (s_nirq.edges == 4U));
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_IRQ_EVENT1) == DA7281_IRQ_EVENT1_E_SEQ_DONE);
+
+    /* SEQ_START outside RTWM/ETWM is a sequence fault */
+    assert(da7281_set_operation_mode(&device, DA7281_MODE_DRO) == DA7281_OK);
+    assert(da7281_modify_register(&device, DA7281_REG_TOP_CTL1, DA7281_TOP_CTL1_SEQ_START,
+                                  DA7281_TOP_CTL1_SEQ_START) == DA7281_OK);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_TOP_CTL1) == DA7281_OP_MODE_DRO);
+    assert(da7281_sim_peek(0, device.i2c_address, DA7281_REG_IRQ_EVENT1) & DA7281_IRQ_EVENT1_E_SEQ_FAULT);
+
+    /* Over-current forces INACTIVE */
+    da7281_sim_set_condition(0, device.i2c_address, DA7281_IRQ_EVENT1_E_OC_FAULT, true);
+    assert(sim_mode(&device) == DA7281_OP_MODE_INACTIVE);
+    assert(da7281_sim_nirq(0, device.i2c_address));
+
+    da7281_sim_set_irq_handler(NULL);
+    printf("✅ PASS: Mode rules, sequencer timing and nIRQ edges modelled\n");
+}
+
+/* Test 6: latency of API calls on four devices across both buses */
+static void test_latency_prediction(void)
+{
+    printf("\n=== Test 6: Latency on 4 devices / 2 buses ===\n");
+    da7281_bus_host_reset();
+
+    assert(da7281_i2c_configure_pins(1, 6, 7) == DA7281_OK);
+    assert(da7281_bus_init(1) == DA7281_OK);
+
+    da7281_device_t dev[4] = {
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x48},
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x49},
+        {.twi_instance = 1, .i2c_address = DA7281_I2C_ADDR_0x4A},
+        {.twi_instance = 1, .i2c_address = DA7281_I2C_ADDR_0x4B}
+    };
+    da7281_device_t *all[4] = {&dev[0], &dev[1], &dev[2], &dev[3]};
+    const uint8_t amps[4] = {0x20, 0x40, 0x60, 0x80};
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    da7281_bus_host_stats_t stats;
+    uint32_t t0;
+
+    t0 = ops->now();
+    for (uint8_t i = 0; i < 4U; i++) {
+        assert(da7281_init(&dev[i]) == DA7281_OK);
+        assert(da7281_configure_lra(&dev[i], &s_lra_config) == DA7281_OK);
+        assert(da7281_set_operation_mode(&dev[i], DA7281_MODE_DRO) == DA7281_OK);
+    }
+    printf("  bring-up (init + LRA + DRO) x4: %u us\n", (unsigned)(ops->now() - t0));
+    for (uint8_t i = 0; i < 4U; i++) {
+        assert(sim_mode(&dev[i]) == DA7281_OP_MODE_DRO);
+    }
+
+    /* One amplitude write: START, address, register, value, STOP = 29 clocks */
+    da7281_bus_host_clear_stats();
+    t0 = ops->now();
+    assert(da7281_set_override_amplitude(&dev[2], 0x7F) == DA7281_OK);
+    uint32_t single_us = ops->now() - t0;
+    da7281_bus_host_stats(&stats);
+    assert(stats.bits == 29U);
+    assert((single_us >= 72U) && (single_us <= 73U));
+    printf("  set_override_amplitude:         %u us  (%.0f updates/s per bus)\n",
+           (unsigned)single_us, 1e6 / bus_time_us(&stats));
+
+    da7281_bus_host_clear_stats();
+    t0 = ops->now();
+    assert(da7281_set_override_amplitude_multi(all, amps, 4U) == DA7281_OK);
+    uint32_t multi_us = ops->now() - t0;
+    da7281_bus_host_stats(&stats);
+    print_stats("set_override_amplitude_multi:", &stats);
+    assert((stats.transactions == 2U) && (stats.address_phases == 4U));
+    printf("  set_override_amplitude_multi x4: %u us (host clocks the buses back to back)\n", (unsigned)multi_us);
+    for (uint8_t i = 0; i < 4U; i++) {
+        assert(da7281_sim_peek(dev[i].twi_instance, dev[i].i2c_address, DA7281_REG_TOP_CTL2) == amps[i]);
+    }
+
+    printf("✅ PASS: Latency of API sequences predicted in virtual time\n");
+}
+
+/* Test 7: per-bus and per-device transfer statistics */
+static void test_stats(void)
+{
+    printf("\n=== Test 7: Transfer statistics ===\n");
+    da7281_bus_host_reset();
+
+    da7281_device_t dev[2] = {
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x48},
+        {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x49}
+    };
+    assert(da7281_init(&dev[0]) == DA7281_OK);
+    assert(da7281_init(&dev[1]) == DA7281_OK);
+    assert(da7281_stats_get(NULL) == DA7281_ERROR_NULL_POINTER);
+
+    da7281_stats_t stats;
+    da7281_stats_reset();
+    assert(da7281_stats_get(&stats) == DA7281_OK);
+    assert((stats.bus[0].transactions == 0U) && (stats.device[0][0].transactions == 0U));
+
+    /* 10 amplitude writes: 29 clocks = 72.5 us each, log2 bucket 7 (64..127 us) */
+    for (uint8_t i = 0; i < 10U; i++) {
+        assert(da7281_set_override_amplitude(&dev[0], i) == DA7281_OK);
+    }
+    /* Status block: 66 clocks = 165 us, bucket 8 (128..255 us) */
+    da7281_status_block_t status;
+    assert(da7281_read_status_block(&dev[1], &status) == DA7281_OK);
+    /* NACKed read */
+    uint8_t value;
+    da7281_sim_set_present(0, dev[1].i2c_address, false);
+    assert(da7281_read_register(&dev[1], DA7281_REG_CHIP_REV, &value) == DA7281_ERROR_I2C_READ);
+    da7281_sim_set_present(0, dev[1].i2c_address, true);
+
+    assert(da7281_stats_get(&stats) == DA7281_OK);
+    const da7281_stats_counters_t *d0 = &stats.device[0][0];
+    const da7281_stats_counters_t *d1 = &stats.device[0][1];
+    const da7281_stats_counters_t *b0 = &stats.bus[0];
+    printf("  0x48: frames=%u bytes=%u errors=%u xfer=%u us\n",
+           (unsigned)d0->transactions, (unsigned)d0->bytes, (unsigned)d0->errors, (unsigned)d0->xfer_us);
+    printf("  0x49: frames=%u bytes=%u errors=%u xfer=%u us\n",
+           (unsigned)d1->transactions, (unsigned)d1->bytes, (unsigned)d1->errors, (unsigned)d1->xfer_us);
+    printf("  sizeof(da7281_stats_t) = %u bytes\n", (unsigned)sizeof(da7281_stats_t));
+
+    assert((d0->transactions == 10U) && (d0->bytes == 20U) && (d0->errors == 0U));
+    assert((d0->xfer_us >= 720U) && (d0->xfer_us <= 730U));
+    assert(d0->xfer_hist[7] == 10U);
+    assert((d1->transactions == 2U) && (d1->bytes == 7U) && (d1->errors == 1U));
+    assert(d1->xfer_hist[8] == 1U);
+
+    /* Bus = sum of its devices; the host lock never waits */
+    assert(b0->transactions == (d0->transactions + d1->transactions));
+    assert(b0->bytes == (d0->bytes + d1->bytes));
+    assert(b0->errors == 1U);
+    assert((b0->lock_wait_hist[0] == 12U) && (b0->lock_wait_us == 0U) && (b0->lock_timeouts == 0U));
+    assert(stats.bus[1].transactions == 0U);
+
+    /* Chained multi-write: one lock for the bus, one frame per device */
+    da7281_device_t *pair[2] = {&dev[0], &dev[1]};
+    const uint8_t amps[2] = {0x10, 0x20};
+    assert(da7281_set_override_amplitude_multi(pair, amps, 2U) == DA7281_OK);
+    assert(da7281_stats_get(&stats) == DA7281_OK);
+    assert((stats.device[0][0].transactions == 11U) && (stats.device[0][1].transactions == 3U));
+    assert(stats.bus[0].lock_wait_hist[0] == 13U);
+    assert(stats.device[0][0].lock_wait_hist[0] == 10U);
+
+    da7281_stats_reset();
+    assert(da7281_stats_get(&stats) == DA7281_OK);
+    assert((stats.bus[0].transactions == 0U) && (stats.device[0][0].xfer_hist[7] == 0U));
+
+    printf("✅ PASS: Counters and log2 histograms per bus and device\n");
+}
+
+/* Test 8: waveform memory upload, lock handling and CRC readback */
+static void test_snp_upload(void)
+{
+    printf("\n=== Test 8: SNP waveform memory upload ===\n");
+    da7281_bus_host_reset();
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4A, .cache = &cache};
+    const uint8_t addr = device.i2c_address;
+    assert(da7281_init(&device) == DA7281_OK);
+    assert(da7281_configure_lra(&device, &s_lra_config) == DA7281_OK);
+
+    /* Reference value of CRC-16/CCITT-FALSE */
+    assert(da7281_snp_crc((const uint8_t *)"123456789", 9U) == 0x29B1U);
+
+    uint8_t image[DA7281_SNP_MEM_SIZE];
+    for (uint8_t i = 0; i < DA7281_SNP_MEM_SIZE; i++) {
+        image[i] = (uint8_t)((i * 37U) + 1U);
+    }
+
+    /* The memory is locked out of reset */
+    assert(da7281_write_burst(&device, DA7281_REG_SNP_MEM_BASE, image, 4U) == DA7281_OK);
+    assert(da7281_sim_peek(0, addr, DA7281_REG_SNP_MEM_BASE) == 0U);
+    assert(da7281_cache_invalidate(&device) == DA7281_OK);
+
+    /* Upload while playing: stop, unlock, one burst, relock, one readback */
+    assert(da7281_play_dro(&device, 0x40U) == DA7281_OK);
+    da7281_bus_host_stats_t stats;
+    da7281_bus_host_clear_stats();
+    assert(da7281_snp_upload(&device, image, DA7281_SNP_MEM_SIZE) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    print_stats("upload 100 (playing):", &stats);
+    assert(stats.lock_takes == 1U);
+    assert(sim_mode(&device) == DA7281_OP_MODE_INACTIVE);
+    assert(device.mode == DA7281_MODE_INACTIVE);
+    for (uint8_t i = 0; i < DA7281_SNP_MEM_SIZE; i++) {
+        assert(da7281_sim_peek(0, addr, (uint8_t)(DA7281_REG_SNP_MEM_BASE + i)) == image[i]);
+    }
+    assert(da7281_sim_peek(0, addr, DA7281_REG_MEM_CTL1) == DA7281_REG_SNP_MEM_BASE);
+    assert((da7281_sim_peek(0, addr, DA7281_REG_MEM_CTL2) & DA7281_MEM_CTL2_WAV_MEM_LOCK) == 0U);
+
+    /* Warm cache: unlock, data, relock, readback */
+    image[0] ^= 0xFFU;
+    da7281_bus_host_clear_stats();
+    assert(da7281_snp_upload(&device, image, DA7281_SNP_MEM_SIZE) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    print_stats("upload 100 (warm cache):", &stats);
+    assert((stats.transactions == 4U) && (stats.lock_takes == 1U));
+    assert((stats.bytes == (2U + (1U + DA7281_SNP_MEM_SIZE) + 2U + (1U + DA7281_SNP_MEM_SIZE))));
+
+    /* A short image leaves the rest of the window alone */
+    const uint8_t head[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    assert(da7281_snp_upload(&device, head, sizeof(head)) == DA7281_OK);
+    assert(da7281_sim_peek(0, addr, DA7281_REG_SNP_MEM_BASE + 7U) == 8U);
+    assert(da7281_sim_peek(0, addr, DA7281_REG_SNP_MEM_BASE + 8U) == image[8]);
+
+    /* Verify against a stored CRC: one burst read; a flipped bit is caught */
+    memcpy(image, head, sizeof(head));
+    const uint16_t crc = da7281_snp_crc(image, DA7281_SNP_MEM_SIZE);
+    da7281_bus_host_clear_stats();
+    assert(da7281_snp_verify(&device, DA7281_SNP_MEM_SIZE, crc) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    assert((stats.transactions == 1U) && (stats.bytes == (1U + DA7281_SNP_MEM_SIZE)));
+    da7281_sim_poke(0, addr, DA7281_REG_SNP_MEM_BASE + 50U, (uint8_t)(image[50] ^ 0x10U));
+    assert(da7281_snp_verify(&device, DA7281_SNP_MEM_SIZE, crc) == DA7281_ERROR_VERIFY_FAILED);
+
+    /* Stale cache claims the memory is unlocked: writes dropped, CRC catches it */
+    cache.value[DA7281_REG_MEM_CTL2] |= DA7281_MEM_CTL2_WAV_MEM_LOCK;
+    assert(da7281_snp_upload(&device, image, DA7281_SNP_MEM_SIZE) == DA7281_ERROR_VERIFY_FAILED);
+    uint8_t value = 0;
+    da7281_bus_host_clear_stats();
+    assert(da7281_read_register_cached(&device, DA7281_REG_MEM_CTL2, &value) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    assert(stats.transactions == 1U);  /* Cache was invalidated */
+    assert(da7281_snp_upload(&device, image, DA7281_SNP_MEM_SIZE) == DA7281_OK);
+
+    /* Parameter checks */
+    assert(da7281_snp_upload(&device, image, 0U) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_snp_upload(&device, image, DA7281_SNP_MEM_SIZE + 1U) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_snp_upload(&device, NULL, 1U) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_snp_verify(NULL, 1U, 0U) == DA7281_ERROR_NULL_POINTER);
+
+    printf("✅ PASS: Window written in one burst, lock restored, CRC readback catches corruption\n");
+}
+
+/* Test 9: ETWM sequence started in one frame, completed by SEQ_DONE */
+static void test_play_sequence(void)
+{
+    printf("\n=== Test 9: Sequence playback with SEQ_DONE completion ===\n");
+    da7281_bus_host_reset();
+    memset(&s_nirq, 0, sizeof(s_nirq));
+    memset(&s_async, 0, sizeof(s_async));
+    da7281_sim_set_irq_handler(nirq_edge);
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4B, .cache = &cache};
+    const uint8_t addr = device.i2c_address;
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    da7281_bus_host_stats_t stats;
+    assert(da7281_init(&device) == DA7281_OK);
+    assert(da7281_configure_lra(&device, &s_lra_config) == DA7281_OK);
+    device.verify = DA7281_VERIFY_NEVER;
+
+    /* 125 ms sequence, 3 repeats: a 500 ms effect */
+    da7281_sim_set_seq_duration(0, addr, 125000U);
+    da7281_bus_host_clear_stats();
+    assert(da7281_play_sequence(&device, 2U, 3U, async_done, NULL) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    print_stats("play_sequence (cold):", &stats);
+    assert(sim_mode(&device) == DA7281_OP_MODE_ETWM);
+    assert(da7281_sim_peek(0, addr, DA7281_REG_SEQ_CTL2) == 0x32U);
+    assert(device.seq_pending && (device.mode == DA7281_MODE_ETWM));
+    assert(da7281_play_sequence(&device, 2U, 3U, async_done, NULL) == DA7281_ERROR_BUSY);
+
+    ops->delay(499);
+    assert(!s_nirq.asserted && (s_async.calls == 0U));
+    ops->delay(2);
+    assert(s_nirq.asserted);
+    da7281_status_block_t status;
+    da7281_bus_host_clear_stats();
+    assert(da7281_handle_events(&device, &status) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    print_stats("handle_events (SEQ_DONE):", &stats);
+    assert((stats.transactions == 2U) && (stats.lock_takes == 1U));
+    assert(status.irq_event1 == DA7281_IRQ_EVENT1_E_SEQ_DONE);
+    assert(!s_nirq.asserted && !device.seq_pending);
+    assert((s_async.calls == 1U) && (s_async.result == DA7281_OK));
+
+    /* Replay from a warm cache: one frame to start, two to finish */
+    da7281_bus_host_clear_stats();
+    assert(da7281_play_sequence(&device, 2U, 3U, async_done, NULL) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    print_stats("play_sequence (warm):", &stats);
+    assert(stats.transactions == 1U);
+    ops->delay(501);
+    assert(da7281_handle_events(&device, NULL) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    printf("  500 ms effect: %u frames, %.1f us of bus time\n", stats.transactions, bus_time_us(&stats));
+    assert((stats.transactions == 3U) && (s_async.calls == 2U));
+
+    /* Nothing latched: one read, no clear */
+    da7281_bus_host_clear_stats();
+    assert(da7281_handle_events(&device, NULL) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    assert((stats.transactions == 1U) && (s_async.calls == 2U));
+
+    /* da7281_stop() aborts a pending sequence */
+    assert(da7281_play_sequence(&device, 5U, 0U, async_done, NULL) == DA7281_OK);
+    ops->delay(10);
+    assert(da7281_stop(&device) == DA7281_OK);
+    assert((s_async.calls == 3U) && (s_async.result == DA7281_ERROR_ABORTED));
+    assert(sim_mode(&device) == DA7281_OP_MODE_INACTIVE);
+    ops->delay(200);
+    assert(!s_nirq.asserted);
+
+    /* A device fault ends the sequence with DA7281_ERROR_ABORTED */
+    assert(da7281_play_sequence(&device, 5U, 0U, async_done, NULL) == DA7281_OK);
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_OVERTEMP_CRIT, true);
+    assert(da7281_handle_events(&device, NULL) == DA7281_OK);
+    assert((s_async.calls == 4U) && (s_async.result == DA7281_ERROR_ABORTED) && !device.seq_pending);
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_OVERTEMP_CRIT, false);
+
+    /* Any other way out of ETWM aborts too, and a queued playlist does not chain later */
+    assert(da7281_play_sequence(&device, 5U, 0U, async_done, NULL) == DA7281_OK);
+    assert(da7281_queue_sequence(&device, 6U, 0U) == DA7281_OK);
+    assert((da7281_sim_peek(0, addr, DA7281_REG_SEQ_CTL1) & DA7281_SEQ_CTL1_SEQ_CONTINUE) != 0U);
+    assert(da7281_play_dro(&device, 0x40U) == DA7281_OK);
+    assert((s_async.calls == 5U) && (s_async.result == DA7281_ERROR_ABORTED) && !device.seq_pending);
+    assert((device.playlist_count == 0U) &&
+           ((da7281_sim_peek(0, addr, DA7281_REG_SEQ_CTL1) & DA7281_SEQ_CTL1_SEQ_CONTINUE) == 0U));
+    assert(da7281_play_sequence(&device, 5U, 0U, async_done, NULL) == DA7281_OK);
+    assert(da7281_set_operation_mode(&device, DA7281_MODE_INACTIVE) == DA7281_OK);
+    assert((s_async.calls == 6U) && (s_async.result == DA7281_ERROR_ABORTED));
+    static const uint8_t image[4] = {0x01U, 0x02U, 0x03U, 0x04U};
+    assert(da7281_play_sequence(&device, 5U, 0U, async_done, NULL) == DA7281_OK);
+    assert(da7281_snp_upload(&device, image, sizeof(image)) == DA7281_OK);
+    assert((s_async.calls == 7U) && (s_async.result == DA7281_ERROR_ABORTED));
+    assert(da7281_play_sequence(&device, 5U, 0U, async_done, NULL) == DA7281_OK);
+    assert(da7281_stop(&device) == DA7281_OK);
+    assert((s_async.calls == 8U) && !device.seq_pending);
+    ops->delay(200);
+    assert(!s_nirq.asserted && (s_async.calls == 8U));
+
+    /* Parameter checks */
+    assert(da7281_play_sequence(&device, 16U, 0U, NULL, NULL) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_play_sequence(&device, 0U, 16U, NULL, NULL) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_play_sequence(NULL, 0U, 0U, NULL, NULL) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_handle_events(NULL, NULL) == DA7281_ERROR_NULL_POINTER);
+
+    da7281_sim_set_irq_handler(NULL);
+    printf("✅ PASS: 500 ms effect in 3 frames, completion by SEQ_DONE, aborts reported\n");
+}
+
+/* Run virtual time in 1 ms steps, servicing nIRQ, until the sequence completes */
+static unsigned service_until_done(da7281_device_t *device, uint32_t limit_ms)
+{
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    unsigned services = 0;
+    for (uint32_t ms = 0; device->seq_pending && (ms < limit_ms); ms++) {
+        ops->delay(1);
+        if (s_nirq.asserted) {
+            assert(da7281_handle_events(device, NULL) == DA7281_OK);
+            services++;
+        }
+    }
+    assert(!device->seq_pending);
+    return services;
+}
+
+/* Test 10: playlist chained on E_SEQ_CONTINUE vs re-triggering on SEQ_DONE */
+static void test_playlist_gap(void)
+{
+    printf("\n=== Test 10: Gapless playlist (SEQ_CONTINUE) ===\n");
+    da7281_bus_host_reset();
+    memset(&s_nirq, 0, sizeof(s_nirq));
+    memset(&s_async, 0, sizeof(s_async));
+    da7281_sim_set_irq_handler(nirq_edge);
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x48, .cache = &cache};
+    const uint8_t addr = device.i2c_address;
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    da7281_bus_host_stats_t stats;
+    assert(da7281_init(&device) == DA7281_OK);
+    assert(da7281_configure_lra(&device, &s_lra_config) == DA7281_OK);
+    device.verify = DA7281_VERIFY_NEVER;
+    da7281_sim_set_seq_duration(0, addr, 20000U);
+
+    /* Host re-trigger: wait for SEQ_DONE, then start the next segment */
+    uint32_t retrigger_gap_max = 0U;
+    uint32_t segments = da7281_sim_seq_segments(0, addr);
+    for (uint8_t id = 1U; id <= 4U; id++) {
+        assert(da7281_play_sequence(&device, id, 0U, async_done, NULL) == DA7281_OK);
+        uint32_t gap = da7281_sim_seq_gap_us(0, addr);
+        retrigger_gap_max = (gap > retrigger_gap_max) ? gap : retrigger_gap_max;
+        (void)service_until_done(&device, 100U);
+    }
+    assert(da7281_sim_seq_segments(0, addr) == (segments + 4U));
+    printf("  re-trigger on SEQ_DONE:   worst gap %u us\n", (unsigned)retrigger_gap_max);
+    assert(retrigger_gap_max > 0U);
+
+    /* Playlist: 4 segments, each armed while the previous one plays */
+    memset(&s_async, 0, sizeof(s_async));
+    segments = da7281_sim_seq_segments(0, addr);
+    assert(da7281_queue_sequence(&device, 2U, 0U) == DA7281_OK);
+    assert(da7281_queue_sequence(&device, 3U, 1U) == DA7281_OK);
+    assert(da7281_queue_sequence(&device, 4U, 0U) == DA7281_OK);
+    da7281_bus_host_clear_stats();
+    assert(da7281_play_sequence(&device, 1U, 0U, async_done, NULL) == DA7281_OK);
+
+    const uint8_t armed[] = {0x02U, 0x13U, 0x04U};
+    uint32_t playlist_gap_max = 0U;
+    unsigned services = 0U;
+    for (uint32_t ms = 0; device.seq_pending && (ms < 200U); ms++) {
+        ops->delay(1);
+        if (s_nirq.asserted) {
+            assert(da7281_handle_events(&device, NULL) == DA7281_OK);
+            if (da7281_sim_seq_segments(0, addr) > (segments + 1U)) {
+                uint32_t gap = da7281_sim_seq_gap_us(0, addr);  /* Chained segment */
+                playlist_gap_max = (gap > playlist_gap_max) ? gap : playlist_gap_max;
+            }
+            if (services < sizeof(armed)) {
+                assert(da7281_sim_peek(0, addr, DA7281_REG_SEQ_CTL2) == armed[services]);
+            }
+            services++;
+        }
+    }
+    da7281_bus_host_stats(&stats);
+    print_stats("playlist (4 segments):", &stats);
+    printf("  chained on SEQ_CONTINUE:  worst gap %u us, %u services\n", (unsigned)playlist_gap_max, services);
+    assert(!device.seq_pending && (s_async.calls == 1U) && (s_async.result == DA7281_OK));
+    assert(da7281_sim_seq_segments(0, addr) == (segments + 4U));
+    assert(playlist_gap_max == 0U);
+    /* 4 CONTINUE services (3 arm + 1 disarm) of 3 frames and one SEQ_DONE of 2 */
+    assert(services == 5U);
+    assert((da7281_sim_peek(0, addr, DA7281_REG_SEQ_CTL1) & DA7281_SEQ_CTL1_SEQ_CONTINUE) == 0U);
+
+    /* Queued while the last segment plays: armed at once, still gapless */
+    memset(&s_async, 0, sizeof(s_async));
+    assert(da7281_play_sequence(&device, 1U, 0U, async_done, NULL) == DA7281_OK);
+    ops->delay(5);
+    da7281_bus_host_clear_stats();
+    assert(da7281_queue_sequence(&device, 2U, 0U) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    assert(stats.transactions == 2U);
+    (void)service_until_done(&device, 100U);
+    assert((s_async.calls == 1U) && (da7281_sim_seq_gap_us(0, addr) == 0U));
+
+    /* Queued after the end but before SEQ_DONE was serviced: restarted, not lost */
+    memset(&s_async, 0, sizeof(s_async));
+    segments = da7281_sim_seq_segments(0, addr);
+    assert(da7281_play_sequence(&device, 1U, 0U, async_done, NULL) == DA7281_OK);
+    ops->delay(21);
+    assert(da7281_queue_sequence(&device, 2U, 0U) == DA7281_OK);
+    (void)service_until_done(&device, 100U);
+    assert((s_async.calls == 1U) && (s_async.result == DA7281_OK));
+    assert(da7281_sim_seq_segments(0, addr) == (segments + 2U));
+
+    /* Stop drops the queue */
+    assert(da7281_queue_sequence(&device, 2U, 0U) == DA7281_OK);
+    assert(da7281_queue_sequence(&device, 3U, 0U) == DA7281_OK);
+    assert(da7281_play_sequence(&device, 1U, 0U, async_done, NULL) == DA7281_OK);
+    assert(da7281_stop(&device) == DA7281_OK);
+    assert((device.playlist_count == 0U) && (s_async.result == DA7281_ERROR_ABORTED));
+
+    /* Full queue */
+    for (uint8_t n = 0; n < DA7281_PLAYLIST_DEPTH; n++) {
+        assert(da7281_queue_sequence(&device, n, 0U) == DA7281_OK);
+    }
+    assert(da7281_queue_sequence(&device, 0U, 0U) == DA7281_ERROR_BUSY);
+    assert(da7281_queue_sequence(&device, 16U, 0U) == DA7281_ERROR_INVALID_PARAM);
+
+    da7281_sim_set_irq_handler(NULL);
+    printf("✅ PASS: Segments chained on the same edge; host re-trigger leaves a gap\n");
+}
+
+static struct {
+    unsigned calls;
+    da7281_event_t events[16];
+    da7281_device_t *devices[16];
+    uint32_t edge_us;           /* now() when nIRQ last asserted */
+    uint32_t handler_us;        /* now() at the last handler call */
+    bool inject;                /* Raise a warning from the next handler call */
+} s_irq;
+
+static void nirq_edge_timed(uint8_t instance, uint8_t address, bool asserted)
+{
+    nirq_edge(instance, address, asserted);
+    if (asserted) {
+        s_irq.edge_us = da7281_bus_get_ops()->now();
+    }
+}
+
+static void irq_event(da7281_device_t *device, da7281_event_t event,
+                      const da7281_status_block_t *status, void *context)
+{
+    assert(context == &s_irq);
+    assert((status->irq_event1 & (uint8_t)event) != 0U);
+    if (s_irq.calls < 16U) {
+        s_irq.events[s_irq.calls] = event;
+        s_irq.devices[s_irq.calls] = device;
+    }
+    s_irq.calls++;
+    s_irq.handler_us = da7281_bus_get_ops()->now();
+}
+
+/* Test 11: nIRQ edge -> interrupt task -> one burst read + clear -> typed handlers */
+static void test_irq_dispatch(void)
+{
+    printf("\n=== Test 11: nIRQ interrupt and typed event dispatch ===\n");
+    da7281_bus_host_reset();
+    memset(&s_nirq, 0, sizeof(s_nirq));
+    memset(&s_async, 0, sizeof(s_async));
+    memset(&s_irq, 0, sizeof(s_irq));
+    da7281_sim_set_irq_handler(nirq_edge_timed);
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x49, .cache = &cache};
+    const uint8_t addr = device.i2c_address;
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    da7281_bus_host_stats_t stats;
+    assert(da7281_init(&device) == DA7281_OK);
+    assert(da7281_configure_lra(&device, &s_lra_config) == DA7281_OK);
+    device.verify = DA7281_VERIFY_NEVER;
+    da7281_bus_host_wire_irq(0, addr, 7U);
+
+    /* A pin the backend cannot arm leaves the device detached */
+    assert(da7281_irq_configure(&device, DA7281_BUS_HOST_PINS, irq_event, &s_irq) == DA7281_ERROR_INVALID_PARAM);
+    assert(device.irq_handler == NULL);
+    assert(da7281_irq_configure(&device, 7U, irq_event, &s_irq) == DA7281_OK);
+
+    /* SEQ_DONE: no polling, the handler runs at edge + bus time */
+    da7281_sim_set_seq_duration(0, addr, 20000U);
+    assert(da7281_play_sequence(&device, 1U, 0U, async_done, NULL) == DA7281_OK);
+    da7281_bus_host_clear_stats();
+    ops->delay(25);
+    da7281_bus_host_stats(&stats);
+    uint32_t latency_us = s_irq.handler_us - s_irq.edge_us;
+    print_stats("nIRQ service (SEQ_DONE):", &stats);
+    printf("  edge to handler: %u us (bus time %.1f us)\n", (unsigned)latency_us, bus_time_us(&stats));
+    assert((s_irq.calls == 1U) && (s_irq.events[0] == DA7281_EVENT_SEQ_DONE) && (s_irq.devices[0] == &device));
+    assert((s_async.calls == 1U) && (s_async.result == DA7281_OK) && !device.seq_pending);
+    assert((stats.transactions == 2U) && (stats.lock_takes == 1U));
+    assert(((double)latency_us > (bus_time_us(&stats) - 1.0)) && ((double)latency_us < (bus_time_us(&stats) + 1.0)));
+    assert(!da7281_sim_nirq(0, addr));
+
+    /* Several events in one service, faults first */
+    memset(&s_irq, 0, sizeof(s_irq));
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_WARNING | DA7281_IRQ_EVENT1_E_UVLO |
+                             DA7281_IRQ_EVENT1_E_OC_FAULT | DA7281_IRQ_EVENT1_E_OVERTEMP_CRIT |
+                             DA7281_IRQ_EVENT1_E_ACTUATOR_FAULT, true);
+    ops->delay(1);
+    const da7281_event_t order[] = {DA7281_EVENT_OC_FAULT, DA7281_EVENT_ACTUATOR_FAULT, DA7281_EVENT_OVERTEMP,
+                                    DA7281_EVENT_UVLO, DA7281_EVENT_WARNING};
+    assert(s_irq.calls == 5U);
+    for (uint8_t i = 0; i < 5U; i++) {
+        assert(s_irq.events[i] == order[i]);
+    }
+    da7281_sim_set_condition(0, addr, 0xFFU, false);
+    assert(da7281_configure_lra(&device, &s_lra_config) == DA7281_OK);
+
+    /* SEQ_DONE latches between the read and the clear: nIRQ stays low, no new edge */
+    memset(&s_irq, 0, sizeof(s_irq));
+    memset(&s_async, 0, sizeof(s_async));
+    da7281_sim_set_seq_duration(0, addr, 5120U);
+    assert(da7281_play_sequence(&device, 2U, 0U, async_done, NULL) == DA7281_OK);
+    ops->delay(5);
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_WARNING, true);
+    unsigned edges = s_nirq.edges;
+    da7281_bus_host_clear_stats();
+    ops->delay(1);
+    da7281_bus_host_stats(&stats);
+    assert(s_nirq.edges == (edges + 1U));
+    assert((s_irq.calls == 2U) && (s_irq.events[0] == DA7281_EVENT_WARNING) &&
+           (s_irq.events[1] == DA7281_EVENT_SEQ_DONE));
+    assert((s_async.calls == 1U) && !da7281_sim_nirq(0, addr));
+    assert(stats.transactions == 4U);
+    printf("  event during service: re-served without an edge (%u frames)\n", stats.transactions);
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_WARNING, false);
+
+    /* Events latched before attaching are served at once */
+    assert(da7281_irq_configure(&device, 7U, NULL, NULL) == DA7281_OK);
+    memset(&s_irq, 0, sizeof(s_irq));
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_WARNING, true);
+    ops->delay(1);
+    assert(s_irq.calls == 0U);
+    assert(da7281_irq_configure(&device, 7U, irq_event, &s_irq) == DA7281_OK);
+    ops->delay(1);
+    assert((s_irq.calls == 1U) && (s_irq.events[0] == DA7281_EVENT_WARNING));
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_WARNING, false);
+
+    /* Shared line on bus 1: DA7281_IRQ_MAX_DEVICES attached in total */
+    da7281_device_t shared[4];
+    for (uint8_t i = 0; i < 4U; i++) {
+        memset(&shared[i], 0, sizeof(shared[i]));
+        shared[i].twi_instance = 1;
+        shared[i].i2c_address = (uint8_t)(DA7281_I2C_ADDR_0x48 + i);
+        assert(da7281_init(&shared[i]) == DA7281_OK);
+        da7281_bus_host_wire_irq(1, shared[i].i2c_address, 9U);
+    }
+    for (uint8_t i = 0; i < 3U; i++) {
+        assert(da7281_irq_configure(&shared[i], 9U, irq_event, &s_irq) == DA7281_OK);
+    }
+    assert(da7281_irq_configure(&shared[3], 9U, irq_event, &s_irq) == DA7281_ERROR_BUSY);
+    memset(&s_irq, 0, sizeof(s_irq));
+    da7281_sim_set_condition(1, shared[0].i2c_address, DA7281_IRQ_EVENT1_E_UVLO, true);
+    da7281_sim_set_condition(1, shared[2].i2c_address, DA7281_IRQ_EVENT1_E_WARNING, true);
+    ops->delay(1);
+    assert((s_irq.calls == 2U) && (s_irq.devices[0] == &shared[0]) && (s_irq.devices[1] == &shared[2]));
+
+    /* Detaching the last device disarms the pin */
+    for (uint8_t i = 0; i < 3U; i++) {
+        assert(da7281_irq_configure(&shared[i], 9U, NULL, NULL) == DA7281_OK);
+    }
+    da7281_sim_set_condition(1, shared[1].i2c_address, DA7281_IRQ_EVENT1_E_UVLO, true);
+    ops->delay(1);
+    assert(s_irq.calls == 2U);
+
+    assert(da7281_deinit(&device) == DA7281_OK);
+    assert(device.irq_handler == NULL);
+    assert(da7281_irq_configure(NULL, 7U, irq_event, NULL) == DA7281_ERROR_NULL_POINTER);
+
+    da7281_sim_set_irq_handler(NULL);
+    printf("✅ PASS: Typed events from nIRQ in 2 frames; late events and shared lines served\n");
+}
+
+/* Test 12: four devices wired-OR onto one nIRQ line, two per bus */
+static struct {
+    bool armed;
+    uint8_t instance;
+    uint8_t address;
+    uint8_t target;
+} s_relay;
+
+/* Latch an event on another device the moment the watched one releases nIRQ */
+static void nirq_relay(uint8_t instance, uint8_t address, bool asserted)
+{
+    if (s_relay.armed && !asserted && (instance == s_relay.instance) && (address == s_relay.address)) {
+        s_relay.armed = false;
+        da7281_sim_set_condition(1, s_relay.target, DA7281_IRQ_EVENT1_E_WARNING, true);
+    }
+}
+
+static double bus_max_us(const da7281_bus_host_stats_t *stats)
+{
+    uint32_t bits = (stats->bus_bits[0] > stats->bus_bits[1]) ? stats->bus_bits[0] : stats->bus_bits[1];
+    return (double)bits * 2.5;
+}
+
+/* Latch E_WARNING on the listed devices, let the interrupt task serve them, release */
+static void shared_irq_assert(da7281_device_t *grid, const uint8_t *which, uint8_t count,
+                              da7281_bus_host_stats_t *stats)
+{
+    memset(&s_irq, 0, sizeof(s_irq));
+    for (uint8_t i = 0; i < count; i++) {
+        da7281_sim_set_condition(grid[which[i]].twi_instance, grid[which[i]].i2c_address,
+                                 DA7281_IRQ_EVENT1_E_WARNING, true);
+    }
+    da7281_bus_host_clear_stats();
+    da7281_bus_get_ops()->delay(1);
+    da7281_bus_host_stats(stats);
+    for (uint8_t i = 0; i < 4U; i++) {
+        da7281_sim_set_condition(grid[i].twi_instance, grid[i].i2c_address, DA7281_IRQ_EVENT1_E_WARNING, false);
+        assert(!da7281_sim_nirq(grid[i].twi_instance, grid[i].i2c_address));
+    }
+}
+
+static void test_irq_shared_line(void)
+{
+    printf("\n=== Test 12: Shared nIRQ line, 4 devices on 2 buses ===\n");
+    da7281_bus_host_reset();
+    memset(&s_irq, 0, sizeof(s_irq));
+    memset(&s_relay, 0, sizeof(s_relay));
+
+    /* grid[0..1] on TWI0, grid[2..3] on TWI1, all nIRQ outputs on GPIO 12 */
+    da7281_device_t grid[4];
+    for (uint8_t i = 0; i < 4U; i++) {
+        memset(&grid[i], 0, sizeof(grid[i]));
+        grid[i].twi_instance = i / 2U;
+        grid[i].i2c_address = (uint8_t)(DA7281_I2C_ADDR_0x48 + (i % 2U));
+        assert(da7281_init(&grid[i]) == DA7281_OK);
+        da7281_bus_host_wire_irq(grid[i].twi_instance, grid[i].i2c_address, 12U);
+    }
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    da7281_bus_host_stats_t stats;
+
+    /* One by one: what reading every device on the line costs */
+    const uint8_t one[] = {3U};
+    const uint8_t two[] = {0U, 1U};
+    const uint8_t all[] = {0U, 1U, 2U, 3U};
+    const uint8_t *const sets[] = {one, two, all};
+    const uint8_t counts[] = {1U, 2U, 4U};
+    double serial_us[3];
+    for (uint8_t s = 0; s < 3U; s++) {
+        for (uint8_t i = 0; i < counts[s]; i++) {
+            da7281_sim_set_condition(grid[sets[s][i]].twi_instance, grid[sets[s][i]].i2c_address,
+                                     DA7281_IRQ_EVENT1_E_WARNING, true);
+        }
+        da7281_bus_host_clear_stats();
+        for (uint8_t i = 0; i < 4U; i++) {
+            assert(da7281_handle_events(&grid[i], NULL) == DA7281_OK);
+        }
+        da7281_bus_host_stats(&stats);
+        serial_us[s] = bus_time_us(&stats);
+        for (uint8_t i = 0; i < 4U; i++) {
+            da7281_sim_set_condition(grid[i].twi_instance, grid[i].i2c_address, DA7281_IRQ_EVENT1_E_WARNING, false);
+        }
+    }
+
+    for (uint8_t i = 0; i < 4U; i++) {
+        assert(da7281_irq_configure(&grid[i], 12U, irq_event, &s_irq) == DA7281_OK);
+    }
+
+    printf("  asserting  frames  TWI0/TWI1 us    service (buses overlapped)  one by one\n");
+
+    /* Worst case for one device: read last on its bus (nothing active yet) */
+    shared_irq_assert(grid, one, 1U, &stats);
+    assert((s_irq.calls == 1U) && (s_irq.devices[0] == &grid[3]));
+    assert((stats.transactions == 5U) && (stats.lock_takes == 4U));
+    assert(bus_max_us(&stats) == 402.5);
+    printf("  1 (last)   %-7u %5.1f/%-5.1f     %6.1f us                   %6.1f us\n", stats.transactions,
+           stats.bus_bits[0] * 2.5, stats.bus_bits[1] * 2.5, bus_max_us(&stats), serial_us[0]);
+
+    /* Most recently active first: the same device again is found in the first round */
+    shared_irq_assert(grid, one, 1U, &stats);
+    assert((s_irq.calls == 1U) && (s_irq.devices[0] == &grid[3]));
+    assert(stats.transactions == 3U);
+    assert(bus_max_us(&stats) == 237.5);
+    printf("  1 (recent) %-7u %5.1f/%-5.1f     %6.1f us                   %6.1f us\n", stats.transactions,
+           stats.bus_bits[0] * 2.5, stats.bus_bits[1] * 2.5, bus_max_us(&stats), serial_us[0]);
+
+    /* Worst case for two: both on one bus, the other bus read for nothing */
+    shared_irq_assert(grid, two, 2U, &stats);
+    assert((s_irq.calls == 2U) && (s_irq.devices[0] == &grid[0]) && (s_irq.devices[1] == &grid[1]));
+    assert(stats.transactions == 6U);
+    assert(bus_max_us(&stats) == 475.0);
+    printf("  2          %-7u %5.1f/%-5.1f     %6.1f us                   %6.1f us\n", stats.transactions,
+           stats.bus_bits[0] * 2.5, stats.bus_bits[1] * 2.5, bus_max_us(&stats), serial_us[1]);
+
+    /* All four: two rounds, each bus reads and clears two devices */
+    shared_irq_assert(grid, all, 4U, &stats);
+    assert(s_irq.calls == 4U);
+    assert(stats.transactions == 8U);
+    assert((stats.bus_bits[0] == stats.bus_bits[1]) && (bus_max_us(&stats) == 475.0));
+    double worst_us = bus_max_us(&stats);
+    printf("  4          %-7u %5.1f/%-5.1f     %6.1f us                   %6.1f us\n", stats.transactions,
+           stats.bus_bits[0] * 2.5, stats.bus_bits[1] * 2.5, bus_max_us(&stats), serial_us[2]);
+    assert((serial_us[0] == 732.5) && (serial_us[1] == 805.0) && (serial_us[2] == 950.0));
+
+    /* Order is now grid[0], grid[2] (last round of the scan), then grid[1], grid[3].
+     * grid[3] latches as grid[0] releases the line: it stays low, no edge, the scan goes on */
+    const uint8_t first[] = {0U};
+    s_relay.armed = true;
+    s_relay.instance = 0U;
+    s_relay.address = grid[0].i2c_address;
+    s_relay.target = grid[3].i2c_address;
+    da7281_sim_set_irq_handler(nirq_relay);
+    shared_irq_assert(grid, first, 1U, &stats);
+    assert((s_irq.calls == 2U) && (s_irq.devices[0] == &grid[0]) && (s_irq.devices[1] == &grid[3]));
+    assert(stats.transactions == 6U);
+    printf("  event in a device not read yet: same scan (%u frames)\n", stats.transactions);
+
+    /* grid[2] latches as grid[1] releases the line, but was read in the same round:
+     * the line is still low after the scan, so the line is scanned again */
+    const uint8_t second[] = {1U};
+    s_relay.armed = true;
+    s_relay.address = grid[1].i2c_address;
+    s_relay.target = grid[2].i2c_address;
+    shared_irq_assert(grid, second, 1U, &stats);
+    da7281_sim_set_irq_handler(NULL);
+    assert((s_irq.calls == 2U) && (s_irq.devices[0] == &grid[1]) && (s_irq.devices[1] == &grid[2]));
+    assert(stats.transactions == 10U);
+    printf("  event in a device already read: second pass (%u frames)\n", stats.transactions);
+
+    /* A stale edge (line already released when the task runs) costs nothing */
+    da7281_bus_pin_event(12U);
+    da7281_bus_host_clear_stats();
+    ops->delay(1);
+    da7281_bus_host_stats(&stats);
+    assert(stats.transactions == 0U);
+
+    for (uint8_t i = 0; i < 4U; i++) {
+        assert(da7281_deinit(&grid[i]) == DA7281_OK);
+    }
+    printf("✅ PASS: Shared line served in %.1f us worst case (one by one: %.1f us)\n", worst_us, serial_us[2]);
+}
+
+/* Test 13: deferred readback when the flush forced by a full queue fails */
+static void test_verify_flush_nack(void)
+{
+    printf("\n=== Test 13: Deferred verification with a failed forced flush ===\n");
+    da7281_bus_host_reset();
+
+    static da7281_reg_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4A, .cache = &cache};
+    da7281_operation_mode_t mode;
+    assert(da7281_init(&device) == DA7281_OK);
+    assert(da7281_get_operation_mode(&device, &mode) == DA7281_OK);     /* TOP_CTL1 cached */
+
+    /* Fill the queue with checks of other registers, as a deeper call chain would */
+    const uint8_t regs[] = {DA7281_REG_IRQ_MASK1, DA7281_REG_TOP_CFG2, DA7281_REG_TOP_CFG3, DA7281_REG_TOP_CFG4};
+    device.verify_count = 0U;
+    for (uint8_t i = 0; i < DA7281_VERIFY_QUEUE_DEPTH; i++) {
+        device.verify_queue[i] = (da7281_write_entry_t){.reg = regs[i % sizeof(regs)], .mask = 0x00U};
+        device.verify_count++;
+    }
+
+    /* The write goes out, the readback of the full queue is NACKed */
+    da7281_bus_host_fail(0, device.i2c_address, DA7281_BUS_HOST_FAIL_READS, UINT32_MAX);
+    for (uint8_t i = 0; i < 3U; i++) {
+        da7281_operation_mode_t next = ((i % 2U) == 0U) ? DA7281_MODE_STANDBY : DA7281_MODE_INACTIVE;
+        assert(da7281_set_operation_mode_policy(&device, next, DA7281_VERIFY_DEFERRED) == DA7281_ERROR_I2C_READ);
+        assert(device.verify_count == DA7281_VERIFY_QUEUE_DEPTH);
+        assert(!device.seq_pending && (device.seq_callback == NULL));     /* Fields after the queue */
+    }
+    printf("  3 deferred writes with the readback failing: queue stays at %u entries\n",
+           (unsigned)device.verify_count);
+
+    /* Once the bus recovers, the kept checks are flushed and new ones queue again */
+    da7281_bus_host_fail(0, device.i2c_address, 0U, 0U);
+    assert(da7281_verify_flush(&device) == DA7281_OK);
+    assert(device.verify_count == 0U);
+    assert(da7281_set_operation_mode_policy(&device, DA7281_MODE_STANDBY, DA7281_VERIFY_DEFERRED) == DA7281_OK);
+    assert(device.verify_count == 1U);
+    assert(da7281_verify_flush(&device) == DA7281_OK);
+
+    assert(da7281_deinit(&device) == DA7281_OK);
+    printf("✅ PASS: Full verify queue is never overrun when its forced flush fails\n");
+}
+
+/* Test 14: a line held low by a clear that keeps failing is retried, not dropped */
+static void test_irq_stuck_line(void)
+{
+    printf("\n=== Test 14: nIRQ held low by a failing clear ===\n");
+    da7281_bus_host_reset();
+    memset(&s_nirq, 0, sizeof(s_nirq));
+    memset(&s_irq, 0, sizeof(s_irq));
+    da7281_sim_set_irq_handler(nirq_edge);
+
+    da7281_device_t device = {.twi_instance = 0, .i2c_address = DA7281_I2C_ADDR_0x4B};
+    const uint8_t addr = device.i2c_address;
+    const da7281_bus_ops_t *ops = da7281_bus_get_ops();
+    da7281_bus_host_stats_t stats;
+    assert(da7281_init(&device) == DA7281_OK);
+    device.verify = DA7281_VERIFY_NEVER;
+    da7281_bus_host_wire_irq(0, addr, 3U);
+    assert(da7281_irq_configure(&device, 3U, irq_event, &s_irq) == DA7281_OK);
+
+    /* Every W1C write is NACKed: the passes run out with the line still low */
+    da7281_bus_host_fail(0, addr, DA7281_BUS_HOST_FAIL_WRITES, UINT32_MAX);
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_WARNING, true);
+    da7281_sim_set_condition(0, addr, DA7281_IRQ_EVENT1_E_WARNING, false);
+    ops->delay(1);
+    assert(da7281_sim_nirq(0, addr));
+    unsigned edges = s_nirq.edges;
+
+    /* No further edge can arrive, yet the service keeps coming back */
+    da7281_bus_host_clear_stats();
+    ops->delay(50);
+    da7281_bus_host_stats(&stats);
+    print_stats("50 ms with the clear failing:", &stats);
+    assert(s_nirq.edges == edges);
+    assert(stats.nacks > 0U);
+    assert(stats.transactions < 100U);      /* Backed off, not spinning on the bus */
+    assert(da7281_sim_nirq(0, addr));
+
+    /* Once the clear goes through, the line is released and stays served */
+    da7281_bus_host_fail(0, addr, 0U, 0U);
+    memset(&s_irq, 0, sizeof(s_irq));
+    ops->delay(20);
+    assert(!da7281_sim_nirq(0, addr));
+    assert((s_irq.calls >= 1U) && (s_irq.events[s_irq.calls - 1U] == DA7281_EVENT_WARNING));
+    da7281_bus_host_clear_stats();
+    ops->delay(50);
+    da7281_bus_host_stats(&stats);
+    assert(stats.transactions == 0U);
+
+    assert(da7281_deinit(&device) == DA7281_OK);
+    da7281_sim_set_irq_handler(NULL);
+    printf("✅ PASS: Stuck nIRQ line re-served every back-off until its clear succeeds\n");
+}
+
+int main(void)
+{
+    printf("╔════════════════════════════════════════════╗\n");
+    printf("║  DA7281 HAL Host Backend Tests (Native)    ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    test_backend_selection();
+    test_api_traffic();
+    test_events();
+    test_register_semantics();
+    test_modes_and_irq();
+    test_latency_prediction();
+    test_stats();
+    test_snp_upload();
+    test_play_sequence();
+    test_playlist_gap();
+    test_irq_dispatch();
+    test_irq_shared_line();
+    test_verify_flush_nack();
+    test_irq_stuck_line();
+
+    printf("\n╔════════════════════════════════════════════╗\n");
+    printf("║  ✅ ALL HOST BACKEND TESTS PASSED          ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    return 0;
+}
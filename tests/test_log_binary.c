@@ -0,0 +1,236 @@
+/**
+ * @file test_log_binary.c
+ * @brief Binary deferred logging (DA7281_LOG_BACKEND = 4) on the host backend
+ *
+ * Built with a 256-byte ring, 8 records per level and window, and
+ * DA7281_LOG_LEVEL = INFO. Timestamps come from the host bus backend's
+ * virtual clock. The driver's records from da7281_init() are written to
+ * log_binary.bin, which the Makefile decodes with scripts/da7281_log.py.
+ *
+ * Usage:
+ *   test_log_binary [dump.bin]
+ */
+
+/* Log sites in this file, for the decoder's string table */
+#define DA7281_LOG_FILE_ID (14U)
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include "da7281.h"
+#include "da7281_bus.h"
+#include "da7281_sim.h"
+
+#if (DA7281_LOG_BACKEND != 4) || (DA7281_LOG_BUFFER_SIZE != 256U) || (DA7281_LOG_RATE_LIMIT != 8U)
+#error "Build with -DDA7281_LOG_BACKEND=4 -DDA7281_LOG_BUFFER_SIZE=256 -DDA7281_LOG_RATE_LIMIT=8"
+#endif
+
+static uint8_t s_out[512];
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** Start each case with an empty ring, fresh counters and a new rate window */
+static void log_fresh(void)
+{
+    da7281_bus_host_reset();
+    da7281_bus_get_ops()->delay(DA7281_LOG_RATE_WINDOW_MS);
+    da7281_log_reset();
+}
+
+/* Test 1: one record, byte for byte */
+static void test_record_layout(void)
+{
+    printf("\n=== Test 1: Record layout ===\n");
+    log_fresh();
+    uint32_t now = da7281_bus_get_ops()->now();
+
+    DA7281_LOG_ERROR("word=0x%08lX name=%s gain=%.2f delta=%d", 0x12345678UL, "bus0", 1.5F, -3);
+    uint16_t line = (uint16_t)(__LINE__ - 1);
+
+    uint32_t n = da7281_log_read(s_out, sizeof(s_out));
+    assert(n == (7U + 4U + 5U + 4U + 4U));
+    assert(s_out[0] == n);
+    assert(get16(&s_out[1]) == ((14U << 12) | line));
+    assert(get32(&s_out[3]) == now);
+    assert(get32(&s_out[7]) == 0x12345678UL);
+    assert((s_out[11] == 4U) && (memcmp(&s_out[12], "bus0", 4) == 0));
+    float gain;
+    memcpy(&gain, &s_out[16], sizeof(gain));
+    assert(gain == 1.5F);
+    assert((int32_t)get32(&s_out[20]) == -3);
+
+    /* Strings are cut at DA7281_LOG_MAX_STR_LEN; calls without arguments are header only */
+    DA7281_LOG_WARNING("%s", "a string that is much too long");
+    DA7281_LOG_WARNING("no arguments");
+    n = da7281_log_read(s_out, sizeof(s_out));
+    assert(n == ((7U + 1U + DA7281_LOG_MAX_STR_LEN) + 7U));
+    assert(s_out[7] == DA7281_LOG_MAX_STR_LEN);
+    assert(s_out[s_out[0]] == 7U);
+    assert(da7281_log_read(s_out, sizeof(s_out)) == 0U);
+
+    printf("✅ PASS: [len][site][timestamp][args] as documented in da7281_log.h\n");
+}
+
+/* Test 2: calls above DA7281_LOG_LEVEL leave no code behind */
+static void test_level_filter(void)
+{
+    printf("\n=== Test 2: Compile-time level filter ===\n");
+    log_fresh();
+    da7281_log_stats_t stats;
+
+    DA7281_LOG_DEBUG("compiled out %u", 1U);
+    DA7281_LOG_INFO("kept %u", 2U);
+    da7281_log_get_stats(&stats);
+    assert(stats.records == 1U);
+    assert(da7281_log_read(s_out, sizeof(s_out)) == 11U);
+
+    printf("✅ PASS: DEBUG removed at DA7281_LOG_LEVEL = INFO\n");
+}
+
+/* Test 3: a burst is cut at the rate limit and the loss is reported */
+static void test_rate_limit(void)
+{
+    printf("\n=== Test 3: Rate limit ===\n");
+    log_fresh();
+    da7281_log_stats_t stats;
+
+    for (uint32_t i = 0; i < 20U; i++) {
+        DA7281_LOG_WARNING("NACK storm %lu", i);
+    }
+    DA7281_LOG_ERROR("other levels have their own budget");
+
+    da7281_log_get_stats(&stats);
+    assert(stats.records == 9U);
+    assert(stats.dropped_rate == 12U);
+    assert(stats.dropped_full == 0U);
+
+    uint32_t n = da7281_log_read(s_out, sizeof(s_out));
+    assert(get16(&s_out[1]) == DA7281_LOG_SITE_DROPPED);
+    assert(get32(&s_out[7]) == 12U);
+    assert(n == (11U + (8U * 11U) + 7U));
+    assert(get32(&s_out[11U + (7U * 11U) + 7U]) == 7U);
+
+    /* Next window */
+    da7281_bus_get_ops()->delay(DA7281_LOG_RATE_WINDOW_MS);
+    DA7281_LOG_WARNING("NACK storm %lu", 20UL);
+    assert(da7281_log_read(s_out, sizeof(s_out)) == 11U);
+
+    printf("✅ PASS: 8 of 20 kept, 12 reported in a DROPPED record\n");
+}
+
+/* Test 4: a full ring drops new records; reads free space and the ring wraps */
+static void test_ring_full_and_wrap(void)
+{
+    printf("\n=== Test 4: Ring full and wrap-around ===\n");
+    log_fresh();
+    da7281_log_stats_t stats;
+    uint32_t seq = 0U;
+
+    /* 11-byte records: 23 fit in 256 bytes */
+    for (uint32_t i = 0; i < 25U; i++) {
+        if ((i % DA7281_LOG_RATE_LIMIT) == 0U) {
+            da7281_bus_get_ops()->delay(DA7281_LOG_RATE_WINDOW_MS);
+        }
+        DA7281_LOG_ERROR("seq %lu", i);
+    }
+    da7281_log_get_stats(&stats);
+    assert(stats.records == 23U);
+    assert(stats.dropped_full == 2U);
+
+    /* Drain part of it: whole records only, after the DROPPED notice */
+    uint32_t n = da7281_log_read(s_out, 40U);
+    assert(n == (11U + (2U * 11U)));
+    assert(get32(&s_out[7]) == 2U);
+    assert((get32(&s_out[11U + 7U]) == 0U) && (get32(&s_out[22U + 7U]) == 1U));
+    seq = 2U;
+
+    /* Refill across the end of the buffer, draining as we go */
+    for (uint32_t round = 0; round < 10U; round++) {
+        da7281_bus_get_ops()->delay(DA7281_LOG_RATE_WINDOW_MS);
+        for (uint32_t i = 0; i < 2U; i++) {
+            DA7281_LOG_ERROR("seq %lu", 25U + (round * 2U) + i);
+        }
+        n = da7281_log_read(s_out, sizeof(s_out));
+        for (uint32_t off = 0; off < n; off += s_out[off]) {
+            uint32_t value = get32(&s_out[off + 7U]);
+            assert(value == seq);
+            seq = (seq == 22U) ? 25U : (seq + 1U);
+        }
+    }
+    assert(seq == 45U);
+
+    da7281_log_get_stats(&stats);
+    assert(stats.records == 43U);
+    assert(stats.dropped_full == 2U);
+
+    printf("✅ PASS: 2 dropped when full; 43 records in order across the wrap\n");
+}
+
+/* Test 5: the driver's own calls become records the host tool can decode */
+static void test_driver_records(const char *dump_path)
+{
+    printf("\n=== Test 5: Driver log records ===\n");
+    log_fresh();
+
+    da7281_device_t device = {
+        .twi_instance = 0,
+        .i2c_address = DA7281_I2C_ADDR_0x4A
+    };
+    assert(da7281_i2c_configure_pins(0, 4, 5) == DA7281_OK);
+    assert(da7281_bus_init(0) == DA7281_OK);
+    assert(da7281_init(&device) == DA7281_OK);
+    assert(da7281_set_operation_mode(&device, DA7281_MODE_STANDBY) == DA7281_OK);
+
+    uint32_t n = da7281_log_read(s_out, sizeof(s_out));
+    unsigned core = 0U;
+    uint32_t last_ts = 0U;
+    for (uint32_t off = 0; off < n; off += s_out[off]) {
+        assert(s_out[off] >= 7U);
+        if ((get16(&s_out[off + 1U]) >> 12) == 1U) {
+            core++;
+        }
+        assert(get32(&s_out[off + 3U]) >= last_ts);
+        last_ts = get32(&s_out[off + 3U]);
+    }
+    assert(core >= 5U);
+
+    if (dump_path != NULL) {
+        FILE *f = fopen(dump_path, "wb");
+        assert(f != NULL);
+        assert(fwrite(s_out, 1, n, f) == n);
+        assert(fclose(f) == 0);
+        printf("  %u bytes written to %s\n", (unsigned)n, dump_path);
+    }
+
+    printf("✅ PASS: %u records from da7281.c, timestamps in order\n", core);
+}
+
+int main(int argc, char *argv[])
+{
+    printf("╔════════════════════════════════════════════╗\n");
+    printf("║  DA7281 HAL Binary Logging Tests           ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    test_record_layout();
+    test_level_filter();
+    test_rate_limit();
+    test_ring_full_and_wrap();
+    test_driver_records((argc > 1) ? argv[1] : NULL);
+
+    printf("\n╔════════════════════════════════════════════╗\n");
+    printf("║  ✅ ALL BINARY LOGGING TESTS PASSED        ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    return 0;
+}
@@ -0,0 +1,313 @@
+/**
+ * @file test_lra_math.c
+ * @brief Exhaustive check of the fixed-point LRA register math
+ *
+ * Sweeps every valid input of the integer conversions in src/da7281.c
+ * (1 Hz, 1 mA, 1 mohm and 1 mV steps) and compares them with:
+ *
+ * - the datasheet formulas evaluated in double precision: must match
+ *   exactly. Where the exact value sits on a rounding boundary (a .5 tie,
+ *   or an integer for the truncated voltage codes) double error could tip
+ *   either way, so there the result must be the boundary rounded up;
+ * - the single-precision float code the driver used before: may differ by
+ *   at most 1 LSB, only at values within float error of a boundary.
+ *
+ * Ends with a host timing of both versions (see
+ * examples/lra_math_benchmark.c for target cycle counts).
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "da7281.h"
+
+/** Distance from a rounding boundary within which double is not trusted */
+#define TIE_EPS     (1e-9)
+
+typedef struct {
+    const char *name;
+    uint32_t inputs;
+    uint32_t ties;              /**< Exact value on a boundary (within TIE_EPS) */
+    uint32_t float_diffs;       /**< Differs from the old float code */
+    int32_t float_max_diff;
+} sweep_t;
+
+/* ========================================================================
+ * References
+ * ======================================================================== */
+
+/**
+ * @brief Compare a result with a double reference
+ *
+ * @param exact Reference value before rounding
+ * @param truncate true to round down, false to round to nearest
+ */
+static void check_exact(sweep_t *sweep, uint32_t result, double exact, bool truncate)
+{
+    double boundary_dist = truncate ? (exact - floor(exact)) : fabs((exact - floor(exact)) - 0.5);
+    double expected = truncate ? floor(exact) : floor(exact + 0.5);
+
+    if (truncate && ((1.0 - boundary_dist) < TIE_EPS)) {
+        boundary_dist = 0.0;
+    }
+    if (boundary_dist < TIE_EPS) {
+        sweep->ties++;
+        assert((double)result == (truncate ? round(exact) : ceil(exact)));
+        return;
+    }
+    if ((double)result != expected) {
+        printf("  %s: got %u, expected %.0f (exact %.9f)\n", sweep->name, (unsigned)result, expected, exact);
+    }
+    assert((double)result == expected);
+}
+
+static void check_float(sweep_t *sweep, uint32_t result, uint32_t legacy)
+{
+    int32_t diff = (int32_t)result - (int32_t)legacy;
+    if (diff != 0) {
+        sweep->float_diffs++;
+        if (abs(diff) > sweep->float_max_diff) {
+            sweep->float_max_diff = abs(diff);
+        }
+    }
+}
+
+static void sweep_report(const sweep_t *sweep)
+{
+    printf("  %-18s %9u inputs, exact, %u boundary ties; vs float: %u differ (max %d LSB)\n",
+           sweep->name, (unsigned)sweep->inputs, (unsigned)sweep->ties,
+           (unsigned)sweep->float_diffs, (int)sweep->float_max_diff);
+    assert(sweep->float_max_diff <= 1);
+}
+
+/* The driver's former single-precision code */
+static uint16_t legacy_lra_per(uint16_t freq_hz)
+{
+    float period_seconds = 1.0F / (float)freq_hz;
+    return (uint16_t)roundf(period_seconds / DA7281_LRA_PER_TIME_SCALE);
+}
+
+static float legacy_imax_float(uint16_t current_ma)
+{
+    return ((float)current_ma - DA7281_ACTUATOR_IMAX_OFFSET) / DA7281_ACTUATOR_IMAX_SCALE;
+}
+
+static uint8_t legacy_imax(uint16_t current_ma)
+{
+    float imax_float = legacy_imax_float(current_ma);
+    return (imax_float < 0) ? 0U : (uint8_t)roundf(imax_float);
+}
+
+static uint16_t legacy_v2i(float impedance_ohm, uint16_t current_ma)
+{
+    float v2i_float = (impedance_ohm * (legacy_imax_float(current_ma) + DA7281_V2I_FACTOR_IMAX_OFFSET)) /
+                      DA7281_V2I_FACTOR_DIVISOR;
+    return (uint16_t)roundf(v2i_float);
+}
+
+static uint32_t legacy_vmax(float voltage)
+{
+    return (uint32_t)((voltage * 1000.0F) / DA7281_ACTUATOR_NOMMAX_SCALE);
+}
+
+/* ========================================================================
+ * Tests
+ * ======================================================================== */
+
+/* Test 1: LRA_PER for 50..300 Hz */
+static void test_lra_per(void)
+{
+    printf("\n=== Test 1: LRA_PER ===\n");
+    sweep_t sweep = {.name = "LRA_PER"};
+
+    for (uint16_t f = 50U; f <= 300U; f++) {
+        uint16_t lra_per = da7281_lra_per_from_hz(f);
+        check_exact(&sweep, lra_per, (1.0 / f) / 1.33332e-6, false);
+        check_float(&sweep, lra_per, legacy_lra_per(f));
+        sweep.inputs++;
+    }
+    sweep_report(&sweep);
+
+    assert(da7281_lra_per_from_hz(170U) == 4412U);
+    assert(da7281_lra_per_from_hz(0U) == UINT16_MAX);
+    assert(da7281_lra_per_from_hz(1U) == UINT16_MAX);
+
+    printf("✅ PASS: LRA_PER exact over 50-300 Hz\n");
+}
+
+/* Test 2: IMAX for 50..500 mA */
+static void test_imax(void)
+{
+    printf("\n=== Test 2: ACTUATOR_IMAX ===\n");
+    sweep_t sweep = {.name = "ACTUATOR_IMAX"};
+
+    for (uint16_t ma = 50U; ma <= 500U; ma++) {
+        uint8_t imax = da7281_imax_from_ma(ma);
+        check_exact(&sweep, imax, (ma - 28.6) / 7.2, false);
+        check_float(&sweep, imax, legacy_imax(ma));
+        sweep.inputs++;
+    }
+    sweep_report(&sweep);
+
+    assert(da7281_imax_from_ma(350U) == 45U);
+    assert(da7281_imax_from_ma(0U) == 0U);
+    assert(da7281_imax_from_ma(25U) == 0U);
+    assert(da7281_imax_from_ma(UINT16_MAX) == UINT8_MAX);
+
+    printf("✅ PASS: IMAX exact over 50-500 mA\n");
+}
+
+/* Test 3: V2I_FACTOR for 1..50 ohm (1 mohm steps) x 50..500 mA */
+static void test_v2i(void)
+{
+    printf("\n=== Test 3: V2I_FACTOR ===\n");
+    sweep_t sweep = {.name = "V2I_FACTOR"};
+
+    for (uint32_t mohm = 1000U; mohm <= 50000U; mohm++) {
+        float z = (float)mohm / 1000.0F;
+        for (uint16_t ma = 50U; ma <= 500U; ma++) {
+            uint16_t v2i = da7281_v2i_from_mohm(mohm, ma);
+            double exact = (mohm / 1000.0) * (((ma - 28.6) / 7.2) + 4.0) / 1.6104;
+            check_exact(&sweep, v2i, exact, false);
+            check_float(&sweep, v2i, legacy_v2i(z, ma));
+            sweep.inputs++;
+        }
+    }
+    sweep_report(&sweep);
+
+    /* Largest input still fits the 32-bit intermediate */
+    assert(da7281_v2i_from_mohm(50000U, 500U) == 2157U);
+
+    printf("✅ PASS: V2I_FACTOR exact over 1-50 ohm x 50-500 mA\n");
+}
+
+/* Test 4: NOMMAX/ABSMAX for 0.5..12 V (1 mV steps) */
+static void test_vmax(void)
+{
+    printf("\n=== Test 4: ACTUATOR_NOMMAX / ABSMAX ===\n");
+    sweep_t sweep = {.name = "NOMMAX/ABSMAX"};
+
+    for (uint16_t mv = 500U; mv <= 12000U; mv++) {
+        uint8_t code = da7281_vmax_from_mv(mv);
+        double exact = mv / 23.4;
+        if (exact >= 256.0) {
+            /* The float code converted these to uint8_t out of range */
+            assert(code == UINT8_MAX);
+            continue;
+        }
+        check_exact(&sweep, code, exact, true);
+        check_float(&sweep, code, legacy_vmax((float)mv / 1000.0F));
+        sweep.inputs++;
+    }
+    sweep_report(&sweep);
+
+    assert(da7281_vmax_from_mv(2500U) == 106U);
+    assert(da7281_vmax_from_mv(3500U) == 149U);
+    assert(da7281_vmax_from_mv(2340U) == 100U);
+    assert(da7281_vmax_from_mv(12000U) == UINT8_MAX);
+
+    printf("✅ PASS: Voltage codes exact below 5.967 V, saturated above\n");
+}
+
+/* Test 5: da7281_lra_compute() on the default actuator and on range errors */
+static void test_compute(void)
+{
+    printf("\n=== Test 5: da7281_lra_compute() ===\n");
+    const da7281_lra_config_t config = {
+        .resonant_freq_hz = 170,
+        .impedance_ohm = 6.75F,
+        .nom_max_v_rms = 2.5F,
+        .abs_max_v_peak = 3.5F,
+        .max_current_ma = 350
+    };
+    da7281_lra_regs_t regs;
+
+    assert(da7281_lra_compute(&config, &regs) == DA7281_OK);
+    assert(regs.lra_per == legacy_lra_per(config.resonant_freq_hz));
+    assert(regs.imax == legacy_imax(config.max_current_ma));
+    assert(regs.v2i_factor == legacy_v2i(config.impedance_ohm, config.max_current_ma));
+    assert(regs.nommax == legacy_vmax(config.nom_max_v_rms));
+    assert(regs.absmax == legacy_vmax(config.abs_max_v_peak));
+    printf("  LRA_PER=%u NOMMAX=%u ABSMAX=%u IMAX=%u V2I=%u\n", regs.lra_per, regs.nommax,
+           regs.absmax, regs.imax, regs.v2i_factor);
+
+    da7281_lra_config_t bad = config;
+    bad.resonant_freq_hz = 301;
+    assert(da7281_lra_compute(&bad, &regs) == DA7281_ERROR_INVALID_PARAM);
+    bad = config;
+    bad.impedance_ohm = 0.5F;
+    assert(da7281_lra_compute(&bad, &regs) == DA7281_ERROR_INVALID_PARAM);
+    assert(da7281_lra_compute(NULL, &regs) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_lra_compute(&config, NULL) == DA7281_ERROR_NULL_POINTER);
+
+    printf("✅ PASS: Default actuator matches the float code; ranges checked\n");
+}
+
+/* Test 6: host timing, integer vs float */
+static double elapsed_ns(const struct timespec *t0, const struct timespec *t1)
+{
+    return ((double)(t1->tv_sec - t0->tv_sec) * 1e9) + (double)(t1->tv_nsec - t0->tv_nsec);
+}
+
+static void test_timing(void)
+{
+    printf("\n=== Test 6: Host timing (informational) ===\n");
+    volatile uint32_t sink = 0;
+    struct timespec t0, t1;
+    uint32_t calls = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t rep = 0; rep < 200U; rep++) {
+        for (uint16_t ma = 50U; ma <= 500U; ma += 3U) {
+            uint16_t f = (uint16_t)(50U + (ma % 251U));
+            uint32_t mohm = 1000U + ((uint32_t)ma * 97U);
+            sink += da7281_lra_per_from_hz(f) + da7281_imax_from_ma(ma) +
+                    da7281_v2i_from_mohm(mohm, ma) + da7281_vmax_from_mv((uint16_t)(ma * 10U)) +
+                    da7281_vmax_from_mv((uint16_t)(ma * 20U));
+            calls++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double fixed_ns = elapsed_ns(&t0, &t1) / calls;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t rep = 0; rep < 200U; rep++) {
+        for (uint16_t ma = 50U; ma <= 500U; ma += 3U) {
+            uint16_t f = (uint16_t)(50U + (ma % 251U));
+            float z = (1000.0F + ((float)ma * 97.0F)) / 1000.0F;
+            sink += legacy_lra_per(f) + legacy_imax(ma) + legacy_v2i(z, ma) +
+                    legacy_vmax((float)ma / 100.0F) + legacy_vmax((float)ma / 50.0F);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double float_ns = elapsed_ns(&t0, &t1) / calls;
+    (void)sink;
+
+    printf("  five conversions: fixed %.1f ns, float %.1f ns per set\n", fixed_ns, float_ns);
+    printf("✅ PASS: Timing recorded\n");
+}
+
+int main(void)
+{
+    printf("╔════════════════════════════════════════════╗\n");
+    printf("║  DA7281 HAL Fixed-Point LRA Math Tests     ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    test_lra_per();
+    test_imax();
+    test_v2i();
+    test_vmax();
+    test_compute();
+    test_timing();
+
+    printf("\n╔════════════════════════════════════════════╗\n");
+    printf("║  ✅ ALL LRA MATH TESTS PASSED              ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    return 0;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file test_profiles.c
+ * @brief Generated actuator register images and da7281_apply_register_image()
+ *
+ * da7281_profiles.h is generated by scripts/da7281_profiles.py from
+ * config/actuator_profiles.csv. Every image must hold exactly the bytes
+ * da7281_lra_compute() produces for the same CSV row, and applying it on
+ * the host bus backend must cost one frame per run of consecutive
+ * registers.
+ *
+ * Usage:
+ *   test_profiles <actuator_profiles.csv>
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include "da7281.h"
+#include "da7281_bus.h"
+#include "da7281_sim.h"
+#include "da7281_profiles.h"
+
+static da7281_device_t s_device = {
+    .twi_instance = 0,
+    .i2c_address = DA7281_I2C_ADDR_0x4A
+};
+
+/* Test 1: images equal da7281_lra_compute() for every table row */
+static void test_images_match_driver(const char *csv_path)
+{
+    printf("\n=== Test 1: Generated images vs da7281_lra_compute() ===\n");
+
+    FILE *f = fopen(csv_path, "r");
+    assert(f != NULL);
+
+    char line[256];
+    unsigned rows = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char name[64];
+        unsigned freq, current;
+        da7281_lra_config_t config;
+        if ((line[0] == '#') ||
+            (sscanf(line, "%63[^,],%u,%f,%f,%f,%u", name, &freq, &config.impedance_ohm,
+                    &config.nom_max_v_rms, &config.abs_max_v_peak, &current) != 6)) {
+            continue;
+        }
+        config.resonant_freq_hz = (uint16_t)freq;
+        config.max_current_ma = (uint16_t)current;
+
+        da7281_lra_regs_t regs;
+        assert(da7281_lra_compute(&config, &regs) == DA7281_OK);
+        const uint8_t expected[7] = {
+            (uint8_t)(regs.lra_per >> 8), (uint8_t)(regs.lra_per & 0xFF), regs.nommax,
+            regs.absmax, regs.imax, (uint8_t)(regs.v2i_factor >> 8), (uint8_t)(regs.v2i_factor & 0xFF)
+        };
+
+        assert(rows < DA7281_PROFILE_COUNT);
+        const da7281_register_image_t *image = da7281_profiles[rows];
+        assert(strcmp(image->name, name) == 0);
+        assert(image->count == sizeof(expected));
+        for (uint8_t i = 0; i < image->count; i++) {
+            assert(image->regs[i].reg == (uint8_t)(DA7281_REG_LRA_PER_H + i));
+            assert(image->regs[i].value == expected[i]);
+        }
+        rows++;
+    }
+    (void)fclose(f);
+
+    assert(rows == DA7281_PROFILE_COUNT);
+    printf("✅ PASS: %u profiles bit-identical to the driver's math\n", rows);
+}
+
+/* Test 2: an LRA image is one burst and lands in the device and the cache */
+static void test_apply_profile(void)
+{
+    printf("\n=== Test 2: Apply a profile ===\n");
+    static da7281_reg_cache_t cache;
+    da7281_bus_host_stats_t stats;
+
+    memset(&cache, 0, sizeof(cache));
+    s_device.cache = &cache;
+    assert(da7281_cache_invalidate(&s_device) == DA7281_OK);
+
+    for (uint8_t p = 0; p < DA7281_PROFILE_COUNT; p++) {
+        const da7281_register_image_t *image = da7281_profiles[p];
+
+        da7281_bus_host_clear_stats();
+        assert(da7281_apply_register_image(&s_device, image) == DA7281_OK);
+        da7281_bus_host_stats(&stats);
+        assert((stats.transactions == 1U) && (stats.bytes == 8U) && (stats.lock_takes == 1U));
+
+        for (uint8_t i = 0; i < image->count; i++) {
+            uint8_t value = 0;
+            assert(da7281_sim_peek(0, s_device.i2c_address, image->regs[i].reg) == image->regs[i].value);
+            da7281_bus_host_clear_stats();
+            assert(da7281_read_register_cached(&s_device, image->regs[i].reg, &value) == DA7281_OK);
+            da7281_bus_host_stats(&stats);
+            assert((value == image->regs[i].value) && (stats.transactions == 0U));
+        }
+    }
+    s_device.cache = NULL;
+
+    printf("✅ PASS: 1 frame, 8 bytes per profile; cache updated\n");
+}
+
+/* Test 3: one frame per run of consecutive addresses, one lock for all */
+static void test_apply_runs(void)
+{
+    printf("\n=== Test 3: Runs and bursts ===\n");
+    da7281_bus_host_stats_t stats;
+
+    static const da7281_reg_value_t runs[] = {
+        {DA7281_REG_LRA_PER_H, 0x10}, {DA7281_REG_LRA_PER_L, 0x20},
+        {DA7281_REG_ACTUATOR_IMAX, 0x05},
+        {DA7281_REG_TOP_CTL2, 0x40}
+    };
+    const da7281_register_image_t image = {"runs", runs, 4U};
+
+    da7281_bus_host_clear_stats();
+    assert(da7281_apply_register_image(&s_device, &image) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    printf("  3 runs: frames=%u bytes=%u locks=%u\n", stats.transactions, stats.bytes, stats.lock_takes);
+    assert((stats.transactions == 3U) && (stats.bytes == 7U) && (stats.lock_takes == 1U));
+    assert(da7281_sim_peek(0, s_device.i2c_address, DA7281_REG_TOP_CTL2) == 0x40U);
+
+    /* The whole SNP window is one burst of DA7281_I2C_MAX_BURST_LEN */
+    static da7281_reg_value_t snp[DA7281_REG_SNP_MEM_END - DA7281_REG_SNP_MEM_BASE + 1U];
+    for (uint8_t i = 0; i < sizeof(snp) / sizeof(snp[0]); i++) {
+        snp[i].reg = (uint8_t)(DA7281_REG_SNP_MEM_BASE + i);
+        snp[i].value = i;
+    }
+    const da7281_register_image_t snp_image = {"snp", snp, (uint8_t)(sizeof(snp) / sizeof(snp[0]))};
+    da7281_bus_host_clear_stats();
+    assert(da7281_apply_register_image(&s_device, &snp_image) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    assert((stats.transactions == 1U) && (stats.bytes == (1U + snp_image.count)));
+
+    printf("✅ PASS: One burst per run under a single lock\n");
+}
+
+/* Test 4: bad images are rejected before anything is written */
+static void test_apply_invalid(void)
+{
+    printf("\n=== Test 4: Invalid images ===\n");
+    da7281_bus_host_stats_t stats;
+
+    static const da7281_reg_value_t unsorted[] = {{0x0B, 1}, {0x0A, 2}};
+    static const da7281_reg_value_t duplicate[] = {{0x0A, 1}, {0x0A, 2}};
+    static const da7281_reg_value_t read_only[] = {{0x0A, 1}, {DA7281_REG_IRQ_STATUS1, 2}};
+    const da7281_register_image_t bad[] = {
+        {"unsorted", unsorted, 2U},
+        {"duplicate", duplicate, 2U},
+        {"read_only", read_only, 2U},
+        {"empty", unsorted, 0U}
+    };
+
+    da7281_bus_host_clear_stats();
+    for (uint8_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        assert(da7281_apply_register_image(&s_device, &bad[i]) == DA7281_ERROR_INVALID_PARAM);
+    }
+    const da7281_register_image_t no_regs = {"null", NULL, 1U};
+    assert(da7281_apply_register_image(&s_device, &no_regs) == DA7281_ERROR_NULL_POINTER);
+    assert(da7281_apply_register_image(&s_device, NULL) == DA7281_ERROR_NULL_POINTER);
+    da7281_bus_host_stats(&stats);
+    assert(stats.transactions == 0U);
+
+    printf("✅ PASS: Unsorted, duplicate, read-only and empty images write nothing\n");
+}
+
+/* Test 5: switching profiles in diff mode writes only the differing bytes */
+static void test_switch_profiles_diff(void)
+{
+    printf("\n=== Test 5: Profile switching (diff) ===\n");
+    static da7281_reg_cache_t cache;
+    da7281_bus_host_stats_t stats;
+    uint32_t full_bytes = 0U;
+    uint32_t diff_bytes = 0U;
+    unsigned skipped_total = 0U;
+
+    memset(&cache, 0, sizeof(cache));
+    s_device.cache = &cache;
+    assert(da7281_cache_invalidate(&s_device) == DA7281_OK);
+
+    /* Visit every profile twice, as a UI stepping through screens would */
+    for (uint8_t step = 0; step < (2U * DA7281_PROFILE_COUNT); step++) {
+        const da7281_register_image_t *image = da7281_profiles[step % DA7281_PROFILE_COUNT];
+        uint8_t skipped = 0xFF;
+
+        da7281_bus_host_clear_stats();
+        assert(da7281_apply_register_image_diff(&s_device, image, &skipped) == DA7281_OK);
+        da7281_bus_host_stats(&stats);
+        assert(stats.transactions <= 1U);
+        assert((skipped == 0U) ? (stats.bytes == 8U) : (stats.bytes < 8U));
+        diff_bytes += stats.bytes;
+        full_bytes += 8U;
+        skipped_total += skipped;
+
+        for (uint8_t i = 0; i < image->count; i++) {
+            assert(da7281_sim_peek(0, s_device.i2c_address, image->regs[i].reg) == image->regs[i].value);
+        }
+
+        /* Re-applying the active profile is free */
+        da7281_bus_host_clear_stats();
+        assert(da7281_apply_register_image_diff(&s_device, image, &skipped) == DA7281_OK);
+        da7281_bus_host_stats(&stats);
+        assert((stats.transactions == 0U) && (skipped == image->count));
+    }
+    s_device.cache = NULL;
+
+    printf("  %u switches: %u bytes instead of %u, %u registers skipped\n",
+           2U * DA7281_PROFILE_COUNT, diff_bytes, full_bytes, skipped_total);
+    assert(diff_bytes <= full_bytes);
+
+    /* Same actuator at another strength: only ACTUATOR_NOMMAX differs */
+    s_device.cache = &cache;
+    const da7281_register_image_t *base = da7281_profiles[0];
+    da7281_reg_value_t soft_regs[7];
+    memcpy(soft_regs, base->regs, sizeof(soft_regs));
+    soft_regs[DA7281_REG_ACTUATOR_NOMMAX - DA7281_REG_LRA_PER_H].value /= 2U;
+    const da7281_register_image_t soft = {"soft", soft_regs, 7U};
+    uint8_t skipped = 0U;
+    assert(da7281_apply_register_image_diff(&s_device, base, NULL) == DA7281_OK);
+    da7281_bus_host_clear_stats();
+    assert(da7281_apply_register_image_diff(&s_device, &soft, &skipped) == DA7281_OK);
+    da7281_bus_host_stats(&stats);
+    printf("  strength change: frames=%u bytes=%u skipped=%u\n", stats.transactions, stats.bytes, skipped);
+    assert((stats.transactions == 1U) && (stats.bytes == 2U) && (skipped == 6U));
+    s_device.cache = NULL;
+
+    printf("✅ PASS: Only changed registers written; re-apply costs no traffic\n");
+}
+
+int main(int argc, char *argv[])
+{
+    printf("╔════════════════════════════════════════════╗\n");
+    printf("║  DA7281 HAL Actuator Profile Tests         ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    if (argc < 2) {
+        printf("usage: %s <actuator_profiles.csv>\n", argv[0]);
+        return 2;
+    }
+
+    da7281_bus_host_reset();
+    assert(da7281_i2c_configure_pins(0, 4, 5) == DA7281_OK);
+    assert(da7281_init(&s_device) == DA7281_OK);
+
+    test_images_match_driver(argv[1]);
+    test_apply_profile();
+    test_apply_runs();
+    test_apply_invalid();
+    test_switch_profiles_diff();
+
+    printf("\n╔════════════════════════════════════════════╗\n");
+    printf("║  ✅ ALL PROFILE TESTS PASSED               ║\n");
+    printf("╚════════════════════════════════════════════╝\n");
+
+    return 0;
+}